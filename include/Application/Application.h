@@ -5,12 +5,48 @@
 
 /* ================================================================ */
 
+/* The maximum number of resources systems can declare access to. Every resource is one bit of a `Uint64` mask */
+#define APP_MAX_RESOURCES 64
+
+/* The maximum length of system and resource names, including the `\0` character */
+#define APP_NAME_LENGTH 32
+
+/* ================================ */
+
+typedef struct app_scheduler App_Scheduler;
+
+/**
+ * The signature of a system: a function that runs once per frame when `App_run_systems` is called.
+ */
+typedef void (*App_System_Function)(App* app, void* data);
+
+/**
+ * The time a system took to run, in seconds.
+ */
+typedef struct app_system_timing {
+
+    /* During the last frame */
+    double last;
+    /* Exponential moving average over the previous frames */
+    double average;
+    /* The slowest frame so far */
+    double max;
+} App_System_Timing;
+
+/* ================================================================ */
+
 struct application {
 
     Window* window;
     Timer* timer;
     Input_Manager imanager;
 
+    /* Registered systems and the dependency graph between them. Created by the first `App_add_system` call */
+    App_Scheduler* scheduler;
+
+    /* Temporary memory for the current and the previous frame. A new frame starts with every tick of `timer` */
+    Frame_Arena* frame;
+
     int run;
 };
 
@@ -26,15 +62,83 @@ extern int Application_destroy(App** app);
 
 /* ================================================================ */
 
-extern void App_handle_input(void);
+/**
+ * The `App_resource` function returns the mask of a named resource (the physics world, the particle buffer, the renderer, ...).
+ * Systems use resource masks to declare what they read and write. The first call with a new name registers the resource.
+ *
+ * @param app A pointer to the application. This parameter must not be `NULL`.
+ * @param name A null-terminated string naming the resource, shorter than `APP_NAME_LENGTH`. This parameter must not be `NULL`.
+ *
+ * @return A mask with the single bit of the resource set. `0` on failure, if the name is too long or `APP_MAX_RESOURCES` resources are already registered.
+ */
+extern Uint64 App_resource(App* app, const char* name);
+
+/* ================================================================ */
+
+/**
+ * The `App_add_system` function registers a system that runs every time `App_run_systems` is called.
+ * A system runs after every previously added system it conflicts with: one of them writes a resource the other reads or writes.
+ * Systems that do not conflict run in parallel on the job system.
+ *
+ * @param app A pointer to the application. This parameter must not be `NULL`.
+ * @param name A null-terminated string naming the system, shorter than `APP_NAME_LENGTH`. Names must be unique.
+ * @param function The function to call. This parameter must not be `NULL`.
+ * @param data A pointer passed to the function unchanged.
+ * @param reads A mask of the resources the system reads, combined from `App_resource` results with `|`.
+ * @param writes A mask of the resources the system writes.
+ *
+ * @return `0` on success. `-1` on failure, if an argument is invalid, the name is too long or taken, or memory allocation fails.
+ */
+extern int App_add_system(App* app, const char* name, App_System_Function function, void* data, Uint64 reads, Uint64 writes);
+
+/* ================================================================ */
+
+/**
+ * The `App_remove_system` function unregisters a system. The dependency graph is rebuilt on the next frame.
+ *
+ * @param app A pointer to the application.
+ * @param name The name the system was added with.
+ *
+ * @return `0` on success. `-1` if there is no such system.
+ */
+extern int App_remove_system(App* app, const char* name);
+
+/* ================================================================ */
+
+/**
+ * The `App_clear_systems` function unregisters all systems and releases the scheduler. It is called by `Application_destroy`.
+ *
+ * @param app A pointer to the application.
+ *
+ * @return None.
+ */
+extern void App_clear_systems(App* app);
 
 /* ================================================================ */
 
-extern void App_handle_physics(void);
+/**
+ * The `App_run_systems` function runs every registered system once, respecting the dependencies between them.
+ * Independent systems run in parallel if the job system is running; otherwise all systems run on the calling thread in the order they were added.
+ * The function returns after every system has finished.
+ *
+ * @param app A pointer to the application.
+ *
+ * @return `0` on success. `-1` on failure, if `app` is `NULL` or the dependency graph cannot be built.
+ */
+extern int App_run_systems(App* app);
 
 /* ================================================================ */
 
-extern void App_handle_drawing(void);
+/**
+ * The `App_system_timing` function reports how long a system took to run.
+ *
+ * @param app A pointer to the application.
+ * @param name The name the system was added with.
+ * @param timing A pointer to a structure that receives the timings. This parameter must not be `NULL`.
+ *
+ * @return `0` on success. `-1` if there is no such system.
+ */
+extern int App_system_timing(const App* app, const char* name, App_System_Timing* timing);
 
 /* ================================================================ */
 
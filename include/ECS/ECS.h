@@ -0,0 +1,225 @@
+#ifndef SANCHO_PANZA_ECS_H
+#define SANCHO_PANZA_ECS_H
+
+#include "../../sancho-panza.h"
+
+/* ================================================================ */
+
+/* The maximum number of component types a world can register. Every component is one bit of an archetype mask */
+#define ECS_MAX_COMPONENTS 64
+
+/* The maximum number of rows a query chunk covers */
+#define ECS_CHUNK_ROWS 1024
+
+/* Builds a component mask out of a component identifier */
+#define ECS_MASK(component) ((Uint64) 1 << (component))
+
+/* ================================================================ */
+
+/**
+ * An entity identifier: the index of the entity in the lower 32 bits and its generation in the upper 32 bits.
+ * Destroying an entity bumps the generation of its index, so stale identifiers are detected instead of aliasing a new entity.
+ */
+typedef Uint64 Entity;
+
+/* The identifier no entity ever has */
+#define ENTITY_NONE ((Entity) 0)
+
+/* An identifier returned by `ECS_component_register` */
+typedef int ECS_Component;
+
+typedef struct ecs_world ECS_World;
+typedef struct ecs_archetype ECS_Archetype;
+
+/* ================================ */
+
+/**
+ * A run of rows of one archetype table. Every component of the archetype is stored in its own contiguous array,
+ * so `ECS_chunk_column` returns a pointer to `count` consecutive values of one component.
+ */
+typedef struct ecs_chunk {
+
+    ECS_Archetype* archetype;
+
+    /* The first row of the chunk and the number of rows in it */
+    size_t first;
+    size_t count;
+
+    /* The entities stored in the rows of the chunk */
+    const Entity* entities;
+} ECS_Chunk;
+
+/**
+ * The state of a query. It is created by `ECS_query` and advanced with `ECS_query_next`.
+ */
+typedef struct ecs_query {
+
+    ECS_World* world;
+
+    /* Components an archetype must have */
+    Uint64 with;
+    /* Components an archetype must not have */
+    Uint64 without;
+
+    /* The archetype and the row the next chunk starts at */
+    size_t archetype;
+    size_t row;
+} ECS_Query;
+
+/**
+ * The signature of a function called for every chunk by `ECS_query_parallel_for`.
+ */
+typedef void (*ECS_Chunk_Function)(const ECS_Chunk* chunk, void* data);
+
+/* ================================================================ */
+
+/**
+ * The `ECS_World_new` function creates an empty world: a set of entities, component types and archetype tables.
+ * After you are finished using the world, release it with `ECS_World_destroy`.
+ *
+ * @return A pointer to the new world. `NULL` if memory allocation fails.
+ */
+extern ECS_World* ECS_World_new(void);
+
+/* ================================================================ */
+
+/**
+ * The `ECS_World_destroy` function releases a world with all its entities and components, and sets the pointer to `NULL`.
+ *
+ * @param world A double pointer to the world.
+ *
+ * @return None.
+ */
+extern void ECS_World_destroy(ECS_World** world);
+
+/* ================================================================ */
+
+/**
+ * The `ECS_component_register` function registers a component type: plain data of the given size and alignment.
+ *
+ * @param world A pointer to the world.
+ * @param size The size of the component, usually `sizeof(Type)`. Must be greater than `0`.
+ * @param alignment The alignment of the component, usually `_Alignof(Type)`. Must be a power of two.
+ *
+ * @return The identifier of the component. `-1` on failure, if the arguments are invalid or `ECS_MAX_COMPONENTS` components are already registered.
+ */
+extern ECS_Component ECS_component_register(ECS_World* world, size_t size, size_t alignment);
+
+/* ================================================================ */
+
+/**
+ * The `Entity_create` function creates an entity without components.
+ *
+ * @param world A pointer to the world.
+ *
+ * @return The identifier of the entity. `ENTITY_NONE` if memory allocation fails.
+ */
+extern Entity Entity_create(ECS_World* world);
+
+/* ================================================================ */
+
+/**
+ * The `Entity_destroy` function destroys an entity and its components. The identifier becomes stale.
+ *
+ * @param world A pointer to the world.
+ * @param entity The identifier of the entity.
+ *
+ * @return `0` on success. `-1` if the entity is not alive.
+ */
+extern int Entity_destroy(ECS_World* world, Entity entity);
+
+/* ================================================================ */
+
+/**
+ * The `Entity_is_alive` function checks whether the identifier refers to an existing entity.
+ *
+ * @return `1` if the entity is alive, `0` otherwise.
+ */
+extern int Entity_is_alive(const ECS_World* world, Entity entity);
+
+/* ================================================================ */
+
+/**
+ * The `Entity_add` function adds a component to an entity, moving the entity to the archetype table that has the component.
+ * If the entity already has the component, its value is overwritten.
+ *
+ * @param world A pointer to the world.
+ * @param entity The identifier of the entity.
+ * @param component The identifier of the component.
+ * @param value A pointer to the initial value of the component. If `NULL`, the component is zeroed.
+ *
+ * @return A pointer to the component of the entity. `NULL` on failure. The pointer is valid until the next structural change of the world.
+ */
+extern void* Entity_add(ECS_World* world, Entity entity, ECS_Component component, const void* value);
+
+/* ================================================================ */
+
+/**
+ * The `Entity_remove` function removes a component from an entity, moving the entity to the archetype table without it.
+ *
+ * @return `0` on success. `-1` if the entity is not alive or does not have the component.
+ */
+extern int Entity_remove(ECS_World* world, Entity entity, ECS_Component component);
+
+/* ================================================================ */
+
+/**
+ * The `Entity_get` function returns a pointer to a component of an entity.
+ *
+ * @return A pointer to the component. `NULL` if the entity is not alive or does not have the component.
+ * The pointer is valid until the next structural change of the world (creating, destroying entities or adding, removing components).
+ */
+extern void* Entity_get(const ECS_World* world, Entity entity, ECS_Component component);
+
+/* ================================================================ */
+
+/**
+ * The `ECS_query` function starts a query over all entities that have every component of `with` and none of `without`.
+ * Structural changes of the world are not allowed while the query is in use.
+ *
+ * @param world A pointer to the world.
+ * @param with A mask of required components, built with `ECS_MASK`.
+ * @param without A mask of excluded components.
+ *
+ * @return The initial state of the query.
+ */
+extern ECS_Query ECS_query(ECS_World* world, Uint64 with, Uint64 without);
+
+/* ================================================================ */
+
+/**
+ * The `ECS_query_next` function returns the next chunk of matching rows. Chunks never span two archetypes and have at most `ECS_CHUNK_ROWS` rows.
+ *
+ * @param query A pointer to the state of the query.
+ * @param chunk A pointer to a chunk that receives the next run of rows.
+ *
+ * @return `1` if a chunk has been returned, `0` when the query is exhausted.
+ */
+extern int ECS_query_next(ECS_Query* query, ECS_Chunk* chunk);
+
+/* ================================================================ */
+
+/**
+ * The `ECS_chunk_column` function returns the values of one component in a chunk.
+ *
+ * @param chunk A pointer to a chunk returned by a query.
+ * @param component The identifier of the component.
+ *
+ * @return A pointer to `chunk->count` consecutive values. `NULL` if the archetype of the chunk does not have the component.
+ */
+extern void* ECS_chunk_column(const ECS_Chunk* chunk, ECS_Component component);
+
+/* ================================================================ */
+
+/**
+ * The `ECS_query_parallel_for` function calls `function` for every chunk of the query, spreading the chunks across the worker threads of the job system.
+ * Chunks are disjoint, so the function may write the components of its chunk without synchronization.
+ * The function returns after every chunk has been processed.
+ *
+ * @return `0` on success. `-1` on failure, if an argument is invalid or memory allocation fails.
+ */
+extern int ECS_query_parallel_for(ECS_World* world, Uint64 with, Uint64 without, ECS_Chunk_Function function, void* data);
+
+/* ================================================================ */
+
+#endif /* SANCHO_PANZA_ECS_H */
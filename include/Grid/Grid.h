@@ -5,34 +5,67 @@
 
 /**
  * The macro simplifies the process of writing a serialized grid represented as a `cJSON` object to a specified file.
- * It utilizes the `write_to_file` function to handle the file writing operation
- * and the `cJSON_Print` function to convert the cJSON object into a string format suitable for storage.
+ * It utilizes the `JSON_write_to_file` function, which prints the cJSON object straight into the file through a fixed-size buffer,
+ * so large grids are saved without building the whole document in memory first.
+ * The file name is temporary data taken from the frame arena of the application, if there is one.
  * 
  * @param filename A string representing the path to the file where the JSON data should be written. This parameter must be a valid file path.
  * @param serialized_grid A pointer to a `cJSON` object that contains the serialized representation of the grid.
  * This object should be created using the `Grid_serialize` function.
  * 
- * @return The macro does not have a return value. It directly calls the `write_to_file` function, which returns 0 on success, or -1 on failure.
+ * @return The macro does not have a return value. It directly calls the `JSON_write_to_file` function, which returns 0 on success, or -1 on failure.
  */
 #define Grid_write2file_JSON(filename, serielized_grid) \
     do { \
-        char* final_filename = NULL; \
         size_t filename_length = strlen(filename); \
-        char* string = cJSON_Print((serielized_grid)); \
+        char* final_filename = Frame_temp_alloc(filename_length + 6); /* 5 for ".json" + 1 for terminator */ \
         \
-        if (filename_length < 5 || strcmp(filename + filename_length - 5, ".json") != 0) { \
+        if (final_filename != NULL) { \
             \
-            final_filename = malloc(filename_length + 6); /* 5 for ".json" + 1 for terminator */ \
-            sprintf(final_filename, "%s.json", filename); \
+            if (filename_length < 5 || strcmp(filename + filename_length - 5, ".json") != 0) { \
+                sprintf(final_filename, "%s.json", filename); \
+            } \
+            else { \
+                strcpy(final_filename, filename); \
+            } \
+            \
+            JSON_write_to_file((final_filename), (serielized_grid), 1); \
+        } \
+        \
+        Frame_temp_free(final_filename); \
+    } while (0)
+
+/**
+ * The macro works like `Grid_write2file_JSON`, but the grid is written by the background thread of the saver (see `Save_JSON_async`),
+ * so the calling thread does not wait for the file to be printed and written. The file is replaced atomically.
+ *
+ * @param filename A string representing the path to the file where the JSON data should be written.
+ * @param serialized_grid A pointer to a detached `cJSON` object created by `Grid_serialize`. The saver takes ownership of it.
+ * @param handle A pointer of type `Save_Handle**` that receives a handle to poll the save with, or `NULL`.
+ *
+ * @return The macro does not have a return value. It directly calls the `Save_JSON_async` function, which returns 0 on success, or -1 on failure.
+ */
+#define Grid_write2file_JSON_async(filename, serielized_grid, handle) \
+    do { \
+        size_t filename_length = strlen(filename); \
+        char* final_filename = Frame_temp_alloc(filename_length + 6); /* 5 for ".json" + 1 for terminator */ \
+        \
+        if (final_filename != NULL) { \
+            \
+            if (filename_length < 5 || strcmp(filename + filename_length - 5, ".json") != 0) { \
+                sprintf(final_filename, "%s.json", filename); \
+            } \
+            else { \
+                strcpy(final_filename, filename); \
+            } \
+            \
+            Save_JSON_async((final_filename), (serielized_grid), 1, (handle)); \
         } \
         else { \
-            final_filename = malloc(filename_length + 1); \
-            strcpy(final_filename, filename); \
-        }\
+            cJSON_Delete(serielized_grid); \
+        } \
         \
-        write_to_file((final_filename), string); \
-        free(final_filename); \
-        free(string); \
+        Frame_temp_free(final_filename); \
     } while (0)
 
 /* ================================================================ */
@@ -156,4 +189,36 @@ extern int Grid_deserialize(const cJSON* root, Grid* grid);
 
 /* ================================================================ */
 
+/**
+ * The `Grid_add_to_snapshot` function adds a grid to a binary snapshot (see `Snapshot_Writer_new`), the fast alternative to `Grid_serialize`.
+ * The grid is stored in a `SNAPSHOT_TAG_GRID` section and its cells, if any, in a `SNAPSHOT_TAG_CELLS` section with the same id.
+ * Both sections carry a checksum.
+ * 
+ * @param writer A pointer to the snapshot writer.
+ * @param grid A pointer to the grid to add. This parameter must not be `NULL`.
+ * @param id A number that tells the grids of a snapshot apart.
+ * @param cells A pointer to `rows * cols` values, one per cell in row-major order, or `NULL` if the grid has no cell data.
+ * 
+ * @return `0` on success. `-1` on failure, if an argument is `NULL`, the snapshot has a grid with this id already or memory allocation fails.
+ */
+extern int Grid_add_to_snapshot(Snapshot_Writer* writer, const Grid* grid, Uint32 id, const Uint32* cells);
+
+/* ================================================================ */
+
+/**
+ * The `Grid_from_snapshot` function reads a grid from an open snapshot. The cells are not copied:
+ * `cells` points into the mapped file and can be used until the snapshot is closed.
+ * 
+ * @param snapshot A pointer to the snapshot, opened with `Snapshot_open`.
+ * @param id The id the grid was added with.
+ * @param grid A pointer to a `Grid` structure that receives the grid. This parameter must not be `NULL`.
+ * @param cells A pointer that receives the `rows * cols` cell values, or `NULL` if they are not needed. It is set to `NULL` if the grid has no cell data.
+ * 
+ * @return `0` on success. `-1` if the snapshot has no such grid, the sections are damaged, or the cells are requested on a big-endian machine,
+ * where they cannot be used in place.
+ */
+extern int Grid_from_snapshot(const Snapshot* snapshot, Uint32 id, Grid* grid, const Uint32** cells);
+
+/* ================================================================ */
+
 #endif /* GRID_H */
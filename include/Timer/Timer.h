@@ -18,6 +18,9 @@ struct timer {
 
     /* The variable can be used to specify the amount of time to wait before executing a particular action */
     double time;
+
+    /* The number of times the timer has ticked. Every tick starts a new frame of the application's frame arena */
+    Uint64 frames;
 };
 
 typedef struct timer Timer;
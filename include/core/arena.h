@@ -0,0 +1,220 @@
+#ifndef SANCHO_PANZA_ARENA_H
+#define SANCHO_PANZA_ARENA_H
+
+#include "../../sancho-panza.h"
+
+/* ================================================================ */
+
+/* The default size of an arena block, in bytes */
+#define ARENA_BLOCK_SIZE (64 * 1024)
+
+/* The alignment of allocations that do not ask for a specific one */
+#define ARENA_DEFAULT_ALIGNMENT (sizeof(void*) * 2)
+
+/* ================================================================ */
+
+typedef struct arena_block Arena_Block;
+
+/**
+ * A linear (bump) allocator. Memory is carved out of large blocks and is never freed individually:
+ * it is released all at once by `Arena_reset`, or back to a mark by `Arena_rewind`.
+ */
+typedef struct arena {
+
+    Arena_Block* first;
+    Arena_Block* current;
+
+    /* The size of new blocks */
+    size_t block_size;
+} Arena;
+
+/**
+ * A position in an arena returned by `Arena_mark`. Rewinding to it releases everything allocated after the mark was taken.
+ */
+typedef struct arena_mark {
+
+    Arena_Block* block;
+    size_t offset;
+} Arena_Mark;
+
+/**
+ * Two arenas used in turns, one per frame. The memory allocated during a frame stays valid during the next one,
+ * and the arena of a frame is reset when the frame after the next one starts.
+ */
+typedef struct frame_arena {
+
+    Arena buffers[2];
+    int current;
+
+    /* The value of `timer->frames` the current buffer belongs to */
+    Uint64 frame;
+    const Timer* timer;
+
+    /* The only thread allowed to use the arena */
+    SDL_threadID owner;
+} Frame_Arena;
+
+/* ================================================================ */
+
+/**
+ * The `Arena_init` function prepares an empty arena. No memory is allocated until the first `Arena_alloc` call.
+ *
+ * @param arena A pointer to the arena to initialize.
+ * @param block_size The size of the blocks the arena allocates. If `0`, `ARENA_BLOCK_SIZE` is used.
+ *
+ * @return None.
+ */
+extern void Arena_init(Arena* arena, size_t block_size);
+
+/* ================================================================ */
+
+/**
+ * The `Arena_alloc` function allocates memory from an arena. Allocations larger than the block size get a block of their own.
+ *
+ * @param arena A pointer to the arena.
+ * @param size The number of bytes to allocate.
+ * @param alignment The alignment of the allocation. Must be a power of two; if `0`, `ARENA_DEFAULT_ALIGNMENT` is used.
+ *
+ * @return A pointer to uninitialized memory. `NULL` on failure, if the arguments are invalid or a new block cannot be allocated.
+ */
+extern void* Arena_alloc(Arena* arena, size_t size, size_t alignment);
+
+/* ================================================================ */
+
+/**
+ * The `Arena_mark` function remembers the current position of an arena, so temporary allocations can be undone with `Arena_rewind`.
+ * Marks nest: rewinding to an outer mark also releases everything allocated after inner marks.
+ */
+extern Arena_Mark Arena_mark(const Arena* arena);
+
+/* ================================================================ */
+
+/**
+ * The `Arena_rewind` function releases everything allocated after the mark was taken. The blocks are kept for reuse.
+ *
+ * @return None.
+ */
+extern void Arena_rewind(Arena* arena, Arena_Mark mark);
+
+/* ================================================================ */
+
+/**
+ * The `Arena_reset` function releases every allocation of an arena. If the arena had grown beyond one block,
+ * the blocks are merged into a single block as large as all of them, so an arena that is reset regularly stops allocating.
+ *
+ * @return None.
+ */
+extern void Arena_reset(Arena* arena);
+
+/* ================================================================ */
+
+/**
+ * The `Arena_release` function returns all blocks of an arena to the heap. The arena can be used again afterwards.
+ *
+ * @return None.
+ */
+extern void Arena_release(Arena* arena);
+
+/* ================================================================ */
+
+/**
+ * The `Arena_owns` function checks whether a pointer has been allocated from an arena.
+ *
+ * @return `1` if the pointer lies in one of the arena blocks, `0` otherwise.
+ */
+extern int Arena_owns(const Arena* arena, const void* pointer);
+
+/* ================================================================ */
+
+/**
+ * The `Frame_Arena_new` function creates a frame arena. `Application_new` creates one for every application.
+ *
+ * @param block_size The size of the blocks of both buffers. If `0`, `ARENA_BLOCK_SIZE` is used.
+ * @param timer The timer whose ticks start new frames. If `NULL`, frames only start with `Frame_Arena_begin`.
+ *
+ * @return A pointer to the new frame arena. `NULL` if memory allocation fails.
+ */
+extern Frame_Arena* Frame_Arena_new(size_t block_size, const Timer* timer);
+
+/* ================================================================ */
+
+/**
+ * The `Frame_Arena_destroy` function releases a frame arena and sets the pointer to `NULL`.
+ *
+ * @return None.
+ */
+extern void Frame_Arena_destroy(Frame_Arena** arena);
+
+/* ================================================================ */
+
+/**
+ * The `Frame_Arena_begin` function starts a new frame: it switches to the other buffer and resets it.
+ * It does not need to be called when the arena has a timer, because every `Timer_tick` starts a new frame.
+ *
+ * @return None.
+ */
+extern void Frame_Arena_begin(Frame_Arena* arena);
+
+/* ================================================================ */
+
+/**
+ * The `Frame_Arena_get` function returns the arena of the current frame, for example to take marks for nested temporary use.
+ *
+ * @return A pointer to the arena of the current frame. `NULL` if `arena` is `NULL`.
+ */
+extern Arena* Frame_Arena_get(Frame_Arena* arena);
+
+/* ================================================================ */
+
+/**
+ * The `Frame_alloc` function allocates memory that stays valid until the end of the next frame.
+ *
+ * @param arena A pointer to the frame arena.
+ * @param size The number of bytes to allocate.
+ * @param alignment The alignment of the allocation; `0` for `ARENA_DEFAULT_ALIGNMENT`.
+ *
+ * @return A pointer to uninitialized memory. `NULL` on failure.
+ */
+extern void* Frame_alloc(Frame_Arena* arena, size_t size, size_t alignment);
+
+/* ================================================================ */
+
+/**
+ * The `Frame_Arena_current` function returns the frame arena of the application, which the library uses for its own temporary data.
+ *
+ * @return A pointer to the frame arena of the most recently created application. `NULL` if there is none or the caller is not the thread that created it.
+ */
+extern Frame_Arena* Frame_Arena_current(void);
+
+/* ================================================================ */
+
+/**
+ * The `Frame_Arena_set_current` function changes the frame arena returned by `Frame_Arena_current`. It is called by `Application_new` and `Application_destroy`.
+ *
+ * @return None.
+ */
+extern void Frame_Arena_set_current(Frame_Arena* arena);
+
+/* ================================================================ */
+
+/**
+ * The `Frame_temp_alloc` function allocates temporary memory for the library internals:
+ * from the current frame arena if there is one, from the heap otherwise. Release it with `Frame_temp_free`.
+ *
+ * @return A pointer to uninitialized memory. `NULL` on failure.
+ */
+extern void* Frame_temp_alloc(size_t size);
+
+/* ================================================================ */
+
+/**
+ * The `Frame_temp_free` function releases memory returned by `Frame_temp_alloc`. Memory from the frame arena is left to the arena,
+ * so it can be passed here from any thread, even after the frame arena has been reset or destroyed.
+ *
+ * @return None.
+ */
+extern void Frame_temp_free(void* pointer);
+
+/* ================================================================ */
+
+#endif /* SANCHO_PANZA_ARENA_H */
@@ -0,0 +1,118 @@
+#ifndef SANCHO_PANZA_BINLOG_H
+#define SANCHO_PANZA_BINLOG_H
+
+#include "../../sancho-panza.h"
+
+/* ================================================================ */
+
+/* The size of the buffer every thread collects its records in before they are written to the file */
+#define BINLOG_BUFFER_SIZE (64 * 1024)
+
+/* The largest number of arguments a message can have (`*` widths and precisions included) */
+#define BINLOG_MAX_ARGUMENTS 16
+
+/* The first bytes of a binary log file and the version of its layout */
+#define BINLOG_MAGIC "SPBL"
+#define BINLOG_VERSION 1
+
+/**
+ * The layout of a binary log file, in the byte order of the machine that wrote it:
+ *
+ *     header:     "SPBL", Uint32 version, Uint64 ticks per second
+ *     definition: 'F', Uint32 id, Uint8 count, count kinds (`Binlog_Kind`), Uint32 length, the format string without terminator
+ *     chunk:      'C', Uint32 thread, Uint32 size, size bytes of records
+ *     record:     Uint32 id, Uint64 ticks, the arguments: 4 bytes for `BINLOG_INT`, Uint32 length and the bytes for `BINLOG_STRING`, 8 bytes otherwise
+ *
+ * The definition of a format always comes before the first chunk that uses it. `binlog-decode` turns the file into text.
+ */
+typedef enum {
+    BINLOG_INT,
+    BINLOG_LONG,
+    BINLOG_LONG_LONG,
+    BINLOG_SIZE,
+    BINLOG_INTMAX,
+    BINLOG_PTRDIFF,
+    BINLOG_DOUBLE,
+    BINLOG_LONG_DOUBLE,
+    BINLOG_POINTER,
+    BINLOG_STRING,
+} Binlog_Kind;
+
+/**
+ * A place in the code that writes binary log records. The `binlog` macro creates one per call site,
+ * so the format string is parsed and its definition is written only the first time the call site runs.
+ */
+typedef struct binlog_site {
+
+    /* The generation of the log the format has been registered with; `0` until then */
+    SDL_atomic_t generation;
+
+    /* The identifier of the format in that log and the kinds of its arguments */
+    Uint32 id;
+    Uint8 count;
+    Uint8 kinds[BINLOG_MAX_ARGUMENTS];
+
+    /* Set when the format is not supported, so the call site is rejected once and then writes nothing for the rest of that log */
+    Uint8 rejected;
+} Binlog_Site;
+
+/* ================================================================ */
+
+/**
+ * The `binlog` macro records a message in the binary log: only the identifier of the format and the raw values of the arguments are stored,
+ * and the text is produced later by the `binlog-decode` tool. It costs a few stores when the log is open and a load when it is not.
+ * Strings are copied; `%n` is not supported. Like `error`, it needs at least one argument after the format (pass `""` if there is none).
+ * Compiling with `BINLOG_DISABLE` removes every call.
+ */
+#ifndef BINLOG_DISABLE
+    #define binlog(format, ...) \
+        do { \
+            static Binlog_Site binlog_site; \
+            Binlog_write(&binlog_site, (format), __VA_ARGS__); \
+        } while (0)
+#else
+    #define binlog(format, ...) do { } while (0)
+#endif
+
+/* ================================================================ */
+
+/**
+ * The `Binlog_open` function creates a binary log file and starts recording `binlog` messages into it.
+ *
+ * @param name A null-terminated string that specifies the file. An existing file is replaced.
+ *
+ * @return `0` on success. `-1` if a log is already open or the file cannot be created.
+ */
+extern int Binlog_open(const char* name);
+
+/* ================================================================ */
+
+/**
+ * The `Binlog_close` function writes the buffers of all threads and closes the log. No thread may be writing records when it is called.
+ * The function is called by `SP_quit`.
+ *
+ * @return None.
+ */
+extern void Binlog_close(void);
+
+/* ================================================================ */
+
+/**
+ * The `Binlog_flush` function writes the buffer of the calling thread into the file, for example at the end of a frame.
+ *
+ * @return None.
+ */
+extern void Binlog_flush(void);
+
+/* ================================================================ */
+
+/**
+ * The `Binlog_write` function records a message. Use the `binlog` macro instead, which provides the call site.
+ *
+ * @return None.
+ */
+extern void Binlog_write(Binlog_Site* site, const char* format, ...);
+
+/* ================================================================ */
+
+#endif /* SANCHO_PANZA_BINLOG_H */
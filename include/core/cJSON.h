@@ -84,6 +84,8 @@ then using the CJSON_API_VISIBILITY flag to "export" the same symbols the way CJ
 #define CJSON_VERSION_PATCH 17
 
 #include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
 
 /* cJSON Types: */
 #define cJSON_Invalid (0)
@@ -98,6 +100,13 @@ then using the CJSON_API_VISIBILITY flag to "export" the same symbols the way CJ
 
 #define cJSON_IsReference 256
 #define cJSON_StringIsConst 512
+/* set with cJSON_Array on an array whose numbers are stored in one buffer instead of child nodes, see cJSON_CreatePackedArray */
+#define cJSON_IsPacked 1024
+
+/* The element types of packed arrays: */
+#define cJSON_PackedDouble (1) /* double */
+#define cJSON_PackedInt32  (2) /* int32_t */
+#define cJSON_PackedUint8  (3) /* uint8_t */
 
 /* The cJSON structure: */
 typedef struct cJSON
@@ -131,12 +140,68 @@ typedef struct cJSON_Hooks
 
 typedef int cJSON_bool;
 
+/* A position in an array (or object), see cJSON_ArrayIteratorInit. */
+typedef struct cJSON_ArrayIterator
+{
+    /* the element cJSON_ArrayIteratorNext returned last, and its position (elements detached during the walk still count) */
+    cJSON *item;
+    size_t index;
+    /* private */
+    cJSON *next;
+    size_t next_index;
+} cJSON_ArrayIterator;
+
+/* A tree parsed into an arena, see cJSON_ParseDocument. */
+typedef struct cJSON_Document cJSON_Document;
+
+/* The keys interned by a context, see cJSON_Context.intern_keys. */
+typedef struct cJSON_KeyTable cJSON_KeyTable;
+
+/* What the _ctx functions use instead of the global hooks and error position, so threads that each have their own context
+ * can parse and print at the same time. Set it up with cJSON_InitContext; the limits may be changed afterwards. */
+typedef struct cJSON_Context
+{
+    /* NULL members mean malloc and free */
+    cJSON_Hooks hooks;
+    /* how deeply arrays and objects may nest, CJSON_NESTING_LIMIT by default */
+    size_t nesting_limit;
+    /* the longest input accepted, in bytes, or 0 (the default) for no limit */
+    size_t max_length;
+    /* parse arrays of at least this many elements that are all numbers into packed arrays (see cJSON_CreatePackedArray), or 0 (the default) not to */
+    size_t pack_threshold;
+    /* store each distinct key parsed with this context once, shared by every member with that key, or false (the default) to copy it for each member.
+     * The shared keys are marked cJSON_StringIsConst and live until cJSON_ReleaseContext, which must come after the trees (and their copies) are deleted */
+    cJSON_bool intern_keys;
+    /* the interned keys, private */
+    cJSON_KeyTable *keys;
+    /* where the last parse with this context failed, read it with cJSON_GetErrorPtr_ctx */
+    const char *error_json;
+    size_t error_position;
+} cJSON_Context;
+
 /* Limits how deeply nested arrays/objects can be before cJSON rejects to parse them.
  * This is to prevent stack overflows. */
 #ifndef CJSON_NESTING_LIMIT
 #define CJSON_NESTING_LIMIT 1000
 #endif
 
+/* Looking a key up in an object with at least this many members before the key builds a hash index of its keys, which the next lookups use.
+ * The index is dropped when the object changes through the add, insert, detach, replace and delete functions; keys must not be renamed by hand. */
+#ifndef CJSON_INDEX_THRESHOLD
+#define CJSON_INDEX_THRESHOLD 32
+#endif
+
+/* Counting the children of an array (or object) with at least this many, or walking that far to an element, builds a vector of the children,
+ * so the next size queries and lookups by position take constant time. It is dropped like the index of the keys. */
+#ifndef CJSON_VECTOR_THRESHOLD
+#define CJSON_VECTOR_THRESHOLD 32
+#endif
+
+/* The size of the buffer cJSON_PrintToStream and cJSON_PrintToFileDescriptor write through. */
+#ifndef CJSON_STREAM_BUFFER_SIZE
+#define CJSON_STREAM_BUFFER_SIZE 4096
+#endif
+
 /* returns the version of cJSON as a string */
 CJSON_PUBLIC(const char*) cJSON_Version(void);
 
@@ -152,6 +217,21 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_len
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated);
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated);
 
+/* Parses like cJSON_ParseWithLengthOpts, but every node and string of the tree is allocated from a few large blocks owned by the document,
+ * so parsing makes a handful of allocations and cJSON_DeleteDocument frees the whole tree at once, without walking it. A key repeated
+ * across the members of the document (as in an array of objects of the same shape) is stored once.
+ * The tree is meant to be read: cJSON_Delete does nothing on its nodes, and items added to it are not freed with the document (detach them first).
+ * Use cJSON_Duplicate for a copy that can be changed freely. Returns NULL if parsing fails. */
+CJSON_PUBLIC(cJSON_Document *) cJSON_ParseDocument(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated);
+/* The root of the tree of a document, valid until the document is deleted. */
+CJSON_PUBLIC(cJSON *) cJSON_GetDocumentRoot(const cJSON_Document * const document);
+/* Frees a document and every node of its tree. */
+CJSON_PUBLIC(void) cJSON_DeleteDocument(cJSON_Document *document);
+
+/* Reads the number at the start of value, from at most length bytes, the way the parser does (without the locale).
+ * Returns the number of bytes read, or 0 if value does not start with a number. */
+CJSON_PUBLIC(size_t) cJSON_ReadNumber(const char *value, size_t length, double *number);
+
 /* Render a cJSON entity to text for transfer/storage. */
 CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item);
 /* Render a cJSON entity to text for transfer/storage without any formatting. */
@@ -161,13 +241,45 @@ CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON
 /* Render a cJSON entity to text using a buffer already allocated in memory with given length. Returns 1 on success and 0 on failure. */
 /* NOTE: cJSON is not always 100% accurate in estimating how much memory it will use, so to be safe allocate 5 bytes more than you actually need */
 CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, const int length, const cJSON_bool format);
+/* Render a cJSON entity directly to a stream or a file descriptor, through a buffer of CJSON_STREAM_BUFFER_SIZE bytes, so memory use does not depend on the size of the document.
+ * The buffer only grows for a single string longer than it. Returns false if printing or writing fails; the output may then be incomplete. fmt=0 gives unformatted, =1 gives formatted */
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintToStream(const cJSON *item, FILE *stream, cJSON_bool format);
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintToFileDescriptor(const cJSON *item, int fd, cJSON_bool format);
 /* Delete a cJSON entity and all subentities. */
 CJSON_PUBLIC(void) cJSON_Delete(cJSON *item);
 
+/* Sets up a context with the given allocator (NULL for malloc and free), the default limits and no error. */
+CJSON_PUBLIC(void) cJSON_InitContext(cJSON_Context *context, const cJSON_Hooks *hooks);
+/* Frees the keys interned by a context. Nothing else of a context needs to be released. */
+CJSON_PUBLIC(void) cJSON_ReleaseContext(cJSON_Context *context);
+/* The interned copy of a key, the same pointer as the keys of the members parsed with the context, to name created members with cJSON_AddItemToObjectCS
+ * (so they share the storage too) and to look keys up: a lookup with the very pointer of a key matches it without comparing the characters.
+ * Returns NULL if memory is short. */
+CJSON_PUBLIC(const char *) cJSON_InternKey_ctx(cJSON_Context *context, const char *key);
+/* Parse like their counterparts without _ctx, but allocate with the hooks of the context, apply its limits and keep the error position in it:
+ * they touch no global state. A tree parsed with a context is deleted with cJSON_Delete_ctx and the same context.
+ * The functions that add or replace items allocate with the global hooks, so only change such a tree if both allocators are the same. */
+CJSON_PUBLIC(cJSON *) cJSON_Parse_ctx(cJSON_Context *context, const char *value);
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength_ctx(cJSON_Context *context, const char *value, size_t buffer_length);
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts_ctx(cJSON_Context *context, const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated);
+/* Where the last parse with the context failed, or NULL if it succeeded. */
+CJSON_PUBLIC(const char *) cJSON_GetErrorPtr_ctx(const cJSON_Context *context);
+/* Print with the hooks of the context; free the result with cJSON_free_ctx. */
+CJSON_PUBLIC(char *) cJSON_Print_ctx(const cJSON_Context *context, const cJSON *item);
+CJSON_PUBLIC(char *) cJSON_PrintUnformatted_ctx(const cJSON_Context *context, const cJSON *item);
+CJSON_PUBLIC(void) cJSON_Delete_ctx(const cJSON_Context *context, cJSON *item);
+CJSON_PUBLIC(void) cJSON_free_ctx(const cJSON_Context *context, void *object);
+
 /* Returns the number of items in an array (or object). */
 CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array);
 /* Retrieve item number "index" from array "array". Returns NULL if unsuccessful. */
 CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index);
+/* Walks an array (or object) from the element at start, reaching it in constant time once the array has a vector:
+ *     cJSON_ArrayIteratorInit(&iterator, array, 0);
+ *     while ((element = cJSON_ArrayIteratorNext(&iterator)) != NULL) { ... iterator.index ... }
+ * Unlike cJSON_ArrayForEach, the element just returned may be detached or deleted before the next call. */
+CJSON_PUBLIC(void) cJSON_ArrayIteratorInit(cJSON_ArrayIterator *iterator, const cJSON *array, int start);
+CJSON_PUBLIC(cJSON *) cJSON_ArrayIteratorNext(cJSON_ArrayIterator *iterator);
 /* Get item "string" from object. Case insensitive. */
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItem(const cJSON * const object, const char * const string);
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItemCaseSensitive(const cJSON * const object, const char * const string);
@@ -203,6 +315,17 @@ CJSON_PUBLIC(cJSON *) cJSON_CreateRaw(const char *raw);
 CJSON_PUBLIC(cJSON *) cJSON_CreateArray(void);
 CJSON_PUBLIC(cJSON *) cJSON_CreateObject(void);
 
+/* A packed array holds count numbers of one element type (cJSON_PackedDouble, cJSON_PackedInt32 or cJSON_PackedUint8) in a single buffer,
+ * copied from values, behind one node: it costs the size of its numbers instead of a node each. It prints, compares and duplicates like
+ * an ordinary array and cJSON_GetArraySize counts its elements, but it has no children: cJSON_GetArrayItem and cJSON_ArrayForEach see
+ * it empty, and nothing can be added to it. Read it with cJSON_GetPackedArray, or turn it into an ordinary array with cJSON_UnpackArray. */
+CJSON_PUBLIC(cJSON *) cJSON_CreatePackedArray(int element_type, const void *values, size_t count);
+CJSON_PUBLIC(cJSON_bool) cJSON_IsPackedArray(const cJSON * const item);
+/* The elements of a packed array, which may be changed in place, with their type and number. NULL if the item is not a packed array. */
+CJSON_PUBLIC(void *) cJSON_GetPackedArray(const cJSON * const item, int *element_type, size_t *count);
+/* Replaces the buffer of a packed array with a child node per number. Returns false if memory runs out, leaving the array packed. */
+CJSON_PUBLIC(cJSON_bool) cJSON_UnpackArray(cJSON *array);
+
 /* Create a string where valuestring references a string so
  * it will not be freed by cJSON_Delete */
 CJSON_PUBLIC(cJSON *) cJSON_CreateStringReference(const char *string);
@@ -36,21 +36,51 @@ typedef struct application App;
 /* ============= with appropriate prefixes and colors ============= */
 /* ================================================================ */
 
+/* The values of `LOG_LEVEL`. Every message at or above the level is printed; the others are compiled out (their arguments are still type-checked) */
+#define LOG_LEVEL_SUCCESS 0
+#define LOG_LEVEL_WARNING 1
+#define LOG_LEVEL_ERROR 2
+#define LOG_LEVEL_NONE 3
+
+/*
+ * The least severe messages that are printed. Define it before including the library (or with `-DLOG_LEVEL=...`) to choose the messages.
+ * Otherwise, builds with `STRICT` (the default of the Makefile) print every message, and other builds print the errors only
+ */
+#ifndef LOG_LEVEL
+    #ifdef STRICT
+        #define LOG_LEVEL LOG_LEVEL_SUCCESS
+    #else
+        #define LOG_LEVEL LOG_LEVEL_ERROR
+    #endif
+#endif
+
 /**
  * The `error` macro is a convenient way to print error messages using the `print_message` function.
  * It prepends the message with a red "Error:" prefix and sends the output to the specified stream (usually `stderr`).
  */
-#define error(stream, format, ...) print_message((stream), ERROR, (format), __VA_ARGS__)
+#if LOG_LEVEL <= LOG_LEVEL_ERROR
+    #define error(stream, format, ...) print_message((stream), ERROR, (format), __VA_ARGS__)
+#else
+    #define error(stream, format, ...) do { if (0) { print_message((stream), ERROR, (format), __VA_ARGS__); } } while (0)
+#endif
 
 /**
  * The `warning` macro is used to print warning messages using the `print_message` function. It prepends the message with a yellow "Warning:" prefix and sends the output to the specified stream (usually `stdout`).
  */
-#define warning(stream, format, ...) print_message((stream), WARNING, (format), __VA_ARGS__)
+#if LOG_LEVEL <= LOG_LEVEL_WARNING
+    #define warning(stream, format, ...) print_message((stream), WARNING, (format), __VA_ARGS__)
+#else
+    #define warning(stream, format, ...) do { if (0) { print_message((stream), WARNING, (format), __VA_ARGS__); } } while (0)
+#endif
 
 /**
  * The `success` macro is used to print success messages using the `print_message` function. It prepends the message with a green "Success:" prefix and sends the output to the specified stream (usually stdout).
  */
-#define success(stream, format, ...) print_message((stream), SUCCESS, (format), __VA_ARGS__)
+#if LOG_LEVEL <= LOG_LEVEL_SUCCESS
+    #define success(stream, format, ...) print_message((stream), SUCCESS, (format), __VA_ARGS__)
+#else
+    #define success(stream, format, ...) do { if (0) { print_message((stream), SUCCESS, (format), __VA_ARGS__); } } while (0)
+#endif
 
 /* ================================================================ */
 
@@ -64,11 +94,33 @@ typedef enum {
 
 typedef enum {ERROR, WARNING, SUCCESS} Message_Type;
 
+/**
+ * How the contents of a mapped file are going to be accessed. `map_file` passes the hint on to `madvise`.
+ */
+typedef enum {
+    MAP_ADVICE_NORMAL,
+    MAP_ADVICE_SEQUENTIAL,
+    MAP_ADVICE_RANDOM,
+    MAP_ADVICE_WILLNEED,
+} Map_Advice;
+
+/**
+ * The contents of a file loaded by `map_file`. The data is read-only and is not null-terminated when it is mapped.
+ */
+typedef struct mapped_file {
+
+    const char* data;
+    size_t size;
+
+    /* `1` if `data` is a memory mapping, `0` if it is a heap buffer the file was read into */
+    int mapped;
+} Mapped_File;
+
 /* ================================================================ */
 
 /**
  * The `read_file2buffer` function reads the contents of a file specified by `name` into a dynamically allocated buffer pointed to by `buffer`.
- * If compiled with the `STRICT` option, the function will also print error messages describing any issues encountered
+ * The function also prints error messages describing any issues encountered (see `LOG_LEVEL`)
  * 
  * @param name A null-terminated string specifying the path to the file to be read.
  * @param buffer A pointer to a `char*` that will hold the address of the dynamically allocated buffer containing the file contents.
@@ -79,9 +131,36 @@ extern int read_file2buffer(const char* name, char** buffer);
 
 /* ================================================================ */
 
+/**
+ * The `map_file` function maps the contents of a file into memory read-only, so it can be used without copying it.
+ * Pipes, character devices and other files that cannot be mapped are read into a heap buffer instead.
+ * The function also prints error messages describing any issues encountered (see `LOG_LEVEL`).
+ *
+ * @param name A null-terminated string specifying the path to the file to be loaded.
+ * @param file A pointer to the `Mapped_File` structure that receives the contents. It must be released with `unmap_file`.
+ * @param advice The expected access pattern of the contents.
+ *
+ * @return On success, the function returns `0`. On failure, the function returns the value of `errno` indicating the error that occurred.
+ */
+extern int map_file(const char* name, Mapped_File* file, Map_Advice advice);
+
+/* ================================================================ */
+
+/**
+ * The `unmap_file` function releases the contents of a file loaded by `map_file` and clears the structure.
+ *
+ * @param file A pointer to the `Mapped_File` structure. `NULL` is ignored.
+ *
+ * @return None.
+ */
+extern void unmap_file(Mapped_File* file);
+
+/* ================================================================ */
+
 /**
  * The `print_message` function prints a formatted message to the specified output stream.
  * It prepends the message with a colored prefix indicating the message type ("Error:", "Warning:", or "Success:") and resets the text color after the message.
+ * When the logger is running (see `Log_init`), the message is only formatted on the calling thread and is written and flushed later by the logger thread.
  * 
  * @param stream A pointer to a `FILE` object representing the output stream where the message will be written.
  * If stream is `NULL`, it defaults to `stderr` for errors and `stdout` for warnings and successes.
@@ -108,10 +187,39 @@ extern int JSON_parse(const char* buffer, cJSON** root);
 
 /* ================================================================ */
 
+/**
+ * The `JSON_parse_mapped` function parses the contents of a file loaded by `map_file` with `cJSON_ParseWithLength`, directly from the mapping.
+ * It reports the error location like `JSON_parse` does.
+ *
+ * @param file A pointer to the loaded file.
+ * @param root A pointer to a pointer of type `cJSON*`. This will be set to point to the parsed `cJSON` object if the parsing is successful.
+ *
+ * @return `0` on success. `-1` on failure, if an argument is `NULL` or the contents are not valid JSON.
+ */
+extern int JSON_parse_mapped(const Mapped_File* file, cJSON** root);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_print_frame` function converts a `cJSON` object into a string, like `cJSON_Print`, but the string is temporary memory:
+ * it is allocated from the frame arena of the application when there is one, so printing does not allocate from the heap once the arena has grown large enough.
+ *
+ * When called from the thread that created the application, the string is valid until the end of the next frame (see `Frame_alloc`),
+ * and only that thread may use it. When called from another thread or without an application, it comes from the heap and stays valid until it is released.
+ *
+ * @param item A pointer to the `cJSON` object to print.
+ * @param format `1` for formatted output, as `cJSON_Print` produces. `0` for unformatted output, as `cJSON_PrintUnformatted` produces.
+ *
+ * @return A pointer to the null-terminated string, which must be released with `Frame_temp_free`. `NULL` on failure.
+ */
+extern char* JSON_print_frame(const cJSON* item, int format);
+
+/* ================================================================ */
+
 /**
  * This function opens a specified file for writing and writes a given string to it.
  * It includes error handling to manage cases where the filename is not specified or the file cannot be opened,
- * with error messages printed only when compiled with the `STRICT` option.
+ * with error messages printed unless `LOG_LEVEL` silences them.
  * 
  * @param name A pointer to a null-terminated string that specifies the name of the file to be opened.
  * @param string A pointer to a null-terminated string that contains the data to be written to the file.
@@ -122,6 +230,20 @@ extern int write_to_file(const char* name, const char* string);
 
 /* ================================================================ */
 
+/**
+ * The `JSON_write_to_file` function prints a `cJSON` object directly into a file with `cJSON_PrintToStream`.
+ * Unlike printing the object to a string and passing it to `write_to_file`, it uses a fixed amount of memory whatever the size of the document.
+ *
+ * @param name A pointer to a null-terminated string that specifies the name of the file to be written.
+ * @param item A pointer to the `cJSON` object to print.
+ * @param format `1` for formatted output, as `cJSON_Print` produces. `0` for unformatted output, as `cJSON_PrintUnformatted` produces.
+ *
+ * @return `0` on success. `-1` on failure, if an argument is `NULL`, the file cannot be opened or writing fails.
+ */
+extern int JSON_write_to_file(const char* name, const cJSON* item, int format);
+
+/* ================================================================ */
+
 /**
  * The `extract_JSON_data` function extracts a specified JSON element from a `cJSON` object based on its name and type.
  * It verifies that the extracted element matches the expected type and handles errors appropriately.
@@ -139,7 +261,7 @@ extern int extract_JSON_data(const cJSON* root, const char* name, JSON_Entity ty
 
 /**
  * The `SP_init` function initializes the Sancho Panza application by reading a configuration file, parsing its contents,
- * and setting up the SDL2 library along with the application window and timer.
+ * and setting up the SDL2 library along with the job system, the application window and timer.
  * It handles errors gracefully and ensures that resources are properly managed.
  * 
  * @param app A pointer to a pointer of type `App*`. This will be set to point to the newly created application instance if the initialization is successful.
@@ -167,11 +289,12 @@ extern cJSON* serialize__SDL_Color(const SDL_Color* color);
  * The `deserialize__SDL_Color` function extracts color information from a specified `JSON` object and populates an `SDL_Color`
  * structure with the corresponding red, green, blue, and alpha components.
  * The function uses a `label` to identify the specific color object within the JSON structure.
- * The color is expected to be stored as a JSON object in the document.
+ * The color is expected to be stored as a JSON object in the document. The components are read in a single pass over the object,
+ * every missing or invalid component is reported, and `color` is only changed if all four are valid numbers in `[0, 255]`.
  * 
  * @param root A pointer to the root `cJSON` object containing the color data. This parameter must not be `NULL`.
  * @param color A pointer to an `SDL_Color` structure where the extracted color components will be stored. This parameter must not be `NULL`.
- * @param label A string representing the key in the `JSON` object that identifies the color data. This parameter must not be `NULL`.
+ * @param label A string representing the key in the `JSON` object that identifies the color data. If `NULL`, `root` itself is the color object.
  * 
  * @return The function returns `0` on success, indicating that the color was successfully extracted and populated.
  * It returns `-1` on failure, indicating an error in the deserialization process.
@@ -203,6 +326,60 @@ extern Uint32 deserialize__SDL_Init__flags(const cJSON* root, const char* label)
 
 /* ================================================================ */
 
+/**
+ * The `serialize__SDL_Window__flags` function creates a JSON array that contains the names of the given `SDL_WindowFlags`.
+ * A flag made of several bits (`SDL_WINDOW_FULLSCREEN_DESKTOP`) is named when all its bits are set; bits with no name are left out.
+ *
+ * @param flags The window flags, for example the value returned by `SDL_GetWindowFlags`.
+ *
+ * @return Returns a pointer to a `cJSON` array containing the names of the flags. Returns `NULL` if the array creation fails or if an error occurs while adding items to the array.
+ */
+extern cJSON* serialize__SDL_Window__flags(Uint32 flags);
+
+/* ================================================================ */
+
+/**
+ * The `deserialize__SDL_Window__flags` function extracts an array of `SDL_WindowFlags` names from a JSON object and combines the flags they name.
+ * Unknown names and elements that are not strings are ignored with a warning.
+ *
+ * @param root A pointer to the JSON object from which the flags will be extracted.
+ * @param label A string label used to identify the array within the JSON object. If `NULL`, it defaults to "SDL_Window__flags".
+ *
+ * @return Returns a `Uint32` value representing the combined window flags. If the root JSON object is `NULL` or the extraction fails, it returns `0`.
+ */
+extern Uint32 deserialize__SDL_Window__flags(const cJSON* root, const char* label);
+
+/* ================================================================ */
+
+/**
+ * The `serialize__SDL_Renderer__flags` function creates a JSON array that contains the names of the given `SDL_RendererFlags`.
+ *
+ * @param flags The renderer flags, for example the `flags` member of `SDL_RendererInfo`.
+ *
+ * @return Returns a pointer to a `cJSON` array containing the names of the flags. Returns `NULL` if the array creation fails or if an error occurs while adding items to the array.
+ */
+extern cJSON* serialize__SDL_Renderer__flags(Uint32 flags);
+
+/* ================================================================ */
+
+/**
+ * The `deserialize__SDL_Renderer__flags` function extracts an array of `SDL_RendererFlags` names from a JSON object and combines the flags they name.
+ * Unknown names and elements that are not strings are ignored with a warning.
+ *
+ * @param root A pointer to the JSON object from which the flags will be extracted.
+ * @param label A string label used to identify the array within the JSON object. If `NULL`, it defaults to "SDL_Renderer__flags".
+ *
+ * @return Returns a `Uint32` value representing the combined renderer flags. If the root JSON object is `NULL` or the extraction fails, it returns `0`.
+ */
+extern Uint32 deserialize__SDL_Renderer__flags(const cJSON* root, const char* label);
+
+/* ================================================================ */
+
+/**
+ * The `SP_quit` function waits for pending asynchronous saves, stops the job system, closes the binary log, returns the memory of empty object pools, writes pending log messages and shuts down the SDL2 library.
+ *
+ * @return `0`.
+ */
 extern int SP_quit(void);
 
 /* ================================================================ */
@@ -0,0 +1,129 @@
+#ifndef SANCHO_PANZA_JOBS_H
+#define SANCHO_PANZA_JOBS_H
+
+#include "../../sancho-panza.h"
+
+/* ================================================================ */
+
+/* The maximum number of threads (the main thread included) the job system can run */
+#define JOBS_MAX_WORKERS 64
+
+/* The number of jobs every thread can have in flight at the same time. Must be a power of two */
+#define JOBS_PER_WORKER 4096
+
+/* ================================================================ */
+
+typedef struct job Job;
+
+/**
+ * The signature of a job entry point. The job being executed is passed as the first argument,
+ * so the function can spawn child jobs that the job will wait for (see `Job_new`).
+ */
+typedef void (*Job_Function)(Job* job, void* data);
+
+/**
+ * The signature of a `Jobs_parallel_for` body. It is called for a half-open range of indices `[first, last)`.
+ */
+typedef void (*Jobs_Range_Function)(size_t first, size_t last, void* data);
+
+/* ================================================================ */
+
+/**
+ * The `Jobs_init` function starts the job system: a fixed pool of worker threads,
+ * each owning a work-stealing deque. The calling thread becomes worker `0` and takes part in the work while waiting for jobs.
+ * The function is called by `SP_init` with the value of `Jobs.workers` from the configuration file.
+ *
+ * @param workers The total number of threads (the calling thread included). If `0` or negative, the number of CPU cores is used.
+ *
+ * @return `0` on success, indicating that the worker threads are running. `-1` on failure, indicating that the job system is already running or a thread could not be created.
+ */
+extern int Jobs_init(int workers);
+
+/* ================================================================ */
+
+/**
+ * The `Jobs_quit` function stops and joins all worker threads. Jobs that were queued but not started are executed first, so waiting on them returns.
+ * The function is called by `SP_quit`.
+ *
+ * @return None.
+ */
+extern void Jobs_quit(void);
+
+/* ================================================================ */
+
+/**
+ * The `Jobs_count_workers` function returns the number of threads that execute jobs.
+ *
+ * @return The number of worker threads (the main thread included). `1` if the job system is not running.
+ */
+extern int Jobs_count_workers(void);
+
+/* ================================================================ */
+
+/**
+ * The `Job_new` function creates a job that calls `function` with `data` when executed. The job is not scheduled until `Job_run` is called.
+ * Jobs are taken from a per-thread ring, so they must not be freed, but no thread may have more than `JOBS_PER_WORKER` unfinished jobs.
+ * It must be called from the thread that initialized the job system or from inside a job.
+ *
+ * @param function The function to execute. This parameter must not be `NULL`.
+ * @param data A pointer passed to the function unchanged.
+ * @param parent A job that must not be considered finished until the new job finishes. Can be `NULL`.
+ *
+ * @return A pointer to the new job. `NULL` if the job system is not running or it is called from a foreign thread.
+ */
+extern Job* Job_new(Job_Function function, void* data, Job* parent);
+
+/* ================================================================ */
+
+/**
+ * The `Job_run` function pushes a job onto the calling thread's deque, from where it can be executed by this thread or stolen by an idle worker.
+ * If the deque is full, the job is executed immediately.
+ *
+ * @param job A pointer to a job created by `Job_new`.
+ *
+ * @return `0` on success. `-1` if `job` is `NULL`.
+ */
+extern int Job_run(Job* job);
+
+/* ================================================================ */
+
+/**
+ * The `Job_wait` function blocks until the job and all its children are finished.
+ * Instead of sleeping, the calling thread executes other pending jobs in the meantime.
+ *
+ * @param job A pointer to a job that has been passed to `Job_run`.
+ *
+ * @return None.
+ */
+extern void Job_wait(const Job* job);
+
+/* ================================================================ */
+
+/**
+ * The `Job_is_finished` function checks whether the job and all its children have been executed.
+ *
+ * @param job A pointer to a job.
+ *
+ * @return `1` if the job is finished (or `NULL`), `0` otherwise.
+ */
+extern int Job_is_finished(const Job* job);
+
+/* ================================================================ */
+
+/**
+ * The `Jobs_parallel_for` function calls `function` over the range `[0, count)` split into chunks that are executed by all worker threads.
+ * The range is split recursively in halves until a chunk is small enough, so the work spreads across the workers by stealing.
+ * The function returns when the whole range has been processed. If the job system is not running, the range is processed on the calling thread.
+ *
+ * @param count The number of indices to process.
+ * @param min_chunk The smallest number of indices a chunk may have. If `0`, it is picked automatically from `count` and the number of workers.
+ * @param function The function to call for every chunk. This parameter must not be `NULL`.
+ * @param data A pointer passed to the function unchanged.
+ *
+ * @return `0` on success. `-1` if `function` is `NULL`.
+ */
+extern int Jobs_parallel_for(size_t count, size_t min_chunk, Jobs_Range_Function function, void* data);
+
+/* ================================================================ */
+
+#endif /* SANCHO_PANZA_JOBS_H */
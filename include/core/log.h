@@ -0,0 +1,59 @@
+#ifndef SANCHO_PANZA_LOG_H
+#define SANCHO_PANZA_LOG_H
+
+#include "../../sancho-panza.h"
+
+/* ================================================================ */
+
+/* The number of records the log ring can hold. Must be a power of two */
+#define LOG_RING_SIZE 1024
+
+/* Messages up to this length are stored in the record itself; longer ones are copied to the heap */
+#define LOG_INLINE_SIZE 216
+
+/* ================================================================ */
+
+/**
+ * The `Log_init` function starts the background thread of the logger. From then on, `print_message` (and the `error`, `warning` and `success` macros)
+ * only format the message and put it into a lock-free ring; the thread adds the colored prefixes, writes the records in batches and flushes each stream once per batch.
+ * Without the thread, messages are written on the calling thread. The function is called by `SP_init`.
+ *
+ * @return `0` on success. `-1` if the logger is already running or the thread could not be created.
+ */
+extern int Log_init(void);
+
+/* ================================================================ */
+
+/**
+ * The `Log_quit` function writes every pending record and stops the background thread. The function is called by `SP_quit`.
+ *
+ * @return None.
+ */
+extern void Log_quit(void);
+
+/* ================================================================ */
+
+/**
+ * The `Log_flush` function blocks until every record submitted before the call has been written and flushed.
+ *
+ * @return None.
+ */
+extern void Log_flush(void);
+
+/* ================================================================ */
+
+/**
+ * The `Log_vprint` function is the `va_list` version of `print_message`. Messages are never truncated.
+ *
+ * @param stream The output stream. If `NULL`, `stderr` is used for errors and `stdout` for the other types.
+ * @param msg_type The type of the message, which selects its prefix.
+ * @param format A `printf` format string.
+ * @param args The arguments of the format string.
+ *
+ * @return None.
+ */
+extern void Log_vprint(FILE* stream, Message_Type msg_type, const char* format, va_list args);
+
+/* ================================================================ */
+
+#endif /* SANCHO_PANZA_LOG_H */
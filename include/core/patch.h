@@ -0,0 +1,91 @@
+#ifndef SANCHO_PANZA_PATCH_H
+#define SANCHO_PANZA_PATCH_H
+
+#include "../../sancho-panza.h"
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Patch_diff` function compares two values structurally and returns a JSON Patch (RFC 6902) that turns the first into the second:
+ * an array of `add`, `remove` and `replace` operations whose paths are JSON Pointers (see `JSON_Path_compile`).
+ * Values are equal when `cJSON_Compare` (with the case of keys) says so.
+ *
+ * Members are matched by key, so only the members that changed, appeared or disappeared have an operation.
+ * Arrays are compared after their common beginning and end, so inserting or removing elements in one place takes one operation per element.
+ * Two packed arrays with the same element type and size are compared element by element; any other change of a packed array replaces it.
+ *
+ * @param from The value before.
+ * @param to The value after.
+ *
+ * @return A new array of operations, empty if the values are equal, which must be deleted with `cJSON_Delete`. `NULL` if an argument is `NULL` or memory allocation fails.
+ */
+extern cJSON* JSON_Patch_diff(const cJSON* from, const cJSON* to);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Patch_apply` function applies the operations of a JSON Patch to a value, in order: `add`, `remove`, `replace`, `move`, `copy` and `test`.
+ * The values of the operations are copied. A `replace` of a number in a packed array stores it in place when the element type can hold it;
+ * any other change of a packed array unpacks it first.
+ *
+ * The value is changed in place, so if an operation fails, the operations before it stay applied. Apply the patch to a copy
+ * (see `cJSON_Duplicate`) when the value must not be left half-patched.
+ * The error message (see `LOG_LEVEL`) says which operation failed.
+ *
+ * @param root A pointer to the value. A patch may replace the whole value (with the path `""`), so the pointer may change.
+ * @param patch An array of operations.
+ *
+ * @return `0` on success. `-1` if an argument is `NULL`, an operation is malformed, a path is missing, a `test` fails, or memory allocation fails.
+ */
+extern int JSON_Patch_apply(cJSON** root, const cJSON* patch);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Journal_append` function appends a patch to a journal: a file of patches, one per line, that extends a base file
+ * (a document saved with `JSON_Journal_compact`, or any JSON file). Saving a few changes then writes their size, not the size of the document.
+ *
+ * The first line of a journal identifies the version of the base file it extends, so a journal left over from an older base
+ * (after a compaction interrupted between replacing the base and resetting the journal) is started again instead of extended.
+ * The line is written with a single `write` and is not synced, like any append; a patch cut short by a crash is skipped when loading.
+ *
+ * @param base A null-terminated string that specifies the base file. It must exist.
+ * @param journal A null-terminated string that specifies the journal. It is created if needed.
+ * @param patch The patch, as returned by `JSON_Patch_diff`. An empty patch appends nothing.
+ *
+ * @return `0` on success. `-1` if an argument is `NULL`, the base file is missing, or the journal cannot be written.
+ */
+extern int JSON_Journal_append(const char* base, const char* journal, const cJSON* patch);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Journal_load` function parses a base file and applies the patches of its journal, in order.
+ * A missing journal, or one that extends another version of the base file, adds nothing.
+ *
+ * @param base A null-terminated string that specifies the base file.
+ * @param journal A null-terminated string that specifies the journal.
+ * @param root A pointer that receives the document, which must be deleted with `cJSON_Delete`.
+ *
+ * @return `0` on success. `-1` if the base file cannot be read or parsed, the journal cannot be read, or a patch cannot be applied.
+ */
+extern int JSON_Journal_load(const char* base, const char* journal, cJSON** root);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Journal_compact` function saves a document as the new base file, then starts the journal again, empty.
+ * Both files are replaced atomically through the saver (see `Save_JSON_async`), and the function waits until they are written.
+ *
+ * @param base A null-terminated string that specifies the base file.
+ * @param journal A null-terminated string that specifies the journal.
+ * @param root The document. It is copied.
+ * @param format `1` for formatted output, as `cJSON_Print` produces. `0` for unformatted output.
+ *
+ * @return `0` on success. `-1` on failure; the base file and the journal then still describe the previous document, or the new one.
+ */
+extern int JSON_Journal_compact(const char* base, const char* journal, const cJSON* root, int format);
+
+/* ================================================================ */
+
+#endif /* SANCHO_PANZA_PATCH_H */
@@ -0,0 +1,103 @@
+#ifndef SANCHO_PANZA_PATH_H
+#define SANCHO_PANZA_PATH_H
+
+#include "../../sancho-panza.h"
+
+/* ================================================================ */
+
+/* The index `JSON_Path_find_parent` gives for a last key that is not an index */
+#define JSON_PATH_NO_INDEX (-1)
+
+/* The index `JSON_Path_find_parent` gives for the last key `-`, the element after the last one of an array */
+#define JSON_PATH_END (-2)
+
+/* ================================================================ */
+
+/**
+ * A JSON Pointer (RFC 6901) such as `"/Window/width"` or `"/items/3/color/r"`, compiled once into a list of steps
+ * and run against as many documents as needed, without splitting and unescaping the pointer again.
+ *
+ * A step finds its member like `cJSON_GetObjectItemCaseSensitive`, so large objects are searched through their key index.
+ * A path is not changed by running it, so one path can be used by several threads at once.
+ * If an object has the same key twice, the first of the members is found.
+ */
+typedef struct json_path JSON_Path;
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Path_compile` function compiles a JSON Pointer: `""` is the whole document, and every `/` starts the key of a member
+ * or the index of an element, in which `~1` stands for `/` and `~0` for `~`. The index `-` (the end of an array) is accepted, but never found.
+ * After you are finished using the path, release it with `JSON_Path_destroy`.
+ *
+ * @param pointer A null-terminated string that specifies the pointer. It is copied.
+ * @param path A pointer that receives the new path.
+ *
+ * @return `0` on success. `-1` if the pointer does not start with `/` (and is not empty), has an invalid `~` sequence, or memory allocation fails.
+ */
+extern int JSON_Path_compile(const char* pointer, JSON_Path** path);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Path_destroy` function releases a path and sets the pointer to `NULL`.
+ *
+ * @return None.
+ */
+extern void JSON_Path_destroy(JSON_Path** path);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Path_find` function follows a path from a value. A step goes into a member of an object by its key (with its case),
+ * or into an element of an array by its index.
+ *
+ * @param path The path.
+ * @param root The value the path starts from.
+ *
+ * @return The value the path leads to, or `NULL` if a key or an index is missing, or a step meets a value that is neither an object nor an array.
+ */
+extern cJSON* JSON_Path_find(const JSON_Path* path, const cJSON* root);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Path_find_parent` function follows every step of a path but the last one, to find the object or array
+ * a value would be added to, replaced in or removed from.
+ *
+ * @param path The path.
+ * @param root The value the path starts from.
+ * @param key A pointer that receives the unescaped last key, owned by the path.
+ * @param index A pointer that receives the last key read as an index, `JSON_PATH_NO_INDEX` or `JSON_PATH_END`.
+ *
+ * @return The parent, or `NULL` if the path is empty (the root has no parent), or the parent is missing or is neither an object nor an array.
+ */
+extern cJSON* JSON_Path_find_parent(const JSON_Path* path, const cJSON* root, const char** key, int* index);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Path_extract` function follows a path like `JSON_Path_find`, and checks the type of what it finds like `extract_JSON_data` does.
+ * The error messages (see `LOG_LEVEL`) name the pointer of the path.
+ *
+ * @param path The path.
+ * @param root The value the path starts from.
+ * @param type The expected type (`ARRAY`, `BOOLEAN`, `OBJECT`, `NUMBER` or `STRING`).
+ * @param data A pointer that receives the value, or `NULL` on failure.
+ *
+ * @return `0` on success. `-1` if there is no such value, or it has another type.
+ */
+extern int JSON_Path_extract(const JSON_Path* path, const cJSON* root, JSON_Entity type, cJSON** data);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Path_get_pointer` function returns the pointer a path was compiled from.
+ *
+ * @return A null-terminated string owned by the path, or `NULL` if `path` is `NULL`.
+ */
+extern const char* JSON_Path_get_pointer(const JSON_Path* path);
+
+/* ================================================================ */
+
+#endif /* SANCHO_PANZA_PATH_H */
@@ -0,0 +1,127 @@
+#ifndef SANCHO_PANZA_POOL_H
+#define SANCHO_PANZA_POOL_H
+
+#include "../../sancho-panza.h"
+
+/* ================================================================ */
+
+/* The number of slots in a pool page */
+#define POOL_PAGE_SLOTS 64
+
+/* The byte written over freed slots when the library is compiled with `POOL_DEBUG` */
+#define POOL_POISON 0xDD
+
+/**
+ * The `POOL_INITIALIZER` macro defines a pool of objects of the given type as a static initializer.
+ * No memory is allocated until the first object is taken from the pool.
+ *
+ * static Pool grid_pool = POOL_INITIALIZER("Grid", Grid);
+ */
+#define POOL_INITIALIZER(label, type) {(label), sizeof(type), _Alignof(type), NULL, NULL, 0, {0, 0, 0, 0, 0}, NULL}
+
+/**
+ * The `Pool_new_object` macro takes a zeroed object of the given type from a pool.
+ */
+#define Pool_new_object(pool, type) ((type*) Pool_calloc((pool)))
+
+/* ================================================================ */
+
+typedef struct pool_page Pool_Page;
+
+/**
+ * Usage statistics of a pool.
+ */
+typedef struct pool_stats {
+
+    /* Objects currently taken from the pool and the largest number of those so far */
+    size_t live;
+    size_t peak;
+
+    /* The total number of objects taken and returned */
+    size_t allocations;
+    size_t frees;
+
+    /* The number of pages the pool owns */
+    size_t pages;
+} Pool_Stats;
+
+/**
+ * A fixed-size object allocator. Slots are grouped into pages of `POOL_PAGE_SLOTS`, and freed slots are kept on a free list,
+ * so creating and destroying objects does not go to the heap once the pool has enough pages.
+ * Use `POOL_INITIALIZER` to define a pool; the members are private.
+ */
+typedef struct pool {
+
+    const char* name;
+
+    size_t size;
+    size_t alignment;
+
+    Pool_Page* pages;
+    void* free_list;
+
+    /* Guards the pool, so objects can be created from jobs */
+    SDL_SpinLock lock;
+
+    Pool_Stats stats;
+
+    /* The next pool in the list of pools that have allocated pages */
+    struct pool* next;
+} Pool;
+
+/* ================================================================ */
+
+/**
+ * The `Pool_calloc` function takes a zeroed object from a pool, allocating a new page if all slots are taken.
+ *
+ * @param pool A pointer to the pool.
+ *
+ * @return A pointer to the object. `NULL` if `pool` is `NULL` or memory allocation fails.
+ */
+extern void* Pool_calloc(Pool* pool);
+
+/* ================================================================ */
+
+/**
+ * The `Pool_free` function returns an object to the pool it was taken from.
+ * When the library is compiled with `POOL_DEBUG`, the slot is filled with `POOL_POISON`, and returning an object twice or to the wrong pool is reported.
+ *
+ * @param pool A pointer to the pool.
+ * @param object A pointer returned by `Pool_calloc` for the same pool. `NULL` is ignored.
+ *
+ * @return None.
+ */
+extern void Pool_free(Pool* pool, void* object);
+
+/* ================================================================ */
+
+/**
+ * The `Pool_get_stats` function copies the usage statistics of a pool.
+ *
+ * @return `0` on success. `-1` if an argument is `NULL`.
+ */
+extern int Pool_get_stats(Pool* pool, Pool_Stats* stats);
+
+/* ================================================================ */
+
+/**
+ * The `Pool_print_stats` function prints the statistics of every pool that has allocated memory.
+ *
+ * @param stream The output stream. If `NULL`, `stdout` is used.
+ *
+ * @return None.
+ */
+extern void Pool_print_stats(FILE* stream);
+
+/* ================================================================ */
+
+/**
+ * The `Pool_release_unused` function returns the pages of every pool without live objects to the heap. It is called by `SP_quit`.
+ *
+ * @return None.
+ */
+extern void Pool_release_unused(void);
+
+/* ================================================================ */
+
+#endif /* SANCHO_PANZA_POOL_H */
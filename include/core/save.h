@@ -0,0 +1,101 @@
+#ifndef SANCHO_PANZA_SAVE_H
+#define SANCHO_PANZA_SAVE_H
+
+#include "../../sancho-panza.h"
+
+/* ================================================================ */
+
+typedef struct save_request Save_Handle;
+
+/**
+ * The state of a save. A save is finished once its state is no longer `SAVE_PENDING`.
+ */
+typedef enum {
+    SAVE_PENDING,
+    SAVE_DONE,
+    SAVE_FAILED,
+} Save_Status;
+
+/* ================================================================ */
+
+/**
+ * The `Saver_init` function starts the background thread that writes files handed to `Save_JSON_async` and `Save_buffer_async`.
+ * The function is called by `SP_init`.
+ *
+ * @return `0` on success, indicating that the thread is running. `-1` on failure, indicating that the saver is already running or the thread could not be created.
+ */
+extern int Saver_init(void);
+
+/* ================================================================ */
+
+/**
+ * The `Saver_quit` function waits until every queued save has been written, then stops the background thread.
+ * The function is called by `SP_quit`.
+ *
+ * @return None.
+ */
+extern void Saver_quit(void);
+
+/* ================================================================ */
+
+/**
+ * The `Save_JSON_async` function queues a `cJSON` object to be printed into a file by the background thread.
+ * The object is printed into a temporary file next to the destination, which is then renamed over it,
+ * so the destination always holds either the previous or the new contents, never a partial file. The file and its directory are synced before the save is done.
+ * The new file keeps the mode of the destination, or gets the mode the umask gives a new file.
+ * If the saver is not running, the file is written before the function returns.
+ *
+ * @param name A null-terminated string that specifies the destination file. It is copied.
+ * @param item A pointer to a detached `cJSON` object. The saver takes ownership of it and deletes it once it has been written, even if the save fails.
+ * @param format `1` for formatted output, as `cJSON_Print` produces. `0` for unformatted output.
+ * @param handle A pointer that receives a handle to poll the save with. It must be released with `Save_release`. If `NULL`, no handle is created.
+ *
+ * @return `0` if the save has been queued (or written). `-1` on failure, if an argument is `NULL` or memory allocation fails; `item` is deleted in that case as well.
+ */
+extern int Save_JSON_async(const char* name, cJSON* item, int format, Save_Handle** handle);
+
+/* ================================================================ */
+
+/**
+ * The `Save_buffer_async` function queues already serialized data to be written into a file by the background thread, the same way `Save_JSON_async` does.
+ *
+ * @param name A null-terminated string that specifies the destination file. It is copied.
+ * @param data A pointer to data allocated with `malloc`. The saver takes ownership of it and frees it once it has been written, even if the save fails.
+ * @param size The number of bytes to write.
+ * @param handle A pointer that receives a handle to poll the save with. It must be released with `Save_release`. If `NULL`, no handle is created.
+ *
+ * @return `0` if the save has been queued (or written). `-1` on failure, if an argument is `NULL` or memory allocation fails; `data` is freed in that case as well.
+ */
+extern int Save_buffer_async(const char* name, void* data, size_t size, Save_Handle** handle);
+
+/* ================================================================ */
+
+/**
+ * The `Save_poll` function returns the state of a save without blocking, so it can be checked once per frame.
+ *
+ * @return `SAVE_PENDING` while the file is being written, then `SAVE_DONE` or `SAVE_FAILED`. `SAVE_FAILED` if `handle` is `NULL`.
+ */
+extern Save_Status Save_poll(const Save_Handle* handle);
+
+/* ================================================================ */
+
+/**
+ * The `Save_wait` function blocks until a save is finished.
+ *
+ * @return `SAVE_DONE` or `SAVE_FAILED`.
+ */
+extern Save_Status Save_wait(Save_Handle* handle);
+
+/* ================================================================ */
+
+/**
+ * The `Save_release` function releases a handle returned by `Save_JSON_async` or `Save_buffer_async` and sets the pointer to `NULL`.
+ * Releasing the handle of a pending save does not cancel it.
+ *
+ * @return None.
+ */
+extern void Save_release(Save_Handle** handle);
+
+/* ================================================================ */
+
+#endif /* SANCHO_PANZA_SAVE_H */
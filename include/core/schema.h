@@ -0,0 +1,164 @@
+#ifndef SANCHO_PANZA_SCHEMA_H
+#define SANCHO_PANZA_SCHEMA_H
+
+#include "../../sancho-panza.h"
+
+#include <stddef.h>
+
+/* ================================================================ */
+
+/* The largest number of fields a schema can describe */
+#define SCHEMA_MAX_FIELDS 32
+
+/* The number of slots of the index of a schema. Must be a power of two, at least twice `SCHEMA_MAX_FIELDS` */
+#define SCHEMA_SLOTS 64
+
+/* The number of errors a report keeps (more are counted, but not kept) */
+#define SCHEMA_REPORT_SIZE 16
+
+/* ================================================================ */
+
+/**
+ * The C type of the member a field is stored into.
+ */
+typedef enum {
+    FIELD_INT,          /* int */
+    FIELD_UINT8,        /* Uint8, from a number in [0, 255] */
+    FIELD_UINT32,       /* Uint32, from a number in [0, 4294967295] */
+    FIELD_FLOAT,        /* float */
+    FIELD_DOUBLE,       /* double */
+    FIELD_BOOL,         /* int, from `true` or `false` */
+    FIELD_STRING,       /* char*, a copy the caller frees */
+    FIELD_OBJECT,       /* a struct described by another schema */
+    FIELD_CUSTOM,       /* anything: the field's `parse` function checks and converts the value */
+} Field_Type;
+
+/**
+ * The description of a member of a struct and of the key it is read from.
+ */
+typedef struct field {
+
+    /* The key of the value in the JSON object */
+    const char* name;
+
+    Field_Type type;
+
+    /* The position of the member in the struct (`offsetof`) */
+    size_t offset;
+
+    /* A required field that is missing is an error; otherwise it gets its default value */
+    int required;
+
+    /* The default value of numeric and boolean fields */
+    double number;
+
+    /* The default value of string fields (copied), `NULL` for none */
+    const char* string;
+
+    /* The schema of a `FIELD_OBJECT` field. A missing object gets the default values of this schema */
+    struct schema* schema;
+
+    /* The function that converts a `FIELD_CUSTOM` value into the member. It returns `0` on success, `-1` if the value is invalid */
+    int (*parse)(const cJSON* item, void* member);
+} Field;
+
+/**
+ * A table of fields and the hash index of their names. The index is built the first time the schema is used,
+ * so schemas are declared once, with `SCHEMA`, and shared by every call.
+ */
+typedef struct schema {
+
+    const Field* fields;
+    size_t count;
+
+    /* Set once the index below is built */
+    SDL_atomic_t ready;
+    SDL_SpinLock lock;
+
+    /* The hashes of the names and `1 +` the index of the field in each slot; `0` marks an empty slot */
+    Uint32 hashes[SCHEMA_SLOTS];
+    Uint8 slots[SCHEMA_SLOTS];
+} Schema;
+
+/**
+ * What went wrong with a field.
+ */
+typedef enum {
+    FIELD_MISSING,      /* a required field is not in the object */
+    FIELD_MISMATCH,     /* the value does not have the type of the field */
+    FIELD_INVALID,      /* the value is out of range, or could not be converted */
+} Field_Error;
+
+/**
+ * The errors found by `JSON_deserialize`, in the order of the fields.
+ */
+typedef struct schema_report {
+
+    /* The number of errors, including the ones that did not fit into `errors` */
+    size_t count;
+
+    struct {
+        const char* name;
+        Field_Error error;
+    } errors[SCHEMA_REPORT_SIZE];
+} Schema_Report;
+
+/* ================================================================ */
+
+/**
+ * The `FIELD` macro describes a required field, `FIELD_DEFAULT` an optional numeric or boolean field,
+ * `FIELD_STRING_DEFAULT` an optional string field, `FIELD_NESTED` a nested object and `FIELD_PARSED` a value converted by a function.
+ */
+#define FIELD(struct_type, member, key, field_type) \
+    {(key), (field_type), offsetof(struct_type, member), 1, 0, NULL, NULL, NULL}
+
+#define FIELD_DEFAULT(struct_type, member, key, field_type, default_value) \
+    {(key), (field_type), offsetof(struct_type, member), 0, (default_value), NULL, NULL, NULL}
+
+#define FIELD_STRING_DEFAULT(struct_type, member, key, default_value) \
+    {(key), FIELD_STRING, offsetof(struct_type, member), 0, 0, (default_value), NULL, NULL}
+
+#define FIELD_NESTED(struct_type, member, key, is_required, nested_schema) \
+    {(key), FIELD_OBJECT, offsetof(struct_type, member), (is_required), 0, NULL, (nested_schema), NULL}
+
+#define FIELD_PARSED(struct_type, member, key, is_required, function) \
+    {(key), FIELD_CUSTOM, offsetof(struct_type, member), (is_required), 0, NULL, NULL, (function)}
+
+/**
+ * The `SCHEMA` macro initializes a schema from an array of fields.
+ */
+#define SCHEMA(field_array) \
+    {(field_array), sizeof(field_array) / sizeof((field_array)[0]), {0}, 0, {0}, {0}}
+
+/* ================================================================ */
+
+/**
+ * The `JSON_deserialize` function fills a struct from a JSON object in a single pass over the children of the object:
+ * each key is hashed once and looked up in the index of the schema, so the cost grows with the size of the object, not with the number of fields times the size of the object.
+ * Keys the schema does not describe are ignored; when a key appears twice, the first value is used. Every field that is missing
+ * or has an invalid value gets its default value, and all the errors are reported together rather than stopping at the first one.
+ *
+ * @param object A pointer to the JSON object to read.
+ * @param schema A pointer to the description of the struct.
+ * @param destination A pointer to the struct to fill.
+ * @param report A pointer to a report that receives the errors, or `NULL`. The errors are printed as well, unless `LOG_LEVEL` silences them.
+ *
+ * @return `0` on success. `-1` if `object` is not an object, the schema is invalid or any field has an error.
+ */
+extern int JSON_deserialize(const cJSON* object, Schema* schema, void* destination, Schema_Report* report);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_deserialize_defaults` function fills a struct with the default values of a schema, as if the object were empty and no field were required.
+ *
+ * @param schema A pointer to the description of the struct.
+ * @param destination A pointer to the struct to fill.
+ *
+ * @return `0` on success. `-1` if a default string cannot be copied.
+ */
+extern int JSON_deserialize_defaults(const Schema* schema, void* destination);
+
+/* ================================================================ */
+
+#endif /* SANCHO_PANZA_SCHEMA_H */
@@ -0,0 +1,150 @@
+#ifndef SANCHO_PANZA_SNAPSHOT_H
+#define SANCHO_PANZA_SNAPSHOT_H
+
+#include "../../sancho-panza.h"
+
+/* ================================================================ */
+
+/* The first bytes of a snapshot file and the version of its layout */
+#define SNAPSHOT_MAGIC "SPSN"
+#define SNAPSHOT_VERSION 1
+
+/* The alignment of every payload in the file, so arrays can be used where they are mapped */
+#define SNAPSHOT_ALIGNMENT 16
+
+/* Builds the tag of a section from four characters */
+#define SNAPSHOT_TAG(a, b, c, d) ((Uint32) (a) | ((Uint32) (b) << 8) | ((Uint32) (c) << 16) | ((Uint32) (d) << 24))
+
+/* The tags of the sections written by `Grid_add_to_snapshot` */
+#define SNAPSHOT_TAG_GRID SNAPSHOT_TAG('G', 'R', 'I', 'D')
+#define SNAPSHOT_TAG_CELLS SNAPSHOT_TAG('C', 'E', 'L', 'L')
+
+/* A section flag: the payload has a CRC-32, checked by `Snapshot_open` when asked to */
+#define SNAPSHOT_CHECKSUM 0x1
+
+/**
+ * The layout of a snapshot file. Every number is little-endian:
+ *
+ *     header:  "SPSN", Uint16 version, Uint16 reserved, Uint32 section count, Uint32 CRC-32 of the section table, Uint64 file size
+ *     section: Uint32 tag, Uint32 id, Uint32 flags, Uint32 CRC-32 of the payload (0 without `SNAPSHOT_CHECKSUM`), Uint64 offset, Uint64 size
+ *
+ * The section table follows the header, and every payload starts at an offset aligned to `SNAPSHOT_ALIGNMENT`.
+ * A section is found by its tag and an id chosen by the writer, so a file can hold several grids.
+ */
+
+/* ================================================================ */
+
+typedef struct snapshot_writer Snapshot_Writer;
+
+/**
+ * An open snapshot file. The payloads point into the mapped file and stay valid until `Snapshot_close`.
+ */
+typedef struct snapshot {
+
+    Mapped_File file;
+
+    /* The section table, where it is in the file */
+    const Uint8* sections;
+    Uint32 count;
+} Snapshot;
+
+/* ================================================================ */
+
+/**
+ * The `Snapshot_Writer_new` function creates an empty snapshot that sections are added to before it is saved.
+ * After you are finished using the writer, release it with `Snapshot_Writer_destroy`.
+ *
+ * @return A pointer to the new writer, or `NULL` if memory allocation fails.
+ */
+extern Snapshot_Writer* Snapshot_Writer_new(void);
+
+/* ================================================================ */
+
+/**
+ * The `Snapshot_Writer_destroy` function releases a writer and sets the pointer to `NULL`.
+ *
+ * @return None.
+ */
+extern void Snapshot_Writer_destroy(Snapshot_Writer** writer);
+
+/* ================================================================ */
+
+/**
+ * The `Snapshot_add` function copies a payload into a new section. The bytes are stored as they are,
+ * so the payload must already be little-endian (see `Snapshot_add_Uint32`).
+ *
+ * @param writer A pointer to the writer.
+ * @param tag The tag of the section, for example built with `SNAPSHOT_TAG`.
+ * @param id A number that tells sections with the same tag apart.
+ * @param data A pointer to the payload. It may be `NULL` if `size` is `0`.
+ * @param size The size of the payload, in bytes.
+ * @param flags `SNAPSHOT_CHECKSUM` to store a CRC-32 of the payload, or `0`.
+ *
+ * @return `0` on success. `-1` if an argument is invalid, the writer already has a section with this tag and id, or memory allocation fails.
+ */
+extern int Snapshot_add(Snapshot_Writer* writer, Uint32 tag, Uint32 id, const void* data, size_t size, Uint32 flags);
+
+/* ================================================================ */
+
+/**
+ * The `Snapshot_add_Uint32` function works like `Snapshot_add` for an array of `Uint32`, which is converted to little-endian if needed.
+ *
+ * @return `0` on success. `-1` on failure.
+ */
+extern int Snapshot_add_Uint32(Snapshot_Writer* writer, Uint32 tag, Uint32 id, const Uint32* values, size_t count, Uint32 flags);
+
+/* ================================================================ */
+
+/**
+ * The `Snapshot_save` function lays the snapshot out and hands it to the saver (see `Save_buffer_async`), which writes it into the file
+ * on its thread and replaces the file atomically. The header and the section table are laid out in front of the payloads, in the buffer of the writer,
+ * which is handed to the saver without being copied: the writer is empty after the call, and can be destroyed or filled again right away.
+ * If the call fails before the buffer is handed over, the writer is left unchanged.
+ *
+ * @param writer A pointer to the writer.
+ * @param name A null-terminated string that specifies the file.
+ * @param handle A pointer that receives a handle to poll or wait for the save with, or `NULL`.
+ *
+ * @return `0` if the save has been queued (or written). `-1` on failure.
+ */
+extern int Snapshot_save(Snapshot_Writer* writer, const char* name, Save_Handle** handle);
+
+/* ================================================================ */
+
+/**
+ * The `Snapshot_open` function maps a snapshot file and checks its header and section table.
+ *
+ * @param name A null-terminated string that specifies the file.
+ * @param snapshot A pointer to the structure that receives the snapshot. It must be released with `Snapshot_close`.
+ * @param verify If non-zero, the CRC-32 of every payload that has one is checked as well, which reads the whole file.
+ *
+ * @return `0` on success. `-1` if the file cannot be read, is not a snapshot, has another version or is damaged.
+ */
+extern int Snapshot_open(const char* name, Snapshot* snapshot, int verify);
+
+/* ================================================================ */
+
+/**
+ * The `Snapshot_close` function unmaps a snapshot file. The payloads returned by `Snapshot_find` cannot be used anymore.
+ *
+ * @return None.
+ */
+extern void Snapshot_close(Snapshot* snapshot);
+
+/* ================================================================ */
+
+/**
+ * The `Snapshot_find` function finds the payload of a section, without copying it.
+ *
+ * @param snapshot A pointer to an open snapshot.
+ * @param tag The tag of the section.
+ * @param id The id of the section.
+ * @param size A pointer that receives the size of the payload, in bytes, or `NULL`.
+ *
+ * @return A pointer to the payload, aligned to `SNAPSHOT_ALIGNMENT`, or `NULL` if there is no such section.
+ */
+extern const void* Snapshot_find(const Snapshot* snapshot, Uint32 tag, Uint32 id, size_t* size);
+
+/* ================================================================ */
+
+#endif /* SANCHO_PANZA_SNAPSHOT_H */
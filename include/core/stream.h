@@ -0,0 +1,133 @@
+#ifndef SANCHO_PANZA_STREAM_H
+#define SANCHO_PANZA_STREAM_H
+
+#include "../../sancho-panza.h"
+
+/* ================================================================ */
+
+/* The deepest nesting of arrays and objects a stream accepts, like `CJSON_NESTING_LIMIT` */
+#define JSON_STREAM_MAX_DEPTH 1000
+
+/* The longest key or string a stream accepts, in bytes once unescaped. Numbers are far shorter */
+#define JSON_STREAM_TOKEN_SIZE 4096
+
+/* A flag of `JSON_Stream_init`: the input is a sequence of values separated by whitespace (as in JSON Lines), not a single value */
+#define JSON_STREAM_SEQUENCE 0x1
+
+/* ================================================================ */
+
+/**
+ * The functions a stream calls for what it reads, in the order of the document. Any of them can be `NULL`.
+ * A function returns `0` to go on, anything else to stop the stream (`JSON_Stream_feed` then fails with `ECANCELED`).
+ * The strings passed to `key` and `string` are unescaped and null-terminated, and only valid during the call.
+ */
+typedef struct json_stream_callbacks {
+
+    int (*begin_object)(void* user);
+    int (*end_object)(void* user);
+
+    int (*begin_array)(void* user);
+    int (*end_array)(void* user);
+
+    int (*key)(void* user, const char* key, size_t length);
+
+    int (*string)(void* user, const char* string, size_t length);
+    int (*number)(void* user, double number);
+    int (*boolean)(void* user, int value);
+    int (*null)(void* user);
+} JSON_Stream_Callbacks;
+
+/**
+ * The state of a streaming parse. Its size is fixed, whatever the size of the input, and it allocates nothing:
+ * it can live on the stack. The members are private, except `offset`.
+ */
+typedef struct json_stream {
+
+    const JSON_Stream_Callbacks* callbacks;
+    void* user;
+    int flags;
+
+    /* The number of bytes read so far; after an error, the position of the byte that caused it */
+    size_t offset;
+
+    int state;
+
+    /* One bit per open container, set for objects */
+    size_t depth;
+    Uint8 containers[(JSON_STREAM_MAX_DEPTH + 7) / 8];
+
+    /* The key, string, number or literal being read, which may span several chunks */
+    char token[JSON_STREAM_TOKEN_SIZE];
+    size_t length;
+
+    /* Within a string: a pending high surrogate, the `\u` escape being read and the bytes of a UTF-8 sequence still expected */
+    Uint32 surrogate;
+    Uint32 code;
+    int hex_digits;
+    int utf8_remaining;
+    Uint8 utf8_low;
+    Uint8 utf8_high;
+
+    /* Within `true`, `false` or `null`: the literal and the number of its characters read */
+    const char* literal;
+    size_t literal_length;
+} JSON_Stream;
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Stream_init` function prepares a stream to parse a document fed to it in chunks.
+ *
+ * @param stream A pointer to the stream.
+ * @param callbacks A pointer to the functions to call. It must stay valid while the stream is used.
+ * @param user A pointer passed to every callback.
+ * @param flags `JSON_STREAM_SEQUENCE` to read several values one after the other, or `0`.
+ *
+ * @return None.
+ */
+extern void JSON_Stream_init(JSON_Stream* stream, const JSON_Stream_Callbacks* callbacks, void* user, int flags);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Stream_feed` function parses the next chunk of the input and calls the callbacks for everything it completes.
+ * A chunk can end anywhere, even in the middle of a string or of a number: the stream keeps what it needs of it.
+ *
+ * @param stream A pointer to the stream.
+ * @param data A pointer to the chunk. It is not kept after the call.
+ * @param size The size of the chunk, in bytes.
+ *
+ * @return `0` on success. `-1` if the input is not valid JSON (`EILSEQ`), nests too deeply or has a string too long (`EOVERFLOW`),
+ * or a callback stopped the stream (`ECANCELED`). After an error, the stream fails until it is initialized again.
+ */
+extern int JSON_Stream_feed(JSON_Stream* stream, const void* data, size_t size);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Stream_finish` function tells the stream that the input is over, which completes a number at the very end of it.
+ *
+ * @param stream A pointer to the stream.
+ *
+ * @return `0` if the input was a complete document (or a sequence of complete values). `-1` if it stopped in the middle of one, or after an error.
+ */
+extern int JSON_Stream_finish(JSON_Stream* stream);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Stream_file` function streams a whole file, or anything else that can be opened and read (a pipe, a character device),
+ * through the callbacks, reading it in small chunks so the memory used does not depend on the size of the file.
+ *
+ * @param name A null-terminated string that specifies the file.
+ * @param callbacks A pointer to the functions to call.
+ * @param user A pointer passed to every callback.
+ * @param flags `JSON_STREAM_SEQUENCE` or `0`, as for `JSON_Stream_init`.
+ *
+ * @return `0` on success. `-1` if the file cannot be read, or on any error of `JSON_Stream_feed` and `JSON_Stream_finish`.
+ */
+extern int JSON_Stream_file(const char* name, const JSON_Stream_Callbacks* callbacks, void* user, int flags);
+
+/* ================================================================ */
+
+#endif /* SANCHO_PANZA_STREAM_H */
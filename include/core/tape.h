@@ -0,0 +1,196 @@
+#ifndef SANCHO_PANZA_TAPE_H
+#define SANCHO_PANZA_TAPE_H
+
+#include "../../sancho-panza.h"
+
+/* ================================================================ */
+
+/**
+ * A document parsed into a tape: a flat array of 64-bit words, one or two per value, in the order of the text.
+ * An array or object word holds the index of the word after its end and the number of its elements,
+ * so a value is skipped in O(1) and nothing is linked with pointers. Strings are kept as positions in the input
+ * and only decoded (and checked) the first time `JSON_Tape_get_string_value` asks for them; numbers are converted during the parse.
+ *
+ * The tape is read-only, and the input must stay valid and unchanged while it is used.
+ */
+typedef struct json_tape JSON_Tape;
+
+/**
+ * A value of a tape: which tape, and where on it. Values are small and passed by copy.
+ * A missing value (for example the result of looking up a key that does not exist) has the index `0`.
+ */
+typedef struct json_value {
+
+    JSON_Tape* tape;
+    size_t index;
+} JSON_Value;
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Tape_parse` function parses a document into a new tape, without copying it: the tape points into `data`.
+ * After you are finished using the tape, release it with `JSON_Tape_destroy`.
+ *
+ * @param data A pointer to the text. It does not have to be null-terminated, and must outlive the tape.
+ * @param size The size of the text, in bytes.
+ * @param tape A pointer that receives the new tape.
+ *
+ * @return `0` on success. `-1` if the text is not valid JSON, nests deeper than `CJSON_NESTING_LIMIT`, or memory allocation fails.
+ */
+extern int JSON_Tape_parse(const char* data, size_t size, JSON_Tape** tape);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Tape_parse_file` function maps a file (see `map_file`) and parses it into a new tape, which keeps the mapping until it is destroyed.
+ *
+ * @param name A null-terminated string that specifies the file.
+ * @param tape A pointer that receives the new tape.
+ *
+ * @return `0` on success. `-1` if the file cannot be read, or on any error of `JSON_Tape_parse`.
+ */
+extern int JSON_Tape_parse_file(const char* name, JSON_Tape** tape);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Tape_destroy` function releases a tape, the strings decoded from it and its file, and sets the pointer to `NULL`.
+ * The values of the tape and the strings returned by `JSON_Tape_get_string_value` cannot be used anymore.
+ *
+ * @return None.
+ */
+extern void JSON_Tape_destroy(JSON_Tape** tape);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Tape_root` function returns the top-level value of a tape.
+ */
+extern JSON_Value JSON_Tape_root(JSON_Tape* tape);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Tape_exists` function checks that a value is not missing.
+ *
+ * @return `1` if the value is on a tape, `0` otherwise.
+ */
+extern int JSON_Tape_exists(JSON_Value value);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Tape_is` function checks the type of a value, like the `cJSON_Is` functions do.
+ *
+ * @param value The value.
+ * @param type `ARRAY`, `BOOLEAN`, `OBJECT`, `NUMBER` or `STRING`.
+ *
+ * @return `1` if the value exists and has this type, `0` otherwise.
+ */
+extern int JSON_Tape_is(JSON_Value value, JSON_Entity type);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Tape_is_null` and `JSON_Tape_is_true` functions check for `null` and for `true`.
+ *
+ * @return `1` or `0`.
+ */
+extern int JSON_Tape_is_null(JSON_Value value);
+extern int JSON_Tape_is_true(JSON_Value value);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Tape_get_object_item` function finds a member of an object by its key, ignoring case like `cJSON_GetObjectItem`;
+ * `JSON_Tape_get_object_item_case_sensitive` matches the case as well. Keys are compared where they are in the input, without decoding them
+ * unless they contain escape sequences.
+ *
+ * @param object The object.
+ * @param key A null-terminated string that specifies the key.
+ *
+ * @return The first member with this key, or a missing value if there is none or `object` is not an object.
+ */
+extern JSON_Value JSON_Tape_get_object_item(JSON_Value object, const char* key);
+extern JSON_Value JSON_Tape_get_object_item_case_sensitive(JSON_Value object, const char* key);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Tape_get_array_size` function returns the number of elements of an array or of members of an object, without walking them.
+ *
+ * @return The number of elements, or `0` if the value is neither an array nor an object.
+ */
+extern int JSON_Tape_get_array_size(JSON_Value array);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Tape_get_array_item` function returns an element of an array (or the value of a member of an object) by its position,
+ * skipping the elements before it without looking into them.
+ *
+ * @return The element, or a missing value if `index` is out of range.
+ */
+extern JSON_Value JSON_Tape_get_array_item(JSON_Value array, int index);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Tape_child` and `JSON_Tape_next` functions walk the elements of an array or the members of an object, in order:
+ *
+ *     for (JSON_Value item = JSON_Tape_child(array); JSON_Tape_exists(item); item = JSON_Tape_next(item)) { ... }
+ *
+ * For an object, the values are the values of the members; `JSON_Tape_get_key` gives their keys.
+ *
+ * @return The first (or next) element, or a missing value at the end.
+ */
+extern JSON_Value JSON_Tape_child(JSON_Value container);
+extern JSON_Value JSON_Tape_next(JSON_Value item);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Tape_get_key` function returns the decoded key of a member of an object, as `JSON_Tape_get_string_value` would.
+ *
+ * @return A null-terminated string owned by the tape, or `NULL` if the value is not a member of an object.
+ */
+extern const char* JSON_Tape_get_key(JSON_Value member);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Tape_get_number_value` function returns the value of a number.
+ *
+ * @return The number, or `NAN` if the value is not a number, like `cJSON_GetNumberValue`.
+ */
+extern double JSON_Tape_get_number_value(JSON_Value value);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Tape_get_string_value` function decodes a string the first time it is asked for, and returns the same copy afterwards.
+ * It can be called from several threads at once.
+ *
+ * @return A null-terminated string owned by the tape, valid until it is destroyed, or `NULL` if the value is not a string
+ * or its contents are invalid (a bad escape sequence, a control character or invalid UTF-8).
+ */
+extern const char* JSON_Tape_get_string_value(JSON_Value value);
+
+/* ================================================================ */
+
+/**
+ * The `JSON_Tape_extract` function finds a member of an object by its key (with its case) and checks its type, like `extract_JSON_data` does for `cJSON`.
+ * The function prints the same error messages.
+ *
+ * @param object The object.
+ * @param name A null-terminated string that specifies the key.
+ * @param type The expected type (`ARRAY`, `BOOLEAN`, `OBJECT`, `NUMBER` or `STRING`).
+ * @param data A pointer that receives the value, or a missing value if it has another type.
+ *
+ * @return `0` on success. `-1` if the type is unsupported, `object` is missing, there is no such member, or it has another type.
+ */
+extern int JSON_Tape_extract(JSON_Value object, const char* name, JSON_Entity type, JSON_Value* data);
+
+/* ================================================================ */
+
+#endif /* SANCHO_PANZA_TAPE_H */
@@ -1,8 +1,6 @@
 #ifndef SANCHO_PANZA_H
 #define SANCHO_PANZA_H
 
-#define STRICT
-
 /* ================================================================ */
 
 #include <SDL2/SDL.h>
@@ -10,6 +8,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdarg.h>
+#include <limits.h>
 #include <errno.h>
 #include <execinfo.h>
 
@@ -17,9 +17,22 @@
 
 #include "include/core/cJSON.h"
 #include "include/core/core.h"
+#include "include/core/log.h"
+#include "include/core/binlog.h"
+#include "include/core/jobs.h"
+#include "include/core/pool.h"
+#include "include/core/save.h"
+#include "include/core/schema.h"
+#include "include/core/snapshot.h"
+#include "include/core/stream.h"
+#include "include/core/tape.h"
+#include "include/core/path.h"
+#include "include/core/patch.h"
 #include "include/Timer/Timer.h"
+#include "include/core/arena.h"
 #include "include/Window/Window.h"
 #include "include/Grid/Grid.h"
+#include "include/ECS/ECS.h"
 #include "include/InputManager/Manager.h"
 #include "include/Application/Application.h"
 
@@ -1,5 +1,8 @@
 #include "../../sancho-panza.h"
 
+/* Applications are taken from a pool, like the windows and timers they own */
+static Pool application_pool = POOL_INITIALIZER("Application", App);
+
 /* ================================================================ */
 
 App* Application_new(void) {
@@ -8,16 +11,24 @@ App* Application_new(void) {
 
     /* ================ */
 
-    if ((app = calloc(1, sizeof(struct application))) == NULL) {
+    if ((app = Pool_new_object(&application_pool, App)) == NULL) {
 
-        #ifdef STRICT
-            error(stderr, "in %s%s%s (%s%s%s)\n", BLUE, __func__, WHITE, RED, strerror(errno), WHITE);
-        #endif
+        error(stderr, "in %s%s%s (%s%s%s)\n", BLUE, __func__, WHITE, RED, strerror(errno), WHITE);
 
         /* ======== */
         return NULL;
     }
 
+    /* The frame arena is bound to the timer once `SP_init` has created it */
+    if ((app->frame = Frame_Arena_new(0, NULL)) == NULL) {
+        Pool_free(&application_pool, app);
+
+        return NULL;
+    }
+
+    /* The library builds its own temporary data in the frame arena of the application */
+    Frame_Arena_set_current(app->frame);
+
     /* Initialize the Input Manager */
     memset(app->imanager.key_states, 0, sizeof(app->imanager.key_states));
     memset(app->imanager.previous_key_states, 0, sizeof(app->imanager.previous_key_states));
@@ -38,15 +49,15 @@ int Application_destroy(App** app) {
         return -1;
     }
 
+    App_clear_systems(*app);
     Window_destroy(&(*app)->window);
     Timer_destroy(&(*app)->timer);
-    free(*app);
+    Frame_Arena_destroy(&(*app)->frame);
+    Pool_free(&application_pool, *app);
 
     *app = NULL;
 
-    #ifdef STRICT
-        success(stdout, "application has been destroyed\n", "");
-    #endif
+    success(stdout, "application has been destroyed\n", "");
 
     /* ======== */
     
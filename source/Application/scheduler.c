@@ -0,0 +1,458 @@
+#include "../../sancho-panza.h"
+
+#include <stdatomic.h>
+
+/* The weight of the last frame in the moving average of a system's timing */
+#define TIMING_SMOOTHING 0.1
+
+/* ================================================================ */
+
+struct app_system {
+
+    char name[APP_NAME_LENGTH];
+
+    App_System_Function function;
+    void* data;
+
+    Uint64 reads;
+    Uint64 writes;
+
+    /* Indices of the systems that cannot start before this one finishes */
+    int* dependents;
+    int dependents_count;
+
+    /* The number of systems this one waits for */
+    int dependencies;
+    /* The number of those that have not finished yet in the current frame */
+    atomic_int remaining;
+
+    App_System_Timing timing;
+
+    /* The scheduler the system belongs to */
+    App_Scheduler* scheduler;
+};
+
+/* ================================================================ */
+
+struct app_scheduler {
+
+    struct app_system* systems;
+    int count;
+    int capacity;
+
+    char resources[APP_MAX_RESOURCES][APP_NAME_LENGTH];
+    int resources_count;
+
+    /* The dependency graph has to be rebuilt before the next frame */
+    int dirty;
+
+    /* The job all systems of the current frame are attached to */
+    Job* frame;
+
+    App* app;
+};
+
+/* ================================================================ */
+/* ================== Static, internal functions ================== */
+/* ================================================================ */
+
+static App_Scheduler* get_scheduler(App* app) {
+
+    if (app->scheduler == NULL) {
+
+        if ((app->scheduler = calloc(1, sizeof(struct app_scheduler))) == NULL) {
+
+            error(stderr, "in %s%s%s (%s%s%s)\n", BLUE, __func__, WHITE, RED, strerror(errno), WHITE);
+
+            return NULL;
+        }
+
+        app->scheduler->app = app;
+    }
+
+    /* ======== */
+
+    return app->scheduler;
+}
+
+/* ================================================================ */
+
+static int find_system(const App_Scheduler* scheduler, const char* name) {
+
+    if ((scheduler == NULL) || (name == NULL)) {
+        return -1;
+    }
+
+    for (int i = 0; i < scheduler->count; i++) {
+
+        if (strcmp(scheduler->systems[i].name, name) == 0) {
+            return i;
+        }
+    }
+
+    /* ======== */
+
+    return -1;
+}
+
+/* ================================================================ */
+
+/**
+ * Two systems conflict if one of them writes a resource the other one reads or writes.
+ */
+static int systems_conflict(const struct app_system* a, const struct app_system* b) {
+    return ((a->writes & (b->reads | b->writes)) != 0) || ((a->reads & b->writes) != 0);
+}
+
+/* ================================================================ */
+
+/**
+ * The `build_graph` function connects every system to the earlier systems it conflicts with.
+ * Edges always point from an earlier system to a later one, so the graph has no cycles and the registration order is a valid execution order.
+ */
+static int build_graph(App_Scheduler* scheduler) {
+
+    for (int i = 0; i < scheduler->count; i++) {
+
+        free(scheduler->systems[i].dependents);
+
+        scheduler->systems[i].dependents = NULL;
+        scheduler->systems[i].dependents_count = 0;
+        scheduler->systems[i].dependencies = 0;
+    }
+
+    for (int i = 0; i < scheduler->count; i++) {
+
+        struct app_system* system = &scheduler->systems[i];
+
+        /* At most every later system depends on this one */
+        if ((i < scheduler->count - 1) && ((system->dependents = malloc((scheduler->count - i - 1) * sizeof(int))) == NULL)) {
+
+            error(stderr, "in %s%s%s (%s%s%s)\n", BLUE, __func__, WHITE, RED, strerror(errno), WHITE);
+
+            return -1;
+        }
+
+        for (int j = i + 1; j < scheduler->count; j++) {
+
+            if (systems_conflict(system, &scheduler->systems[j])) {
+
+                system->dependents[system->dependents_count++] = j;
+                scheduler->systems[j].dependencies++;
+            }
+        }
+    }
+
+    scheduler->dirty = 0;
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+static void execute_system(struct app_system* system) {
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    double elapsed;
+
+    /* ================ */
+
+    system->function(system->scheduler->app, system->data);
+
+    elapsed = (double) (SDL_GetPerformanceCounter() - start) / (double) SDL_GetPerformanceFrequency();
+
+    system->timing.last = elapsed;
+    system->timing.average = (system->timing.average == 0) ? elapsed : system->timing.average + TIMING_SMOOTHING * (elapsed - system->timing.average);
+    system->timing.max = (elapsed > system->timing.max) ? elapsed : system->timing.max;
+}
+
+/* ================================================================ */
+
+static void system_job(Job* job, void* data);
+
+/**
+ * The `schedule_system` function submits a system as a child of the frame job, so waiting for the frame waits for the system too.
+ * If no job can be created, the system runs immediately on the calling thread.
+ */
+static void schedule_system(struct app_system* system) {
+
+    Job* job;
+
+    /* ================ */
+
+    if ((job = Job_new(system_job, system, system->scheduler->frame)) == NULL) {
+        system_job(NULL, system);
+
+        return ;
+    }
+
+    Job_run(job);
+}
+
+/* ================================================================ */
+
+static void system_job(Job* job, void* data) {
+
+    struct app_system* system = data;
+    App_Scheduler* scheduler = system->scheduler;
+
+    (void) job;
+
+    /* ================ */
+
+    execute_system(system);
+
+    /* Release the systems that were waiting for this one. The last dependency to finish schedules the system */
+    for (int i = 0; i < system->dependents_count; i++) {
+
+        struct app_system* dependent = &scheduler->systems[system->dependents[i]];
+
+        if (atomic_fetch_sub(&dependent->remaining, 1) == 1) {
+            schedule_system(dependent);
+        }
+    }
+}
+
+/* ================================================================ */
+
+static void frame_job(Job* job, void* data) {
+
+    App_Scheduler* scheduler = data;
+
+    (void) job;
+
+    /* ================ */
+
+    for (int i = 0; i < scheduler->count; i++) {
+
+        if (scheduler->systems[i].dependencies == 0) {
+            schedule_system(&scheduler->systems[i]);
+        }
+    }
+}
+
+/* ================================================================ */
+/* ============== Definitions of external functions =============== */
+/* ================================================================ */
+
+Uint64 App_resource(App* app, const char* name) {
+
+    App_Scheduler* scheduler;
+
+    /* ================ */
+
+    if ((app == NULL) || (name == NULL) || ((scheduler = get_scheduler(app)) == NULL)) {
+        return 0;
+    }
+
+    if (strlen(name) >= APP_NAME_LENGTH) {
+
+        error(stderr, "the name of a resource is too long [%s%s%s]\n", PURPLE, name, WHITE);
+
+        return 0;
+    }
+
+    for (int i = 0; i < scheduler->resources_count; i++) {
+
+        if (strcmp(scheduler->resources[i], name) == 0) {
+            return (Uint64) 1 << i;
+        }
+    }
+
+    if (scheduler->resources_count == APP_MAX_RESOURCES) {
+
+        error(stderr, "too many resources, unable to register [%s%s%s]\n", PURPLE, name, WHITE);
+
+        return 0;
+    }
+
+    strcpy(scheduler->resources[scheduler->resources_count], name);
+
+    /* ======== */
+
+    return (Uint64) 1 << scheduler->resources_count++;
+}
+
+/* ================================================================ */
+
+int App_add_system(App* app, const char* name, App_System_Function function, void* data, Uint64 reads, Uint64 writes) {
+
+    App_Scheduler* scheduler;
+    struct app_system* system;
+
+    /* ================ */
+
+    if ((app == NULL) || (name == NULL) || (function == NULL)) {
+        return -1;
+    }
+
+    if ((scheduler = get_scheduler(app)) == NULL) {
+        return -1;
+    }
+
+    if (strlen(name) >= APP_NAME_LENGTH) {
+
+        error(stderr, "the name of a system is too long [%s%s%s]\n", PURPLE, name, WHITE);
+
+        return -1;
+    }
+
+    if (find_system(scheduler, name) != -1) {
+
+        error(stderr, "a system with this name already exists [%s%s%s]\n", PURPLE, name, WHITE);
+
+        return -1;
+    }
+
+    /* ================================================ */
+    /* ========= Growing the array of systems ========= */
+    /* ================================================ */
+
+    if (scheduler->count == scheduler->capacity) {
+
+        int capacity = (scheduler->capacity == 0) ? 8 : scheduler->capacity * 2;
+        struct app_system* systems;
+
+        if ((systems = realloc(scheduler->systems, capacity * sizeof(struct app_system))) == NULL) {
+
+            error(stderr, "in %s%s%s (%s%s%s)\n", BLUE, __func__, WHITE, RED, strerror(errno), WHITE);
+
+            return -1;
+        }
+
+        scheduler->systems = systems;
+        scheduler->capacity = capacity;
+    }
+
+    system = &scheduler->systems[scheduler->count++];
+    memset(system, 0, sizeof(struct app_system));
+
+    strcpy(system->name, name);
+
+    system->function = function;
+    system->data = data;
+    system->reads = reads;
+    system->writes = writes;
+    system->scheduler = scheduler;
+
+    scheduler->dirty = 1;
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+int App_remove_system(App* app, const char* name) {
+
+    int index;
+
+    /* ================ */
+
+    if ((app == NULL) || ((index = find_system(app->scheduler, name)) == -1)) {
+        return -1;
+    }
+
+    free(app->scheduler->systems[index].dependents);
+
+    memmove(&app->scheduler->systems[index], &app->scheduler->systems[index + 1], (app->scheduler->count - index - 1) * sizeof(struct app_system));
+
+    app->scheduler->count--;
+    app->scheduler->dirty = 1;
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+void App_clear_systems(App* app) {
+
+    if ((app == NULL) || (app->scheduler == NULL)) {
+        return ;
+    }
+
+    for (int i = 0; i < app->scheduler->count; i++) {
+        free(app->scheduler->systems[i].dependents);
+    }
+
+    free(app->scheduler->systems);
+    free(app->scheduler);
+
+    app->scheduler = NULL;
+}
+
+/* ================================================================ */
+
+int App_run_systems(App* app) {
+
+    App_Scheduler* scheduler;
+
+    /* ================ */
+
+    if (app == NULL) {
+        return -1;
+    }
+
+    if (((scheduler = app->scheduler) == NULL) || (scheduler->count == 0)) {
+        return 0;
+    }
+
+    if (scheduler->dirty && (build_graph(scheduler) != 0)) {
+        return -1;
+    }
+
+    for (int i = 0; i < scheduler->count; i++) {
+        atomic_store(&scheduler->systems[i].remaining, scheduler->systems[i].dependencies);
+    }
+
+    /* ================================================ */
+    /* ======= Without the job system, run every ====== */
+    /* ====== system in the order they were added ===== */
+    /* ================================================ */
+
+    if ((scheduler->frame = Job_new(frame_job, scheduler, NULL)) == NULL) {
+
+        for (int i = 0; i < scheduler->count; i++) {
+            execute_system(&scheduler->systems[i]);
+        }
+
+        return 0;
+    }
+
+    Job_run(scheduler->frame);
+    Job_wait(scheduler->frame);
+
+    scheduler->frame = NULL;
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+int App_system_timing(const App* app, const char* name, App_System_Timing* timing) {
+
+    int index;
+
+    /* ================ */
+
+    if ((app == NULL) || (timing == NULL) || ((index = find_system(app->scheduler, name)) == -1)) {
+        return -1;
+    }
+
+    *timing = app->scheduler->systems[index].timing;
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+#undef TIMING_SMOOTHING
@@ -0,0 +1,701 @@
+#include "../../sancho-panza.h"
+
+/* The generation of an entity is stored in the upper half of its identifier */
+#define ENTITY_INDEX(entity) ((Uint32) ((entity) & 0xFFFFFFFFu))
+#define ENTITY_GENERATION(entity) ((Uint32) ((entity) >> 32))
+#define ENTITY_MAKE(index, generation) (((Entity) (generation) << 32) | (Entity) (index))
+
+/* Marks the end of the free list of entity records and unknown archetype transitions */
+#define NONE (-1)
+
+/* ================================================================ */
+
+struct ecs_component_info {
+
+    size_t size;
+    size_t alignment;
+};
+
+/* ================================================================ */
+
+struct ecs_archetype {
+
+    /* The components every entity of the table has */
+    Uint64 mask;
+
+    /* One contiguous array per component. `NULL` for components the archetype does not have */
+    void* columns[ECS_MAX_COMPONENTS];
+
+    /* The entity stored in every row */
+    Entity* entities;
+
+    size_t count;
+    size_t capacity;
+
+    /* Archetypes reached by adding or removing a component. `NONE` until the transition is used for the first time */
+    int add_edge[ECS_MAX_COMPONENTS];
+    int remove_edge[ECS_MAX_COMPONENTS];
+
+    const ECS_World* world;
+};
+
+/* ================================================================ */
+
+struct entity_record {
+
+    Uint32 generation;
+
+    /* The archetype and the row the entity is stored in. `NONE` for a destroyed entity */
+    int archetype;
+    size_t row;
+
+    /* The next free record when the entity is destroyed */
+    int next_free;
+};
+
+/* ================================================================ */
+
+struct ecs_world {
+
+    struct ecs_component_info components[ECS_MAX_COMPONENTS];
+    int components_count;
+
+    ECS_Archetype** archetypes;
+    size_t archetypes_count;
+    size_t archetypes_capacity;
+
+    struct entity_record* records;
+    size_t records_count;
+    size_t records_capacity;
+
+    int free_head;
+};
+
+/* ================================================================ */
+
+/* The data shared by all jobs of one `ECS_query_parallel_for` call */
+struct parallel_query {
+
+    ECS_Chunk* chunks;
+
+    ECS_Chunk_Function function;
+    void* data;
+};
+
+/* ================================================================ */
+/* ================== Static, internal functions ================== */
+/* ================================================================ */
+
+static struct entity_record* get_record(const ECS_World* world, Entity entity) {
+
+    Uint32 index = ENTITY_INDEX(entity);
+
+    /* ================ */
+
+    if ((world == NULL) || (index >= world->records_count)) {
+        return NULL;
+    }
+
+    if ((world->records[index].generation != ENTITY_GENERATION(entity)) || (world->records[index].archetype == NONE)) {
+        return NULL;
+    }
+
+    /* ======== */
+
+    return &world->records[index];
+}
+
+/* ================================================================ */
+
+static int find_archetype(ECS_World* world, Uint64 mask) {
+
+    ECS_Archetype* archetype;
+
+    /* ================ */
+
+    for (size_t i = 0; i < world->archetypes_count; i++) {
+
+        if (world->archetypes[i]->mask == mask) {
+            return (int) i;
+        }
+    }
+
+    /* ================================================ */
+    /* ========= Creating a new archetype table ======= */
+    /* ================================================ */
+
+    if (world->archetypes_count == world->archetypes_capacity) {
+
+        size_t capacity = (world->archetypes_capacity == 0) ? 16 : world->archetypes_capacity * 2;
+        ECS_Archetype** archetypes;
+
+        if ((archetypes = realloc(world->archetypes, capacity * sizeof(ECS_Archetype*))) == NULL) {
+            return NONE;
+        }
+
+        world->archetypes = archetypes;
+        world->archetypes_capacity = capacity;
+    }
+
+    if ((archetype = calloc(1, sizeof(struct ecs_archetype))) == NULL) {
+        return NONE;
+    }
+
+    archetype->mask = mask;
+    archetype->world = world;
+
+    for (int i = 0; i < ECS_MAX_COMPONENTS; i++) {
+        archetype->add_edge[i] = NONE;
+        archetype->remove_edge[i] = NONE;
+    }
+
+    world->archetypes[world->archetypes_count] = archetype;
+
+    /* ======== */
+
+    return (int) world->archetypes_count++;
+}
+
+/* ================================================================ */
+
+/**
+ * The `grow_archetype` function doubles the capacity of every column of an archetype table.
+ * Columns are allocated with the alignment of their component, which `realloc` does not preserve.
+ */
+static int grow_archetype(ECS_Archetype* archetype) {
+
+    size_t capacity = (archetype->capacity == 0) ? 64 : archetype->capacity * 2;
+    Entity* entities;
+
+    /* ================ */
+
+    for (int i = 0; i < ECS_MAX_COMPONENTS; i++) {
+
+        const struct ecs_component_info* info = &archetype->world->components[i];
+        size_t alignment;
+        size_t bytes;
+        void* column;
+
+        if (!(archetype->mask & ECS_MASK(i))) {
+            continue ;
+        }
+
+        alignment = (info->alignment < sizeof(void*)) ? sizeof(void*) : info->alignment;
+        /* `aligned_alloc` requires the size to be a multiple of the alignment */
+        bytes = (capacity * info->size + alignment - 1) & ~(alignment - 1);
+
+        if ((column = aligned_alloc(alignment, bytes)) == NULL) {
+            return -1;
+        }
+
+        if (archetype->columns[i] != NULL) {
+            memcpy(column, archetype->columns[i], archetype->count * info->size);
+            free(archetype->columns[i]);
+        }
+
+        archetype->columns[i] = column;
+    }
+
+    if ((entities = realloc(archetype->entities, capacity * sizeof(Entity))) == NULL) {
+        return -1;
+    }
+
+    archetype->entities = entities;
+    archetype->capacity = capacity;
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+/**
+ * The `remove_row` function removes a row from an archetype table by moving the last row into its place.
+ */
+static void remove_row(ECS_World* world, ECS_Archetype* archetype, size_t row) {
+
+    size_t last = archetype->count - 1;
+
+    /* ================ */
+
+    if (row != last) {
+
+        for (int i = 0; i < ECS_MAX_COMPONENTS; i++) {
+
+            size_t size = world->components[i].size;
+
+            if (archetype->columns[i] != NULL) {
+                memcpy((char*) archetype->columns[i] + row * size, (char*) archetype->columns[i] + last * size, size);
+            }
+        }
+
+        archetype->entities[row] = archetype->entities[last];
+        world->records[ENTITY_INDEX(archetype->entities[row])].row = row;
+    }
+
+    archetype->count--;
+}
+
+/* ================================================================ */
+
+/**
+ * The `move_entity` function moves an entity into another archetype table, copying the components both tables have.
+ */
+static int move_entity(ECS_World* world, struct entity_record* record, Entity entity, int target) {
+
+    ECS_Archetype* to = world->archetypes[target];
+    ECS_Archetype* from = (record->archetype == NONE) ? NULL : world->archetypes[record->archetype];
+
+    size_t row;
+
+    /* ================ */
+
+    if ((to->count == to->capacity) && (grow_archetype(to) != 0)) {
+        return -1;
+    }
+
+    row = to->count++;
+    to->entities[row] = entity;
+
+    if (from != NULL) {
+
+        for (int i = 0; i < ECS_MAX_COMPONENTS; i++) {
+
+            size_t size = world->components[i].size;
+
+            if ((from->columns[i] != NULL) && (to->mask & ECS_MASK(i))) {
+                memcpy((char*) to->columns[i] + row * size, (char*) from->columns[i] + record->row * size, size);
+            }
+        }
+
+        remove_row(world, from, record->row);
+    }
+
+    record->archetype = target;
+    record->row = row;
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+static int archetype_matches(const ECS_Archetype* archetype, Uint64 with, Uint64 without) {
+    return ((archetype->mask & with) == with) && ((archetype->mask & without) == 0);
+}
+
+/* ================================================================ */
+
+static void chunk_range(size_t first, size_t last, void* data) {
+
+    struct parallel_query* query = data;
+
+    /* ================ */
+
+    for (size_t i = first; i < last; i++) {
+        query->function(&query->chunks[i], query->data);
+    }
+}
+
+/* ================================================================ */
+/* ============== Definitions of external functions =============== */
+/* ================================================================ */
+
+ECS_World* ECS_World_new(void) {
+
+    ECS_World* world;
+
+    /* ================ */
+
+    if ((world = calloc(1, sizeof(struct ecs_world))) == NULL) {
+
+        error(stderr, "in %s%s%s (%s%s%s)\n", BLUE, __func__, WHITE, RED, strerror(errno), WHITE);
+
+        return NULL;
+    }
+
+    world->free_head = NONE;
+
+    /* The empty archetype holds entities without components */
+    if (find_archetype(world, 0) == NONE) {
+        free(world);
+
+        return NULL;
+    }
+
+    /* ======== */
+
+    return world;
+}
+
+/* ================================================================ */
+
+void ECS_World_destroy(ECS_World** world) {
+
+    if ((world == NULL) || (*world == NULL)) {
+        return ;
+    }
+
+    for (size_t i = 0; i < (*world)->archetypes_count; i++) {
+
+        for (int j = 0; j < ECS_MAX_COMPONENTS; j++) {
+            free((*world)->archetypes[i]->columns[j]);
+        }
+
+        free((*world)->archetypes[i]->entities);
+        free((*world)->archetypes[i]);
+    }
+
+    free((*world)->archetypes);
+    free((*world)->records);
+    free(*world);
+
+    *world = NULL;
+}
+
+/* ================================================================ */
+
+ECS_Component ECS_component_register(ECS_World* world, size_t size, size_t alignment) {
+
+    if ((world == NULL) || (size == 0) || (alignment == 0) || (alignment & (alignment - 1))) {
+        return -1;
+    }
+
+    if (world->components_count == ECS_MAX_COMPONENTS) {
+
+        error(stderr, "too many component types (more than %d) [%s%s%s]\n", ECS_MAX_COMPONENTS, BLUE, __func__, WHITE);
+
+        return -1;
+    }
+
+    world->components[world->components_count].size = size;
+    world->components[world->components_count].alignment = alignment;
+
+    /* ======== */
+
+    return world->components_count++;
+}
+
+/* ================================================================ */
+
+Entity Entity_create(ECS_World* world) {
+
+    struct entity_record* record;
+    int index;
+
+    /* ================ */
+
+    if (world == NULL) {
+        return ENTITY_NONE;
+    }
+
+    /* ================================================ */
+    /* ===== Reusing a destroyed entity's record ====== */
+    /* ========== or appending a new one ============== */
+    /* ================================================ */
+
+    if (world->free_head != NONE) {
+
+        index = world->free_head;
+        world->free_head = world->records[index].next_free;
+    }
+    else {
+
+        if (world->records_count == world->records_capacity) {
+
+            size_t capacity = (world->records_capacity == 0) ? 256 : world->records_capacity * 2;
+            struct entity_record* records;
+
+            if ((capacity > 0xFFFFFFFFu) || ((records = realloc(world->records, capacity * sizeof(struct entity_record))) == NULL)) {
+                return ENTITY_NONE;
+            }
+
+            world->records = records;
+            world->records_capacity = capacity;
+        }
+
+        index = (int) world->records_count++;
+
+        /* Generations start at 1, so no entity has the `ENTITY_NONE` identifier */
+        world->records[index].generation = 1;
+    }
+
+    record = &world->records[index];
+    record->archetype = NONE;
+    record->next_free = NONE;
+
+    if (move_entity(world, record, ENTITY_MAKE(index, record->generation), 0) != 0) {
+
+        record->next_free = world->free_head;
+        world->free_head = index;
+
+        return ENTITY_NONE;
+    }
+
+    /* ======== */
+
+    return ENTITY_MAKE(index, record->generation);
+}
+
+/* ================================================================ */
+
+int Entity_destroy(ECS_World* world, Entity entity) {
+
+    struct entity_record* record;
+
+    /* ================ */
+
+    if ((record = get_record(world, entity)) == NULL) {
+        return -1;
+    }
+
+    remove_row(world, world->archetypes[record->archetype], record->row);
+
+    record->archetype = NONE;
+    record->generation++;
+    record->generation = (record->generation == 0) ? 1 : record->generation;
+
+    record->next_free = world->free_head;
+    world->free_head = (int) ENTITY_INDEX(entity);
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+int Entity_is_alive(const ECS_World* world, Entity entity) {
+    return get_record(world, entity) != NULL;
+}
+
+/* ================================================================ */
+
+void* Entity_add(ECS_World* world, Entity entity, ECS_Component component, const void* value) {
+
+    struct entity_record* record;
+    ECS_Archetype* archetype;
+
+    int target;
+    void* pointer;
+
+    /* ================ */
+
+    if (((record = get_record(world, entity)) == NULL) || (component < 0) || (component >= world->components_count)) {
+        return NULL;
+    }
+
+    archetype = world->archetypes[record->archetype];
+
+    if (!(archetype->mask & ECS_MASK(component))) {
+
+        if ((target = archetype->add_edge[component]) == NONE) {
+
+            if ((target = find_archetype(world, archetype->mask | ECS_MASK(component))) == NONE) {
+                return NULL;
+            }
+
+            /* `find_archetype` may have grown the array of archetypes, but the tables themselves do not move */
+            archetype->add_edge[component] = target;
+            world->archetypes[target]->remove_edge[component] = record->archetype;
+        }
+
+        if (move_entity(world, record, entity, target) != 0) {
+            return NULL;
+        }
+
+        archetype = world->archetypes[target];
+    }
+
+    pointer = (char*) archetype->columns[component] + record->row * world->components[component].size;
+
+    if (value != NULL) {
+        memcpy(pointer, value, world->components[component].size);
+    }
+    else {
+        memset(pointer, 0, world->components[component].size);
+    }
+
+    /* ======== */
+
+    return pointer;
+}
+
+/* ================================================================ */
+
+int Entity_remove(ECS_World* world, Entity entity, ECS_Component component) {
+
+    struct entity_record* record;
+    ECS_Archetype* archetype;
+
+    int target;
+
+    /* ================ */
+
+    if (((record = get_record(world, entity)) == NULL) || (component < 0) || (component >= world->components_count)) {
+        return -1;
+    }
+
+    archetype = world->archetypes[record->archetype];
+
+    if (!(archetype->mask & ECS_MASK(component))) {
+        return -1;
+    }
+
+    if ((target = archetype->remove_edge[component]) == NONE) {
+
+        if ((target = find_archetype(world, archetype->mask & ~ECS_MASK(component))) == NONE) {
+            return -1;
+        }
+
+        archetype->remove_edge[component] = target;
+        world->archetypes[target]->add_edge[component] = record->archetype;
+    }
+
+    /* ======== */
+
+    return move_entity(world, record, entity, target);
+}
+
+/* ================================================================ */
+
+void* Entity_get(const ECS_World* world, Entity entity, ECS_Component component) {
+
+    struct entity_record* record;
+    ECS_Archetype* archetype;
+
+    /* ================ */
+
+    if (((record = get_record(world, entity)) == NULL) || (component < 0) || (component >= world->components_count)) {
+        return NULL;
+    }
+
+    archetype = world->archetypes[record->archetype];
+
+    if (archetype->columns[component] == NULL) {
+        return NULL;
+    }
+
+    /* ======== */
+
+    return (char*) archetype->columns[component] + record->row * world->components[component].size;
+}
+
+/* ================================================================ */
+
+ECS_Query ECS_query(ECS_World* world, Uint64 with, Uint64 without) {
+    return (ECS_Query) {world, with, without, 0, 0};
+}
+
+/* ================================================================ */
+
+int ECS_query_next(ECS_Query* query, ECS_Chunk* chunk) {
+
+    if ((query == NULL) || (query->world == NULL) || (chunk == NULL)) {
+        return 0;
+    }
+
+    for (; query->archetype < query->world->archetypes_count; query->archetype++, query->row = 0) {
+
+        ECS_Archetype* archetype = query->world->archetypes[query->archetype];
+
+        if (!archetype_matches(archetype, query->with, query->without) || (query->row >= archetype->count)) {
+            continue ;
+        }
+
+        chunk->archetype = archetype;
+        chunk->first = query->row;
+        chunk->count = archetype->count - query->row;
+        chunk->count = (chunk->count > ECS_CHUNK_ROWS) ? ECS_CHUNK_ROWS : chunk->count;
+        chunk->entities = archetype->entities + chunk->first;
+
+        query->row += chunk->count;
+
+        return 1;
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+void* ECS_chunk_column(const ECS_Chunk* chunk, ECS_Component component) {
+
+    if ((chunk == NULL) || (chunk->archetype == NULL) || (component < 0) || (component >= ECS_MAX_COMPONENTS)) {
+        return NULL;
+    }
+
+    if (chunk->archetype->columns[component] == NULL) {
+        return NULL;
+    }
+
+    /* ======== */
+
+    return (char*) chunk->archetype->columns[component] + chunk->first * chunk->archetype->world->components[component].size;
+}
+
+/* ================================================================ */
+
+int ECS_query_parallel_for(ECS_World* world, Uint64 with, Uint64 without, ECS_Chunk_Function function, void* data) {
+
+    struct parallel_query query = {NULL, function, data};
+
+    ECS_Query iterator;
+    ECS_Chunk chunk;
+
+    size_t count = 0;
+
+    /* ================ */
+
+    if ((world == NULL) || (function == NULL)) {
+        return -1;
+    }
+
+    /* ================================================ */
+    /* ========= Counting the matching chunks ========= */
+    /* ================================================ */
+
+    for (size_t i = 0; i < world->archetypes_count; i++) {
+
+        if (archetype_matches(world->archetypes[i], with, without)) {
+            count += (world->archetypes[i]->count + ECS_CHUNK_ROWS - 1) / ECS_CHUNK_ROWS;
+        }
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+
+    if ((query.chunks = malloc(count * sizeof(ECS_Chunk))) == NULL) {
+
+        error(stderr, "in %s%s%s (%s%s%s)\n", BLUE, __func__, WHITE, RED, strerror(errno), WHITE);
+
+        return -1;
+    }
+
+    iterator = ECS_query(world, with, without);
+
+    for (size_t i = 0; (i < count) && ECS_query_next(&iterator, &chunk); i++) {
+        query.chunks[i] = chunk;
+    }
+
+    /* Every chunk is a job of its own */
+    Jobs_parallel_for(count, 1, chunk_range, &query);
+
+    free(query.chunks);
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+#undef ENTITY_INDEX
+#undef ENTITY_GENERATION
+#undef ENTITY_MAKE
+#undef NONE
@@ -1,5 +1,44 @@
 #include "../../sancho-panza.h"
 
+/* Grids are taken from a pool, so creating and destroying many of them does not fragment the heap */
+static Pool grid_pool = POOL_INITIALIZER("Grid", Grid);
+
+/* ================================================================ */
+
+/* What `Grid_deserialize` reads from a document */
+struct grid_options {
+
+    int cell_width;
+    int cell_height;
+    int width;
+    int height;
+
+    SDL_Color color;
+};
+
+/* ================================================================ */
+
+static int parse_color(const cJSON* item, void* member) {
+    return deserialize__SDL_Color(item, member, NULL);
+}
+
+/* ================================================================ */
+
+static const Field grid_options_fields[] = {
+    FIELD_DEFAULT(struct grid_options, cell_width, "cell_width", FIELD_INT, 0),
+    FIELD_DEFAULT(struct grid_options, cell_height, "cell_height", FIELD_INT, 0),
+    FIELD_DEFAULT(struct grid_options, width, "width", FIELD_INT, 0),
+    FIELD_DEFAULT(struct grid_options, height, "height", FIELD_INT, 0),
+    FIELD_PARSED(struct grid_options, color, "color", 0, parse_color),
+};
+
+static Schema grid_options_schema = SCHEMA(grid_options_fields);
+
+/* ================================================================ */
+
+/* The size of a grid in a snapshot: four little-endian `Sint32` (the cell size and the grid size) and the color */
+#define GRID_SNAPSHOT_SIZE 20
+
 /* ================================================================ */
 
 Grid *Grid_new(int cell_width, int cell_height, int width, int height, SDL_Color *color) {
@@ -8,7 +47,7 @@ Grid *Grid_new(int cell_width, int cell_height, int width, int height, SDL_Color
 
     /* ================ */
 
-    if ((grid = calloc(1, sizeof(Grid))) == NULL) {
+    if ((grid = Pool_new_object(&grid_pool, Grid)) == NULL) {
         return NULL;
     }
 
@@ -36,7 +75,7 @@ void Grid_destroy(Grid **grid) {
         return;
     }
 
-    free(*grid);
+    Pool_free(&grid_pool, *grid);
     *grid = NULL;
 }
 
@@ -180,14 +219,8 @@ cJSON *Grid_serialize(const Grid *grid) {
 
 int Grid_deserialize(const cJSON* root, Grid* grid) {
 
-    int cell_width;
-    int cell_height;
-    int width;
-    int height;
-
-    SDL_Color color;
-
-    cJSON* data;
+    /* The color keeps this value unless the document has a valid one */
+    struct grid_options options = {0, 0, 0, 0, {0, 0, 0, 255}};
 
     /* ================ */
 
@@ -200,68 +233,37 @@ int Grid_deserialize(const cJSON* root, Grid* grid) {
     }
 
     /* ================================================ */
-    /* =========== Extracting `cell_width` ============ */
-    /* ================================================ */
-
-    if (extract_JSON_data(root, "cell_width", NUMBER, &data) != 0) {
-        cell_width = 0;
-    }
-    cell_width = (data != NULL) ? data->valueint : cell_width;
-
-    /* ================================================ */
-    /* =========== Extracting `cell_height` =========== */
-    /* ================================================ */
-
-    if (extract_JSON_data(root, "cell_height", NUMBER, &data) != 0) {
-        cell_height = 0;
-    }
-    cell_height = (data != NULL) ? data->valueint : cell_height;
-
-    /* ================================================ */
-    /* ============== Extracting `width` ============== */
-    /* ================================================ */
-
-    if (extract_JSON_data(root, "width", NUMBER, &data) != 0) {
-        width = 0;
-    }
-    width = (data != NULL) ? data->valueint : width;
-
-    /* ================================================ */
-    /* ============= Extracting `height` ============== */
+    /* ======= Extracting every field in a single ===== */
+    /* ======= pass; missing ones are set to 0 ======== */
     /* ================================================ */
 
-    if (extract_JSON_data(root, "height", NUMBER, &data) != 0) {
-        height = 0;
-    }
-    height = (data != NULL) ? data->valueint : height;
+    if (JSON_deserialize(root, &grid_options_schema, &options, NULL) != 0) {
+        /* `JSON_deserialize` prints every error here; the invalid fields have their default values */
 
-    /* ================================================ */
-    /* ============= Extracting `color` =============== */
-    /* ================================================ */
-
-    if (deserialize__SDL_Color(root, &color, "color") != 0) {
-        color = (SDL_Color) {0, 0, 0, 255};
+        if (!cJSON_IsObject(root)) {
+            return -1;
+        }
     }
 
     /* ================================================ */
 
     /* If width is not set (0) and height is set, assign height to width */
-    if (!cell_width && cell_height) { cell_width = cell_height; }
+    if (!options.cell_width && options.cell_height) { options.cell_width = options.cell_height; }
     /* If height is not set (0) and width is set, assign width to height. */
-    if (cell_width && !cell_height) { cell_height = cell_width; }
+    if (options.cell_width && !options.cell_height) { options.cell_height = options.cell_width; }
 
     /* ================================================ */
 
-    grid->cell_w = cell_width;
-    grid->cell_h = cell_height;
+    grid->cell_w = options.cell_width;
+    grid->cell_h = options.cell_height;
 
-    grid->rows = (cell_height == 0) ? 0 : height / cell_height;
-    grid->cols = (cell_width == 0) ? 0 : width / cell_width;
+    grid->rows = (options.cell_height == 0) ? 0 : options.height / options.cell_height;
+    grid->cols = (options.cell_width == 0) ? 0 : options.width / options.cell_width;
     
-    grid->width = width;
-    grid->height = height;
+    grid->width = options.width;
+    grid->height = options.height;
 
-    grid->color = color;
+    grid->color = options.color;
 
     /* ======== */
 
@@ -288,3 +290,98 @@ int Grid_setColor(Grid* grid, const SDL_Color* color) {
 }
 
 /* ================================================================ */
+
+int Grid_add_to_snapshot(Snapshot_Writer* writer, const Grid* grid, Uint32 id, const Uint32* cells) {
+
+    Uint8 payload[GRID_SNAPSHOT_SIZE];
+    Sint32 dimensions[4];
+
+    /* ================ */
+
+    if ((writer == NULL) || (grid == NULL)) {
+        return -1;
+    }
+
+    dimensions[0] = (Sint32) SDL_SwapLE32((Uint32) grid->cell_w);
+    dimensions[1] = (Sint32) SDL_SwapLE32((Uint32) grid->cell_h);
+    dimensions[2] = (Sint32) SDL_SwapLE32((Uint32) grid->width);
+    dimensions[3] = (Sint32) SDL_SwapLE32((Uint32) grid->height);
+
+    memcpy(payload, dimensions, sizeof(dimensions));
+
+    payload[16] = grid->color.r;
+    payload[17] = grid->color.g;
+    payload[18] = grid->color.b;
+    payload[19] = grid->color.a;
+
+    if (Snapshot_add(writer, SNAPSHOT_TAG_GRID, id, payload, sizeof(payload), SNAPSHOT_CHECKSUM) != 0) {
+        return -1;
+    }
+
+    /* ======== */
+
+    return (cells == NULL) ? 0 : Snapshot_add_Uint32(writer, SNAPSHOT_TAG_CELLS, id, cells, (size_t) grid->rows * (size_t) grid->cols, SNAPSHOT_CHECKSUM);
+}
+
+/* ================================================================ */
+
+int Grid_from_snapshot(const Snapshot* snapshot, Uint32 id, Grid* grid, const Uint32** cells) {
+
+    const Uint8* payload;
+    const Uint32* data;
+
+    Sint32 dimensions[4];
+    size_t size;
+
+    /* ================ */
+
+    if ((snapshot == NULL) || (grid == NULL)) {
+        return -1;
+    }
+
+    if (((payload = Snapshot_find(snapshot, SNAPSHOT_TAG_GRID, id, &size)) == NULL) || (size != GRID_SNAPSHOT_SIZE)) {
+        return -1;
+    }
+
+    memcpy(dimensions, payload, sizeof(dimensions));
+
+    grid->cell_w = (int) SDL_SwapLE32((Uint32) dimensions[0]);
+    grid->cell_h = (int) SDL_SwapLE32((Uint32) dimensions[1]);
+    grid->width = (int) SDL_SwapLE32((Uint32) dimensions[2]);
+    grid->height = (int) SDL_SwapLE32((Uint32) dimensions[3]);
+
+    grid->color = (SDL_Color) {payload[16], payload[17], payload[18], payload[19]};
+
+    grid->rows = (grid->cell_h <= 0) ? 0 : grid->height / grid->cell_h;
+    grid->cols = (grid->cell_w <= 0) ? 0 : grid->width / grid->cell_w;
+
+    /* ================================================ */
+    /* ============ The cells, used in place ========== */
+    /* ================================================ */
+
+    if (cells == NULL) {
+        return 0;
+    }
+
+    if ((data = Snapshot_find(snapshot, SNAPSHOT_TAG_CELLS, id, &size)) == NULL) {
+        *cells = NULL;
+
+        return 0;
+    }
+
+    if ((grid->rows < 0) || (grid->cols < 0) || (size != (size_t) grid->rows * (size_t) grid->cols * sizeof(Uint32)) || (SDL_BYTEORDER != SDL_LIL_ENDIAN)) {
+        *cells = NULL;
+
+        return -1;
+    }
+
+    *cells = data;
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+#undef GRID_SNAPSHOT_SIZE
@@ -1,5 +1,8 @@
 #include "../../sancho-panza.h"
 
+/* Timers are taken from a pool, so creating and destroying many of them does not fragment the heap */
+static Pool timer_pool = POOL_INITIALIZER("Timer", Timer);
+
 /* ================================================================ */
 
 Timer* Timer_new(double t) {
@@ -8,11 +11,9 @@ Timer* Timer_new(double t) {
 
     /* ======== */
 
-    if ((timer = calloc(1, sizeof(struct timer))) == NULL) {
+    if ((timer = Pool_new_object(&timer_pool, Timer)) == NULL) {
 
-        #ifdef STRICT
-            error(stderr, "in %s%s%s (%s%s%s)\n", BLUE, __func__, WHITE, RED, strerror(errno), WHITE);
-        #endif
+        error(stderr, "in %s%s%s (%s%s%s)\n", BLUE, __func__, WHITE, RED, strerror(errno), WHITE);
 
         /* ======== */
         return NULL;
@@ -34,12 +35,10 @@ int Timer_destroy(Timer** t) {
         return -1;
     }
 
-    free(*t);
+    Pool_free(&timer_pool, *t);
     *t = NULL;
 
-    #ifdef STRICT
-        success(stdout, "timer has been destroyed\n", "");
-    #endif
+    success(stdout, "timer has been destroyed\n", "");
 
     /* ======== */
 
@@ -108,6 +107,8 @@ void Timer_tick(Timer* t) {
     t->d = (float) delta / (float) SDL_GetPerformanceFrequency();
 
     t->acc += t->d;
+
+    t->frames++;
 }
 
 /* ================================================================ */
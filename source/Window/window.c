@@ -1,5 +1,8 @@
 #include "../../sancho-panza.h"
 
+/* Windows are taken from a pool, so creating and destroying many of them does not fragment the heap */
+static Pool window_pool = POOL_INITIALIZER("Window", Window);
+
 /* ================================================================ */
 
 Window* Window_new(const char* title, int w, int h, Uint32 wflags, Uint32 rflags) {
@@ -12,11 +15,9 @@ Window* Window_new(const char* title, int w, int h, Uint32 wflags, Uint32 rflags
     /* ============== Memory Allocation =============== */
     /* ================================================ */
 
-    if ((new_window = calloc(1, sizeof(struct window))) == NULL) {
+    if ((new_window = Pool_new_object(&window_pool, Window)) == NULL) {
         
-        #ifdef STRICT
-            error(stderr, "%s\n", strerror(errno), "");
-        #endif
+        error(stderr, "%s\n", strerror(errno), "");
 
         /* ======== */
         return NULL;
@@ -28,11 +29,9 @@ Window* Window_new(const char* title, int w, int h, Uint32 wflags, Uint32 rflags
 
     if ((new_window->w = SDL_CreateWindow((title != NULL) ? title : "Sancho-Panza", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, w, h, wflags)) == NULL) {
 
-        #ifdef STRICT
-            error(stderr, "[%s%s%s] %s\n", BLUE, "SDL_CreateWindow", WHITE, strerror(errno));
-        #endif
+        error(stderr, "[%s%s%s] %s\n", BLUE, "SDL_CreateWindow", WHITE, strerror(errno));
 
-        free(new_window);
+        Pool_free(&window_pool, new_window);
 
         /* ======== */
         return NULL;
@@ -44,20 +43,16 @@ Window* Window_new(const char* title, int w, int h, Uint32 wflags, Uint32 rflags
 
     if ((new_window->r = SDL_CreateRenderer(new_window->w, -1, rflags)) == NULL) {
 
-        #ifdef STRICT
-            error(stderr, "[%s%s%s] %s\n", BLUE, "SDL_CreateRenderer", WHITE, strerror(errno));
-        #endif
+        error(stderr, "[%s%s%s] %s\n", BLUE, "SDL_CreateRenderer", WHITE, strerror(errno));
 
         SDL_DestroyWindow(new_window->w);
-        free(new_window);
+        Pool_free(&window_pool, new_window);
 
         /* ======== */
         return NULL;
     }
 
-    #ifdef STRICT
-        success(stderr, "%s\n", "window has been created", "");
-    #endif
+    success(stderr, "%s\n", "window has been created", "");
 
     /* ======== */
 
@@ -74,13 +69,11 @@ int Window_destroy(Window** w) {
 
     SDL_DestroyWindow((*w)->w);
     SDL_DestroyRenderer((*w)->r);
-    free(*w);
+    Pool_free(&window_pool, *w);
 
     *w = NULL;
 
-    #ifdef STRICT
-        success(stdout, "window has been destroyed\n", "");
-    #endif
+    success(stdout, "window has been destroyed\n", "");
 
     /* ======== */
 
@@ -0,0 +1,496 @@
+#include "../../sancho-panza.h"
+
+/* ================================================================ */
+
+struct arena_block {
+
+    Arena_Block* next;
+
+    /* The number of usable bytes after the header and the number of those already handed out */
+    size_t capacity;
+    size_t offset;
+
+    /* The memory of the block follows the header */
+    _Alignas(ARENA_DEFAULT_ALIGNMENT) unsigned char data[];
+};
+
+/* ================================================================ */
+
+/* The frame arena the library uses for its own temporary data */
+static Frame_Arena* current_frame_arena = NULL;
+
+/**
+ * The memory `Frame_temp_alloc` took from the heap. These are the only pointers `Frame_temp_free` passes to `free`:
+ * anything else came from a frame arena, which may have been reset or destroyed since, so it is never looked at.
+ */
+static struct {
+
+    void** pointers;
+    size_t count;
+    size_t capacity;
+
+    SDL_SpinLock lock;
+} heap_fallbacks;
+
+/* ================================================================ */
+/* ================== Static, internal functions ================== */
+/* ================================================================ */
+
+static Arena_Block* new_block(size_t capacity) {
+
+    Arena_Block* block;
+
+    /* ================ */
+
+    if ((block = malloc(sizeof(struct arena_block) + capacity)) == NULL) {
+
+        error(stderr, "in %s%s%s (%s%s%s)\n", BLUE, __func__, WHITE, RED, strerror(errno), WHITE);
+
+        return NULL;
+    }
+
+    block->next = NULL;
+    block->capacity = capacity;
+    block->offset = 0;
+
+    /* ======== */
+
+    return block;
+}
+
+/* ================================================================ */
+
+/**
+ * The `block_fit` function returns the offset an allocation would start at in a block, or `(size_t) -1` if it does not fit.
+ */
+static size_t block_fit(const Arena_Block* block, size_t size, size_t alignment) {
+
+    uintptr_t address = (uintptr_t) (block->data + block->offset);
+    size_t padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+
+    /* ================ */
+
+    if ((block->capacity - block->offset < padding) || (block->capacity - block->offset - padding < size)) {
+        return (size_t) -1;
+    }
+
+    /* ======== */
+
+    return block->offset + padding;
+}
+
+/* ================================================================ */
+
+/**
+ * The `sync_frame` function starts a new frame if the timer of the arena has ticked since the current buffer was started.
+ */
+static void sync_frame(Frame_Arena* arena) {
+
+    if ((arena->timer != NULL) && (arena->timer->frames != arena->frame)) {
+        Frame_Arena_begin(arena);
+
+        arena->frame = arena->timer->frames;
+    }
+}
+
+/* ================================================================ */
+
+/**
+ * The `remember_fallback` function adds a pointer to the heap fallbacks.
+ *
+ * @return `0` on success. `-1` if memory allocation fails.
+ */
+static int remember_fallback(void* pointer) {
+
+    int status = 0;
+
+    /* ================ */
+
+    SDL_AtomicLock(&heap_fallbacks.lock);
+
+    if (heap_fallbacks.count == heap_fallbacks.capacity) {
+
+        size_t capacity = (heap_fallbacks.capacity == 0) ? 16 : heap_fallbacks.capacity * 2;
+        void** pointers;
+
+        if ((pointers = realloc(heap_fallbacks.pointers, capacity * sizeof(void*))) == NULL) {
+            status = -1;
+
+            goto END;
+        }
+
+        heap_fallbacks.pointers = pointers;
+        heap_fallbacks.capacity = capacity;
+    }
+
+    heap_fallbacks.pointers[heap_fallbacks.count++] = pointer;
+
+    /* ======== */
+
+    { END:
+        SDL_AtomicUnlock(&heap_fallbacks.lock);
+
+        return status;
+    }
+}
+
+/* ================================================================ */
+
+/**
+ * The `forget_fallback` function removes a pointer from the heap fallbacks. The search starts from the most recent ones,
+ * since temporary memory is mostly released in the reverse order.
+ *
+ * @return `1` if the pointer was a heap fallback, `0` otherwise.
+ */
+static int forget_fallback(void* pointer) {
+
+    int found = 0;
+
+    /* ================ */
+
+    SDL_AtomicLock(&heap_fallbacks.lock);
+
+    for (size_t i = heap_fallbacks.count; i > 0; i--) {
+
+        if (heap_fallbacks.pointers[i - 1] == pointer) {
+            heap_fallbacks.pointers[i - 1] = heap_fallbacks.pointers[--heap_fallbacks.count];
+            found = 1;
+
+            break ;
+        }
+    }
+
+    SDL_AtomicUnlock(&heap_fallbacks.lock);
+
+    /* ======== */
+
+    return found;
+}
+
+/* ================================================================ */
+/* ============== Definitions of external functions =============== */
+/* ================================================================ */
+
+void Arena_init(Arena* arena, size_t block_size) {
+
+    if (arena == NULL) {
+        return ;
+    }
+
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->block_size = (block_size == 0) ? ARENA_BLOCK_SIZE : block_size;
+}
+
+/* ================================================================ */
+
+void* Arena_alloc(Arena* arena, size_t size, size_t alignment) {
+
+    Arena_Block* block;
+    size_t offset;
+
+    /* ================ */
+
+    alignment = (alignment == 0) ? ARENA_DEFAULT_ALIGNMENT : alignment;
+
+    if ((arena == NULL) || (alignment & (alignment - 1))) {
+        return NULL;
+    }
+
+    /* ================================================ */
+    /* ====== Trying the current block, then the ====== */
+    /* ====== blocks left over from a rewind ========== */
+    /* ================================================ */
+
+    for (block = arena->current; block != NULL; block = block->next) {
+
+        if (block != arena->current) {
+            block->offset = 0;
+        }
+
+        if ((offset = block_fit(block, size, alignment)) != (size_t) -1) {
+            goto FOUND;
+        }
+    }
+
+    /* ================================================ */
+    /* ============= Allocating a new block =========== */
+    /* ================================================ */
+
+    if ((block = new_block((size + alignment > arena->block_size) ? size + alignment : arena->block_size)) == NULL) {
+        return NULL;
+    }
+
+    if (arena->current == NULL) {
+        arena->first = block;
+    }
+    else {
+        /* Keep the blocks that did not fit after the new one */
+        block->next = arena->current->next;
+        arena->current->next = block;
+    }
+
+    offset = block_fit(block, size, alignment);
+
+    /* ======== */
+
+    { FOUND:
+        block->offset = offset + size;
+        arena->current = block;
+
+        return block->data + offset;
+    }
+}
+
+/* ================================================================ */
+
+Arena_Mark Arena_mark(const Arena* arena) {
+
+    Arena_Mark mark = {NULL, 0};
+
+    /* ================ */
+
+    if ((arena != NULL) && (arena->current != NULL)) {
+        mark.block = arena->current;
+        mark.offset = arena->current->offset;
+    }
+
+    /* ======== */
+
+    return mark;
+}
+
+/* ================================================================ */
+
+void Arena_rewind(Arena* arena, Arena_Mark mark) {
+
+    if (arena == NULL) {
+        return ;
+    }
+
+    if (mark.block == NULL) {
+        /* The mark was taken before the first allocation */
+        arena->current = arena->first;
+
+        if (arena->current != NULL) {
+            arena->current->offset = 0;
+        }
+
+        return ;
+    }
+
+    arena->current = mark.block;
+    arena->current->offset = mark.offset;
+}
+
+/* ================================================================ */
+
+void Arena_reset(Arena* arena) {
+
+    Arena_Block* block;
+    size_t capacity = 0;
+
+    /* ================ */
+
+    if ((arena == NULL) || (arena->first == NULL)) {
+        return ;
+    }
+
+    if (arena->first->next == NULL) {
+        arena->first->offset = 0;
+        arena->current = arena->first;
+
+        return ;
+    }
+
+    /* ================================================ */
+    /* ====== Merging all blocks into a single one ==== */
+    /* ================================================ */
+
+    for (block = arena->first; block != NULL; block = block->next) {
+        capacity += block->capacity;
+    }
+
+    Arena_release(arena);
+
+    /* If the merged block cannot be allocated, the arena simply starts empty */
+    arena->first = new_block(capacity);
+    arena->current = arena->first;
+}
+
+/* ================================================================ */
+
+void Arena_release(Arena* arena) {
+
+    Arena_Block* block;
+    Arena_Block* next;
+
+    /* ================ */
+
+    if (arena == NULL) {
+        return ;
+    }
+
+    for (block = arena->first; block != NULL; block = next) {
+        next = block->next;
+        free(block);
+    }
+
+    arena->first = NULL;
+    arena->current = NULL;
+}
+
+/* ================================================================ */
+
+int Arena_owns(const Arena* arena, const void* pointer) {
+
+    const Arena_Block* block;
+
+    /* ================ */
+
+    if ((arena == NULL) || (pointer == NULL)) {
+        return 0;
+    }
+
+    for (block = arena->first; block != NULL; block = block->next) {
+
+        if (((const unsigned char*) pointer >= block->data) && ((const unsigned char*) pointer < block->data + block->capacity)) {
+            return 1;
+        }
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+Frame_Arena* Frame_Arena_new(size_t block_size, const Timer* timer) {
+
+    Frame_Arena* arena;
+
+    /* ================ */
+
+    if ((arena = calloc(1, sizeof(Frame_Arena))) == NULL) {
+
+        error(stderr, "in %s%s%s (%s%s%s)\n", BLUE, __func__, WHITE, RED, strerror(errno), WHITE);
+
+        return NULL;
+    }
+
+    Arena_init(&arena->buffers[0], block_size);
+    Arena_init(&arena->buffers[1], block_size);
+
+    arena->timer = timer;
+    arena->frame = (timer != NULL) ? timer->frames : 0;
+    arena->owner = SDL_ThreadID();
+
+    /* ======== */
+
+    return arena;
+}
+
+/* ================================================================ */
+
+void Frame_Arena_destroy(Frame_Arena** arena) {
+
+    if ((arena == NULL) || (*arena == NULL)) {
+        return ;
+    }
+
+    if (current_frame_arena == *arena) {
+        current_frame_arena = NULL;
+    }
+
+    Arena_release(&(*arena)->buffers[0]);
+    Arena_release(&(*arena)->buffers[1]);
+    free(*arena);
+
+    *arena = NULL;
+}
+
+/* ================================================================ */
+
+void Frame_Arena_begin(Frame_Arena* arena) {
+
+    if (arena == NULL) {
+        return ;
+    }
+
+    arena->current ^= 1;
+
+    Arena_reset(&arena->buffers[arena->current]);
+}
+
+/* ================================================================ */
+
+Arena* Frame_Arena_get(Frame_Arena* arena) {
+
+    if (arena == NULL) {
+        return NULL;
+    }
+
+    sync_frame(arena);
+
+    /* ======== */
+
+    return &arena->buffers[arena->current];
+}
+
+/* ================================================================ */
+
+void* Frame_alloc(Frame_Arena* arena, size_t size, size_t alignment) {
+    return Arena_alloc(Frame_Arena_get(arena), size, alignment);
+}
+
+/* ================================================================ */
+
+Frame_Arena* Frame_Arena_current(void) {
+    return ((current_frame_arena != NULL) && (current_frame_arena->owner == SDL_ThreadID())) ? current_frame_arena : NULL;
+}
+
+/* ================================================================ */
+
+void Frame_Arena_set_current(Frame_Arena* arena) {
+    current_frame_arena = arena;
+}
+
+/* ================================================================ */
+
+void* Frame_temp_alloc(size_t size) {
+
+    Frame_Arena* arena = Frame_Arena_current();
+    void* pointer;
+
+    /* ================ */
+
+    if ((arena != NULL) && ((pointer = Frame_alloc(arena, size, 0)) != NULL)) {
+        return pointer;
+    }
+
+    if ((pointer = malloc(size)) == NULL) {
+        return NULL;
+    }
+
+    if (remember_fallback(pointer) != 0) {
+        free(pointer);
+
+        return NULL;
+    }
+
+    /* ======== */
+
+    return pointer;
+}
+
+/* ================================================================ */
+
+void Frame_temp_free(void* pointer) {
+
+    if ((pointer != NULL) && forget_fallback(pointer)) {
+        free(pointer);
+    }
+}
+
+/* ================================================================ */
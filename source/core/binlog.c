@@ -0,0 +1,557 @@
+#include "../../sancho-panza.h"
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/* Longer string arguments are truncated, so a record always fits into an empty buffer */
+#define MAX_STRING_LENGTH 2048
+
+/* The size of the identifier and the timestamp that start every record */
+#define RECORD_HEADER_SIZE (sizeof(Uint32) + sizeof(Uint64))
+
+/* ================================================================ */
+
+struct binlog_buffer {
+
+    unsigned char* data;
+    size_t used;
+
+    Uint32 thread;
+
+    /* The list of all buffers, so `Binlog_close` can write them */
+    struct binlog_buffer* next;
+};
+
+/* ================================================================ */
+
+static struct binlog {
+
+    FILE* file;
+
+    /* Guards the file, the list of buffers and the registration of call sites */
+    SDL_mutex* lock;
+
+    struct binlog_buffer* buffers;
+
+    Uint32 threads;
+    Uint32 formats;
+
+    /* Bumped by every `Binlog_open`, so call sites and buffers of a previous log are not reused */
+    atomic_int generation;
+    atomic_int open;
+} binlog_state = {NULL, NULL, NULL, 0, 0, 0, 0};
+
+/* The buffer of the calling thread and the generation of the log it belongs to */
+static _Thread_local struct binlog_buffer* local_buffer = NULL;
+static _Thread_local int local_generation = 0;
+
+/* ================================================================ */
+/* ================== Static, internal functions ================== */
+/* ================================================================ */
+
+/**
+ * The `parse_format` function finds the kinds of the arguments of a `printf` format string.
+ *
+ * @return The number of arguments. `-1` if the format uses an unsupported conversion or has too many arguments.
+ */
+static int parse_format(const char* format, Uint8* kinds) {
+
+    int count = 0;
+    int length;
+
+    /* ================ */
+
+    for (const char* c = format; *c != '\0'; c++) {
+
+        if (*c != '%') {
+            continue ;
+        }
+
+        if (*++c == '%') {
+            continue ;
+        }
+
+        /* Flags */
+        while ((*c != '\0') && (strchr("-+ #0'", *c) != NULL)) {
+            c++;
+        }
+
+        /* Width and precision, which take an argument of their own when they are `*` */
+        for (int part = 0; part < 2; part++) {
+
+            if (part == 1) {
+
+                if (*c != '.') {
+                    break ;
+                }
+
+                c++;
+            }
+
+            if (*c == '*') {
+
+                if (count == BINLOG_MAX_ARGUMENTS) {
+                    return -1;
+                }
+
+                kinds[count++] = BINLOG_INT;
+                c++;
+            }
+            else {
+
+                while ((*c >= '0') && (*c <= '9')) {
+                    c++;
+                }
+            }
+        }
+
+        /* Length modifiers: `h` and `hh` are promoted to `int` */
+        length = 0;
+
+        while ((*c != '\0') && (strchr("hlLzjt", *c) != NULL)) {
+            length = (*c == 'l') ? ((length == 'l') ? 'q' : 'l') : ((*c == 'h') ? length : *c);
+            c++;
+        }
+
+        if (count == BINLOG_MAX_ARGUMENTS) {
+            return -1;
+        }
+
+        switch (*c) {
+
+            case 'd': case 'i': case 'o': case 'u': case 'x': case 'X': case 'c':
+
+                switch (length) {
+                    case 'l': kinds[count++] = BINLOG_LONG; break ;
+                    case 'q': kinds[count++] = BINLOG_LONG_LONG; break ;
+                    case 'z': kinds[count++] = BINLOG_SIZE; break ;
+                    case 'j': kinds[count++] = BINLOG_INTMAX; break ;
+                    case 't': kinds[count++] = BINLOG_PTRDIFF; break ;
+                    default: kinds[count++] = BINLOG_INT; break ;
+                }
+
+                break ;
+
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                kinds[count++] = (length == 'L') ? BINLOG_LONG_DOUBLE : BINLOG_DOUBLE;
+                break ;
+
+            case 's':
+                kinds[count++] = BINLOG_STRING;
+                break ;
+
+            case 'p':
+                kinds[count++] = BINLOG_POINTER;
+                break ;
+
+            default:
+                return -1;
+        }
+    }
+
+    /* ======== */
+
+    return count;
+}
+
+/* ================================================================ */
+
+/**
+ * The `register_site` function gives a call site an identifier and writes the definition of its format. The log must be locked.
+ */
+static int register_site(Binlog_Site* site, const char* format, int generation) {
+
+    Uint32 id;
+    Uint32 length = (Uint32) strlen(format);
+    int count;
+
+    /* ================ */
+
+    /* Another thread may have registered it in the meantime */
+    if (SDL_AtomicGet(&site->generation) == generation) {
+        return site->rejected ? -1 : 0;
+    }
+
+    if ((count = parse_format(format, site->kinds)) < 0) {
+
+        error(stderr, "unsupported binary log format (%s%s%s)\n", PURPLE, format, WHITE);
+
+        /* Recorded for the current log, so the format is not parsed and reported again on every call */
+        site->rejected = 1;
+        SDL_AtomicSet(&site->generation, generation);
+
+        return -1;
+    }
+
+    id = ++binlog_state.formats;
+
+    site->id = id;
+    site->count = (Uint8) count;
+    site->rejected = 0;
+
+    fputc('F', binlog_state.file);
+    fwrite(&id, sizeof(id), 1, binlog_state.file);
+    fwrite(&site->count, sizeof(site->count), 1, binlog_state.file);
+    fwrite(site->kinds, 1, site->count, binlog_state.file);
+    fwrite(&length, sizeof(length), 1, binlog_state.file);
+    fwrite(format, 1, length, binlog_state.file);
+
+    /* The identifier and the kinds are visible to other threads once the generation is */
+    SDL_AtomicSet(&site->generation, generation);
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+/**
+ * The `write_buffer` function writes the records of a buffer as a chunk and empties it. The log must be locked.
+ */
+static void write_buffer(struct binlog_buffer* buffer) {
+
+    Uint32 size = (Uint32) buffer->used;
+
+    /* ================ */
+
+    if (size == 0) {
+        return ;
+    }
+
+    fputc('C', binlog_state.file);
+    fwrite(&buffer->thread, sizeof(buffer->thread), 1, binlog_state.file);
+    fwrite(&size, sizeof(size), 1, binlog_state.file);
+    fwrite(buffer->data, 1, size, binlog_state.file);
+
+    buffer->used = 0;
+}
+
+/* ================================================================ */
+
+/**
+ * The `thread_buffer` function returns the buffer of the calling thread, creating it the first time the thread writes to the log.
+ */
+static struct binlog_buffer* thread_buffer(int generation) {
+
+    struct binlog_buffer* buffer;
+
+    /* ================ */
+
+    if ((local_buffer != NULL) && (local_generation == generation)) {
+        return local_buffer;
+    }
+
+    if ((buffer = malloc(sizeof(struct binlog_buffer))) == NULL) {
+        return NULL;
+    }
+
+    if ((buffer->data = malloc(BINLOG_BUFFER_SIZE)) == NULL) {
+        free(buffer);
+
+        return NULL;
+    }
+
+    buffer->used = 0;
+
+    SDL_LockMutex(binlog_state.lock);
+
+    buffer->thread = binlog_state.threads++;
+    buffer->next = binlog_state.buffers;
+    binlog_state.buffers = buffer;
+
+    SDL_UnlockMutex(binlog_state.lock);
+
+    local_buffer = buffer;
+    local_generation = generation;
+
+    /* ======== */
+
+    return buffer;
+}
+
+/* ================================================================ */
+
+/**
+ * The `record_size` function computes the number of bytes a record takes with the given arguments.
+ */
+static size_t record_size(const Binlog_Site* site, va_list args) {
+
+    size_t size = RECORD_HEADER_SIZE;
+    const char* string;
+
+    /* ================ */
+
+    for (int i = 0; i < site->count; i++) {
+
+        switch (site->kinds[i]) {
+
+            case BINLOG_INT:
+                (void) va_arg(args, int);
+                size += sizeof(Sint32);
+                break ;
+
+            case BINLOG_LONG: (void) va_arg(args, long); size += sizeof(Sint64); break ;
+            case BINLOG_LONG_LONG: (void) va_arg(args, long long); size += sizeof(Sint64); break ;
+            case BINLOG_SIZE: (void) va_arg(args, size_t); size += sizeof(Sint64); break ;
+            case BINLOG_INTMAX: (void) va_arg(args, intmax_t); size += sizeof(Sint64); break ;
+            case BINLOG_PTRDIFF: (void) va_arg(args, ptrdiff_t); size += sizeof(Sint64); break ;
+            case BINLOG_DOUBLE: (void) va_arg(args, double); size += sizeof(double); break ;
+            case BINLOG_LONG_DOUBLE: (void) va_arg(args, long double); size += sizeof(double); break ;
+            case BINLOG_POINTER: (void) va_arg(args, void*); size += sizeof(Uint64); break ;
+
+            case BINLOG_STRING:
+                string = va_arg(args, const char*);
+                size += sizeof(Uint32) + ((string != NULL) ? strnlen(string, MAX_STRING_LENGTH) : sizeof("(null)") - 1);
+                break ;
+        }
+    }
+
+    /* ======== */
+
+    return size;
+}
+
+/* ================================================================ */
+
+static void write_record(const Binlog_Site* site, unsigned char* output, va_list args) {
+
+    Uint64 ticks = SDL_GetPerformanceCounter();
+    Uint32 id = site->id;
+
+    Sint32 integer;
+    Sint64 wide;
+    Uint64 address;
+    double real;
+
+    const char* string;
+    Uint32 length;
+
+    /* ================ */
+
+    memcpy(output, &id, sizeof(id));
+    memcpy(output + sizeof(id), &ticks, sizeof(ticks));
+
+    output += RECORD_HEADER_SIZE;
+
+    for (int i = 0; i < site->count; i++) {
+
+        switch (site->kinds[i]) {
+
+            case BINLOG_INT:
+                integer = va_arg(args, int);
+                memcpy(output, &integer, sizeof(integer));
+                output += sizeof(integer);
+
+                continue ;
+
+            case BINLOG_LONG: wide = va_arg(args, long); break ;
+            case BINLOG_LONG_LONG: wide = va_arg(args, long long); break ;
+            case BINLOG_SIZE: wide = (Sint64) va_arg(args, size_t); break ;
+            case BINLOG_INTMAX: wide = va_arg(args, intmax_t); break ;
+            case BINLOG_PTRDIFF: wide = va_arg(args, ptrdiff_t); break ;
+
+            case BINLOG_DOUBLE:
+            case BINLOG_LONG_DOUBLE:
+                real = (site->kinds[i] == BINLOG_DOUBLE) ? va_arg(args, double) : (double) va_arg(args, long double);
+                memcpy(output, &real, sizeof(real));
+                output += sizeof(real);
+
+                continue ;
+
+            case BINLOG_POINTER:
+                address = (Uint64) (uintptr_t) va_arg(args, void*);
+                memcpy(output, &address, sizeof(address));
+                output += sizeof(address);
+
+                continue ;
+
+            case BINLOG_STRING:
+                string = va_arg(args, const char*);
+                string = (string != NULL) ? string : "(null)";
+                length = (Uint32) strnlen(string, MAX_STRING_LENGTH);
+
+                memcpy(output, &length, sizeof(length));
+                memcpy(output + sizeof(length), string, length);
+                output += sizeof(length) + length;
+
+                continue ;
+
+            default:
+                continue ;
+        }
+
+        memcpy(output, &wide, sizeof(wide));
+        output += sizeof(wide);
+    }
+}
+
+/* ================================================================ */
+/* ============== Definitions of external functions =============== */
+/* ================================================================ */
+
+int Binlog_open(const char* name) {
+
+    Uint32 version = BINLOG_VERSION;
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+
+    /* ================ */
+
+    if ((name == NULL) || atomic_load(&binlog_state.open)) {
+        return -1;
+    }
+
+    if ((binlog_state.file = fopen(name, "wb")) == NULL) {
+
+        error(stderr, "%s (%s%s%s)\n", strerror(errno), CYAN, name, WHITE);
+
+        return -1;
+    }
+
+    if ((binlog_state.lock = SDL_CreateMutex()) == NULL) {
+        fclose(binlog_state.file);
+        binlog_state.file = NULL;
+
+        return -1;
+    }
+
+    fwrite(BINLOG_MAGIC, 1, sizeof(BINLOG_MAGIC) - 1, binlog_state.file);
+    fwrite(&version, sizeof(version), 1, binlog_state.file);
+    fwrite(&frequency, sizeof(frequency), 1, binlog_state.file);
+
+    binlog_state.buffers = NULL;
+    binlog_state.threads = 0;
+    binlog_state.formats = 0;
+
+    atomic_fetch_add(&binlog_state.generation, 1);
+    atomic_store(&binlog_state.open, 1);
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+void Binlog_close(void) {
+
+    struct binlog_buffer* next;
+
+    /* ================ */
+
+    if (!atomic_load(&binlog_state.open)) {
+        return ;
+    }
+
+    atomic_store(&binlog_state.open, 0);
+
+    for (struct binlog_buffer* buffer = binlog_state.buffers; buffer != NULL; buffer = next) {
+
+        next = buffer->next;
+
+        write_buffer(buffer);
+
+        free(buffer->data);
+        free(buffer);
+    }
+
+    fclose(binlog_state.file);
+    SDL_DestroyMutex(binlog_state.lock);
+
+    binlog_state.file = NULL;
+    binlog_state.lock = NULL;
+    binlog_state.buffers = NULL;
+
+    local_buffer = NULL;
+}
+
+/* ================================================================ */
+
+void Binlog_flush(void) {
+
+    int generation = atomic_load(&binlog_state.generation);
+
+    /* ================ */
+
+    if (!atomic_load(&binlog_state.open) || (local_buffer == NULL) || (local_generation != generation)) {
+        return ;
+    }
+
+    SDL_LockMutex(binlog_state.lock);
+
+    write_buffer(local_buffer);
+    fflush(binlog_state.file);
+
+    SDL_UnlockMutex(binlog_state.lock);
+}
+
+/* ================================================================ */
+
+void Binlog_write(Binlog_Site* site, const char* format, ...) {
+
+    struct binlog_buffer* buffer;
+    int generation;
+    size_t size;
+
+    va_list args;
+
+    /* ================ */
+
+    if (!atomic_load_explicit(&binlog_state.open, memory_order_relaxed) || (site == NULL) || (format == NULL)) {
+        return ;
+    }
+
+    generation = atomic_load(&binlog_state.generation);
+
+    /* ================================================ */
+    /* == Registering the format the first time the === */
+    /* == call site runs for the current log ========== */
+    /* ================================================ */
+
+    if (SDL_AtomicGet(&site->generation) != generation) {
+
+        int status;
+
+        SDL_LockMutex(binlog_state.lock);
+        status = register_site(site, format, generation);
+        SDL_UnlockMutex(binlog_state.lock);
+
+        if (status != 0) {
+            return ;
+        }
+    }
+    else if (site->rejected) {
+        return ;
+    }
+
+    if ((buffer = thread_buffer(generation)) == NULL) {
+        return ;
+    }
+
+    /* ================================================ */
+    /* ============== Recording the values ============ */
+    /* ================================================ */
+
+    va_start(args, format);
+    size = record_size(site, args);
+    va_end(args);
+
+    if (buffer->used + size > BINLOG_BUFFER_SIZE) {
+
+        SDL_LockMutex(binlog_state.lock);
+        write_buffer(buffer);
+        SDL_UnlockMutex(binlog_state.lock);
+    }
+
+    va_start(args, format);
+    write_record(site, buffer->data + buffer->used, args);
+    va_end(args);
+
+    buffer->used += size;
+}
+
+/* ================================================================ */
+
+#undef MAX_STRING_LENGTH
+#undef RECORD_HEADER_SIZE
@@ -44,11 +44,18 @@
 #include <limits.h>
 #include <ctype.h>
 #include <float.h>
+#include <errno.h>
 
 #ifdef ENABLE_LOCALES
 #include <locale.h>
 #endif
 
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 #if defined(_MSC_VER)
 #pragma warning (pop)
 #endif
@@ -58,6 +65,11 @@
 
 #include "../../include/core/cJSON.h"
 
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#define CJSON_ATOMIC_INDEX
+#endif
+
 /* define our own boolean type */
 #ifdef true
 #undef true
@@ -121,237 +133,1802 @@ CJSON_PUBLIC(double) cJSON_GetNumberValue(const cJSON * const item)
     #error cJSON.h and cJSON.c have different versions. Make sure that both have the same.
 #endif
 
-CJSON_PUBLIC(const char*) cJSON_Version(void)
+CJSON_PUBLIC(const char*) cJSON_Version(void)
+{
+    static char version[15];
+    sprintf(version, "%i.%i.%i", CJSON_VERSION_MAJOR, CJSON_VERSION_MINOR, CJSON_VERSION_PATCH);
+
+    return version;
+}
+
+/* Case insensitive string comparison, doesn't consider two NULL pointers equal though */
+static int case_insensitive_strcmp(const unsigned char *string1, const unsigned char *string2)
+{
+    if ((string1 == NULL) || (string2 == NULL))
+    {
+        return 1;
+    }
+
+    if (string1 == string2)
+    {
+        return 0;
+    }
+
+    for(; tolower(*string1) == tolower(*string2); (void)string1++, string2++)
+    {
+        if (*string1 == '\0')
+        {
+            return 0;
+        }
+    }
+
+    return tolower(*string1) - tolower(*string2);
+}
+
+typedef struct internal_hooks
+{
+    void *(CJSON_CDECL *allocate)(size_t size);
+    void (CJSON_CDECL *deallocate)(void *pointer);
+    void *(CJSON_CDECL *reallocate)(void *pointer, size_t size);
+    /* when set, nodes and strings come from the arena of this document instead (see cJSON_ParseDocument) */
+    cJSON_Document *document;
+} internal_hooks;
+
+#if defined(_MSC_VER)
+/* work around MSVC error C2322: '...' address of dllimport '...' is not static */
+static void * CJSON_CDECL internal_malloc(size_t size)
+{
+    return malloc(size);
+}
+static void CJSON_CDECL internal_free(void *pointer)
+{
+    free(pointer);
+}
+static void * CJSON_CDECL internal_realloc(void *pointer, size_t size)
+{
+    return realloc(pointer, size);
+}
+#else
+#define internal_malloc malloc
+#define internal_free free
+#define internal_realloc realloc
+#endif
+
+/* strlen of character literals resolved at compile time */
+#define static_strlen(string_literal) (sizeof(string_literal) - sizeof(""))
+
+static internal_hooks global_hooks = { internal_malloc, internal_free, internal_realloc, NULL };
+
+static unsigned char* cJSON_strdup(const unsigned char* string, const internal_hooks * const hooks)
+{
+    size_t length = 0;
+    unsigned char *copy = NULL;
+
+    if (string == NULL)
+    {
+        return NULL;
+    }
+
+    length = strlen((const char*)string) + sizeof("");
+    copy = (unsigned char*)hooks->allocate(length);
+    if (copy == NULL)
+    {
+        return NULL;
+    }
+    memcpy(copy, string, length);
+
+    return copy;
+}
+
+CJSON_PUBLIC(void) cJSON_InitHooks(cJSON_Hooks* hooks)
+{
+    if (hooks == NULL)
+    {
+        /* Reset hooks */
+        global_hooks.allocate = malloc;
+        global_hooks.deallocate = free;
+        global_hooks.reallocate = realloc;
+        return;
+    }
+
+    global_hooks.allocate = malloc;
+    if (hooks->malloc_fn != NULL)
+    {
+        global_hooks.allocate = hooks->malloc_fn;
+    }
+
+    global_hooks.deallocate = free;
+    if (hooks->free_fn != NULL)
+    {
+        global_hooks.deallocate = hooks->free_fn;
+    }
+
+    /* use realloc only if both free and malloc are used */
+    global_hooks.reallocate = NULL;
+    if ((global_hooks.allocate == malloc) && (global_hooks.deallocate == free))
+    {
+        global_hooks.reallocate = realloc;
+    }
+}
+
+/* The hash index of the keys of a large object, see get_object_item. */
+typedef struct
+{
+    cJSON *item;
+    size_t position; /* of the item in the list of children */
+    unsigned int hash;
+} object_index_entry;
+
+typedef struct
+{
+    size_t capacity; /* a power of two */
+    size_t unnamed; /* the position of the first child without a key, or (size_t)-1 */
+    object_index_entry entries[1];
+} object_index;
+
+/* The children of a large array (or object) in order, so they are reached by position without walking the list, see get_array_item. */
+typedef struct
+{
+    size_t count;
+    cJSON *items[1];
+} array_vector;
+
+/* Every node is allocated with room for the index of its keys and the vector of its children after the public struct, so the layout of cJSON does not change. */
+typedef struct
+{
+    cJSON item;
+#ifdef CJSON_ATOMIC_INDEX
+    _Atomic(object_index *) index;
+    _Atomic(array_vector *) vector;
+#else
+    object_index *index;
+    array_vector *vector;
+#endif
+    /* the document whose arena the node, its strings and its index live in, NULL for nodes allocated one by one */
+    cJSON_Document *document;
+} cJSON_node;
+
+/* A key stored once for every member that has it: its characters, its length and its hash (FNV-1a, with the case kept). */
+typedef struct
+{
+    const char *key;
+    size_t length;
+    unsigned int hash;
+} interned_key;
+
+/* The keys interned by a document or a context, in a hash table. */
+struct cJSON_KeyTable
+{
+    /* the keys and the slots come from the arena of a document, or from the allocator of a context */
+    internal_hooks hooks;
+    size_t capacity; /* a power of two, or 0 before the first key */
+    size_t count;
+    interned_key *slots;
+};
+
+/* A block of the arena of a document. */
+typedef struct document_chunk
+{
+    struct document_chunk *next;
+    size_t size;
+    size_t used;
+} document_chunk;
+
+struct cJSON_Document
+{
+    cJSON *root;
+    document_chunk *chunks;
+    /* the size of the next chunk */
+    size_t chunk_size;
+    /* each distinct key of the tree is stored once */
+    cJSON_KeyTable keys;
+#ifdef CJSON_ATOMIC_INDEX
+    /* lookups may build indexes from several threads */
+    atomic_flag lock;
+#endif
+};
+
+#define CJSON_ARENA_ALIGNMENT (sizeof(void*) * 2)
+#define CJSON_CHUNK_HEADER ((sizeof(document_chunk) + CJSON_ARENA_ALIGNMENT - 1) & ~(CJSON_ARENA_ALIGNMENT - 1))
+
+/* Bump allocation from the arena of a document. Chunks grow geometrically, so a document has few of them. */
+static void *document_allocate(cJSON_Document * const document, size_t size)
+{
+    document_chunk *chunk = document->chunks;
+    unsigned char *memory = NULL;
+
+    size = (size + CJSON_ARENA_ALIGNMENT - 1) & ~(CJSON_ARENA_ALIGNMENT - 1);
+
+    if ((chunk == NULL) || (chunk->size - chunk->used < size))
+    {
+        size_t chunk_size = document->chunk_size;
+
+        while (chunk_size < size)
+        {
+            chunk_size *= 2;
+        }
+
+        chunk = (document_chunk*)global_hooks.allocate(CJSON_CHUNK_HEADER + chunk_size);
+        if (chunk == NULL)
+        {
+            return NULL;
+        }
+
+        chunk->next = document->chunks;
+        chunk->size = chunk_size;
+        chunk->used = 0;
+
+        document->chunks = chunk;
+        document->chunk_size = chunk_size * 2;
+    }
+
+    memory = (unsigned char*)chunk + CJSON_CHUNK_HEADER + chunk->used;
+    chunk->used += size;
+
+    return memory;
+}
+
+static void *hooks_allocate(const internal_hooks * const hooks, size_t size)
+{
+    if (hooks->document != NULL)
+    {
+        return document_allocate(hooks->document, size);
+    }
+
+    return hooks->allocate(size);
+}
+
+/* Memory from the arena of a document is only released with the document. */
+static void hooks_deallocate(const internal_hooks * const hooks, void *pointer)
+{
+    if (hooks->document == NULL)
+    {
+        hooks->deallocate(pointer);
+    }
+}
+
+#define node_of(item) ((cJSON_node*)cast_away_const(item))
+
+static void *cast_away_const(const void* string);
+
+/* true if the memory of the node and of its strings was allocated one block at a time, and is freed that way */
+#define owns_memory(item) (node_of(item)->document == NULL)
+
+/* Memory that lives as long as the node: from the arena of its document (several threads may be reading the tree), or from the global hooks. */
+static void *node_allocate(const cJSON * const item, size_t size)
+{
+    cJSON_Document *document = node_of(item)->document;
+    void *memory = NULL;
+
+    if (document == NULL)
+    {
+        return global_hooks.allocate(size);
+    }
+
+#ifdef CJSON_ATOMIC_INDEX
+    while (atomic_flag_test_and_set_explicit(&document->lock, memory_order_acquire))
+    {
+    }
+#endif
+
+    memory = document_allocate(document, size);
+
+#ifdef CJSON_ATOMIC_INDEX
+    atomic_flag_clear_explicit(&document->lock, memory_order_release);
+#endif
+
+    return memory;
+}
+
+/* A copy of a string for the valuestring or key of a node, freed with it. */
+static char *node_strdup(const cJSON * const item, const char * const string)
+{
+    size_t length = strlen(string) + sizeof("");
+    char *copy = (char*)node_allocate(item, length);
+
+    if (copy != NULL)
+    {
+        memcpy(copy, string, length);
+    }
+
+    return copy;
+}
+
+/* Internal constructor. */
+static cJSON *cJSON_New_Item(const internal_hooks * const hooks)
+{
+    cJSON_node* node = (cJSON_node*)hooks_allocate(hooks, sizeof(cJSON_node));
+    if (node)
+    {
+        memset(node, '\0', sizeof(cJSON_node));
+        node->document = hooks->document;
+    }
+
+    return (cJSON*)node;
+}
+
+static object_index *load_index(const cJSON *object)
+{
+#ifdef CJSON_ATOMIC_INDEX
+    return atomic_load_explicit(&node_of(object)->index, memory_order_acquire);
+#else
+    return node_of(object)->index;
+#endif
+}
+
+static array_vector *load_vector(const cJSON *array)
+{
+#ifdef CJSON_ATOMIC_INDEX
+    return atomic_load_explicit(&node_of(array)->vector, memory_order_acquire);
+#else
+    return node_of(array)->vector;
+#endif
+}
+
+/* Drops the index and the vector of an array or object whose children change. */
+static void invalidate_index(cJSON *object)
+{
+    object_index *index = NULL;
+    array_vector *vector = NULL;
+
+    if (object == NULL)
+    {
+        return;
+    }
+
+#ifdef CJSON_ATOMIC_INDEX
+    index = atomic_exchange_explicit(&node_of(object)->index, NULL, memory_order_acq_rel);
+    vector = atomic_exchange_explicit(&node_of(object)->vector, NULL, memory_order_acq_rel);
+#else
+    index = node_of(object)->index;
+    node_of(object)->index = NULL;
+    vector = node_of(object)->vector;
+    node_of(object)->vector = NULL;
+#endif
+
+    if ((index != NULL) && owns_memory(object))
+    {
+        global_hooks.deallocate(index);
+    }
+    if ((vector != NULL) && owns_memory(object))
+    {
+        global_hooks.deallocate(vector);
+    }
+}
+
+/* Frees a tree with the hooks it was allocated with. The key indexes always come from the global hooks. */
+static void delete_with_hooks(cJSON *item, const internal_hooks * const hooks)
+{
+    cJSON *next = NULL;
+    while (item != NULL)
+    {
+        next = item->next;
+        if (!owns_memory(item))
+        {
+            /* the node belongs to a document, which releases its whole arena at once */
+            item = next;
+            continue;
+        }
+        if (!(item->type & cJSON_IsReference) && (item->child != NULL))
+        {
+            delete_with_hooks(item->child, hooks);
+        }
+        if (!(item->type & cJSON_IsReference) && (item->valuestring != NULL))
+        {
+            hooks->deallocate(item->valuestring);
+        }
+        if (!(item->type & cJSON_StringIsConst) && (item->string != NULL))
+        {
+            hooks->deallocate(item->string);
+        }
+        invalidate_index(item);
+        hooks->deallocate(item);
+        item = next;
+    }
+}
+
+/* Delete a cJSON structure. */
+CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
+{
+    delete_with_hooks(item, &global_hooks);
+}
+
+/* Kernels that classify the input many bytes at a time. Each returns the number of bytes before the first one it stops at,
+ * or length if there is none, and never reads past length. */
+typedef struct
+{
+    /* stops at the first byte that is not whitespace (everything up to the space counts as whitespace, as it always has) */
+    size_t (*whitespace)(const unsigned char *input, size_t length);
+    /* stops at the first quote, backslash, control character or non-ASCII byte in a string literal */
+    size_t (*string)(const unsigned char *input, size_t length);
+} scan_kernels;
+
+static size_t scalar_whitespace(const unsigned char *input, size_t length)
+{
+    size_t i = 0;
+
+    while ((i < length) && (input[i] <= 32))
+    {
+        i++;
+    }
+
+    return i;
+}
+
+static size_t scalar_string(const unsigned char *input, size_t length)
+{
+    size_t i = 0;
+
+    while ((i < length) && (input[i] != '\"') && (input[i] != '\\') && (input[i] >= 0x20) && (input[i] < 0x80))
+    {
+        i++;
+    }
+
+    return i;
+}
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define CJSON_SCAN_SSE2
+#include <emmintrin.h>
+
+#if defined(__GNUC__)
+#define ctz(mask) ((size_t)__builtin_ctz(mask))
+#else
+#include <intrin.h>
+static size_t ctz(unsigned int mask)
+{
+    unsigned long index = 0;
+    _BitScanForward(&index, mask);
+    return (size_t)index;
+}
+#endif
+
+/* bytes <= 32 are exactly the ones where max(byte, 32) == 32 */
+static size_t sse2_whitespace(const unsigned char *input, size_t length)
+{
+    const __m128i space = _mm_set1_epi8(32);
+    size_t i = 0;
+
+    for (; (i + 16) <= length; i += 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(const void*)(input + i));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(chunk, space), space)) ^ 0xFFFFu;
+        if (mask != 0)
+        {
+            return i + ctz(mask);
+        }
+    }
+
+    return i + scalar_whitespace(input + i, length - i);
+}
+
+/* control characters are the bytes where min(byte, 31) == byte, non-ASCII bytes have their sign bit set */
+static size_t sse2_string(const unsigned char *input, size_t length)
+{
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(31);
+    size_t i = 0;
+
+    for (; (i + 16) <= length; i += 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(const void*)(input + i));
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash));
+        unsigned int mask = 0;
+
+        special = _mm_or_si128(special, _mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk));
+        mask = (unsigned int)(_mm_movemask_epi8(special) | _mm_movemask_epi8(chunk));
+        if (mask != 0)
+        {
+            return i + ctz(mask);
+        }
+    }
+
+    return i + scalar_string(input + i, length - i);
+}
+
+static const scan_kernels sse2_kernels = { sse2_whitespace, sse2_string };
+
+/* AVX2 is compiled for its own functions only, and used if the CPU running the program has it */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CJSON_SCAN_AVX2
+#include <immintrin.h>
+
+__attribute__((target("avx2")))
+static size_t avx2_whitespace(const unsigned char *input, size_t length)
+{
+    const __m256i space = _mm256_set1_epi8(32);
+    size_t i = 0;
+
+    for (; (i + 32) <= length; i += 32)
+    {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)(const void*)(input + i));
+        unsigned int mask = ~(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(chunk, space), space));
+        if (mask != 0)
+        {
+            return i + ctz(mask);
+        }
+    }
+
+    return i + sse2_whitespace(input + i, length - i);
+}
+
+__attribute__((target("avx2")))
+static size_t avx2_string(const unsigned char *input, size_t length)
+{
+    const __m256i quote = _mm256_set1_epi8('\"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(31);
+    size_t i = 0;
+
+    for (; (i + 32) <= length; i += 32)
+    {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)(const void*)(input + i));
+        __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash));
+        unsigned int mask = 0;
+
+        special = _mm256_or_si256(special, _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, control), chunk));
+        mask = (unsigned int)_mm256_movemask_epi8(special) | (unsigned int)_mm256_movemask_epi8(chunk);
+        if (mask != 0)
+        {
+            return i + ctz(mask);
+        }
+    }
+
+    return i + sse2_string(input + i, length - i);
+}
+
+static const scan_kernels avx2_kernels = { avx2_whitespace, avx2_string };
+#endif
+#endif
+
+/* The widest kernels the CPU running the program supports. */
+static const scan_kernels *select_scan_kernels(void)
+{
+#ifdef CJSON_SCAN_AVX2
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return &avx2_kernels;
+    }
+#endif
+#ifdef CJSON_SCAN_SSE2
+    return &sse2_kernels;
+#else
+    static const scan_kernels scalar_kernels = { scalar_whitespace, scalar_string };
+    return &scalar_kernels;
+#endif
+}
+
+typedef struct
+{
+    const unsigned char *content;
+    size_t length;
+    size_t offset;
+    size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
+    size_t nesting_limit; /* the depth at which it stops, CJSON_NESTING_LIMIT unless a context says otherwise */
+    size_t pack_threshold; /* see cJSON_Context */
+    cJSON_KeyTable *keys; /* where the keys are interned, or NULL to copy each of them */
+    internal_hooks hooks;
+    const scan_kernels *scan;
+} parse_buffer;
+
+/* check if the given size is left to read in a given parse buffer (starting with 1) */
+#define can_read(buffer, size) ((buffer != NULL) && (((buffer)->offset + size) <= (buffer)->length))
+/* check if the buffer can be accessed at the given index (starting with 0) */
+#define can_access_at_index(buffer, index) ((buffer != NULL) && (((buffer)->offset + index) < (buffer)->length))
+#define cannot_access_at_index(buffer, index) (!can_access_at_index(buffer, index))
+/* get a pointer to the buffer at the position */
+#define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
+
+/* Locale-free conversions between decimal text and doubles.
+ * Parsing uses the Eisel-Lemire algorithm, which decides almost every number with one or two 64x64-bit multiplications;
+ * the rare numbers it cannot decide (more than 19 significant digits, exact halfway cases, subnormals) go through
+ * an exact conversion on the decimal digits. Printing uses Grisu2, which gives the shortest (or nearly) digits that read back
+ * to the same double. */
+
+/* 128-bit approximations of 5^q, for q from CJSON_SMALLEST_POWER to CJSON_LARGEST_POWER, high then low 64 bits, normalized so the top bit is set
+ * (truncated for q >= 0, rounded up for q < 0). */
+#define CJSON_SMALLEST_POWER -342
+#define CJSON_LARGEST_POWER 308
+static const unsigned long long powers_of_five[CJSON_LARGEST_POWER - CJSON_SMALLEST_POWER + 1][2] = {
+    { 0xEEF453D6923BD65A, 0x113FAA2906A13B3F }, { 0x9558B4661B6565F8, 0x4AC7CA59A424C507 },
+    { 0xBAAEE17FA23EBF76, 0x5D79BCF00D2DF649 }, { 0xE95A99DF8ACE6F53, 0xF4D82C2C107973DC },
+    { 0x91D8A02BB6C10594, 0x79071B9B8A4BE869 }, { 0xB64EC836A47146F9, 0x9748E2826CDEE284 },
+    { 0xE3E27A444D8D98B7, 0xFD1B1B2308169B25 }, { 0x8E6D8C6AB0787F72, 0xFE30F0F5E50E20F7 },
+    { 0xB208EF855C969F4F, 0xBDBD2D335E51A935 }, { 0xDE8B2B66B3BC4723, 0xAD2C788035E61382 },
+    { 0x8B16FB203055AC76, 0x4C3BCB5021AFCC31 }, { 0xADDCB9E83C6B1793, 0xDF4ABE242A1BBF3D },
+    { 0xD953E8624B85DD78, 0xD71D6DAD34A2AF0D }, { 0x87D4713D6F33AA6B, 0x8672648C40E5AD68 },
+    { 0xA9C98D8CCB009506, 0x680EFDAF511F18C2 }, { 0xD43BF0EFFDC0BA48, 0x0212BD1B2566DEF2 },
+    { 0x84A57695FE98746D, 0x014BB630F7604B57 }, { 0xA5CED43B7E3E9188, 0x419EA3BD35385E2D },
+    { 0xCF42894A5DCE35EA, 0x52064CAC828675B9 }, { 0x818995CE7AA0E1B2, 0x7343EFEBD1940993 },
+    { 0xA1EBFB4219491A1F, 0x1014EBE6C5F90BF8 }, { 0xCA66FA129F9B60A6, 0xD41A26E077774EF6 },
+    { 0xFD00B897478238D0, 0x8920B098955522B4 }, { 0x9E20735E8CB16382, 0x55B46E5F5D5535B0 },
+    { 0xC5A890362FDDBC62, 0xEB2189F734AA831D }, { 0xF712B443BBD52B7B, 0xA5E9EC7501D523E4 },
+    { 0x9A6BB0AA55653B2D, 0x47B233C92125366E }, { 0xC1069CD4EABE89F8, 0x999EC0BB696E840A },
+    { 0xF148440A256E2C76, 0xC00670EA43CA250D }, { 0x96CD2A865764DBCA, 0x380406926A5E5728 },
+    { 0xBC807527ED3E12BC, 0xC605083704F5ECF2 }, { 0xEBA09271E88D976B, 0xF7864A44C633682E },
+    { 0x93445B8731587EA3, 0x7AB3EE6AFBE0211D }, { 0xB8157268FDAE9E4C, 0x5960EA05BAD82964 },
+    { 0xE61ACF033D1A45DF, 0x6FB92487298E33BD }, { 0x8FD0C16206306BAB, 0xA5D3B6D479F8E056 },
+    { 0xB3C4F1BA87BC8696, 0x8F48A4899877186C }, { 0xE0B62E2929ABA83C, 0x331ACDABFE94DE87 },
+    { 0x8C71DCD9BA0B4925, 0x9FF0C08B7F1D0B14 }, { 0xAF8E5410288E1B6F, 0x07ECF0AE5EE44DD9 },
+    { 0xDB71E91432B1A24A, 0xC9E82CD9F69D6150 }, { 0x892731AC9FAF056E, 0xBE311C083A225CD2 },
+    { 0xAB70FE17C79AC6CA, 0x6DBD630A48AAF406 }, { 0xD64D3D9DB981787D, 0x092CBBCCDAD5B108 },
+    { 0x85F0468293F0EB4E, 0x25BBF56008C58EA5 }, { 0xA76C582338ED2621, 0xAF2AF2B80AF6F24E },
+    { 0xD1476E2C07286FAA, 0x1AF5AF660DB4AEE1 }, { 0x82CCA4DB847945CA, 0x50D98D9FC890ED4D },
+    { 0xA37FCE126597973C, 0xE50FF107BAB528A0 }, { 0xCC5FC196FEFD7D0C, 0x1E53ED49A96272C8 },
+    { 0xFF77B1FCBEBCDC4F, 0x25E8E89C13BB0F7A }, { 0x9FAACF3DF73609B1, 0x77B191618C54E9AC },
+    { 0xC795830D75038C1D, 0xD59DF5B9EF6A2417 }, { 0xF97AE3D0D2446F25, 0x4B0573286B44AD1D },
+    { 0x9BECCE62836AC577, 0x4EE367F9430AEC32 }, { 0xC2E801FB244576D5, 0x229C41F793CDA73F },
+    { 0xF3A20279ED56D48A, 0x6B43527578C1110F }, { 0x9845418C345644D6, 0x830A13896B78AAA9 },
+    { 0xBE5691EF416BD60C, 0x23CC986BC656D553 }, { 0xEDEC366B11C6CB8F, 0x2CBFBE86B7EC8AA8 },
+    { 0x94B3A202EB1C3F39, 0x7BF7D71432F3D6A9 }, { 0xB9E08A83A5E34F07, 0xDAF5CCD93FB0CC53 },
+    { 0xE858AD248F5C22C9, 0xD1B3400F8F9CFF68 }, { 0x91376C36D99995BE, 0x23100809B9C21FA1 },
+    { 0xB58547448FFFFB2D, 0xABD40A0C2832A78A }, { 0xE2E69915B3FFF9F9, 0x16C90C8F323F516C },
+    { 0x8DD01FAD907FFC3B, 0xAE3DA7D97F6792E3 }, { 0xB1442798F49FFB4A, 0x99CD11CFDF41779C },
+    { 0xDD95317F31C7FA1D, 0x40405643D711D583 }, { 0x8A7D3EEF7F1CFC52, 0x482835EA666B2572 },
+    { 0xAD1C8EAB5EE43B66, 0xDA3243650005EECF }, { 0xD863B256369D4A40, 0x90BED43E40076A82 },
+    { 0x873E4F75E2224E68, 0x5A7744A6E804A291 }, { 0xA90DE3535AAAE202, 0x711515D0A205CB36 },
+    { 0xD3515C2831559A83, 0x0D5A5B44CA873E03 }, { 0x8412D9991ED58091, 0xE858790AFE9486C2 },
+    { 0xA5178FFF668AE0B6, 0x626E974DBE39A872 }, { 0xCE5D73FF402D98E3, 0xFB0A3D212DC8128F },
+    { 0x80FA687F881C7F8E, 0x7CE66634BC9D0B99 }, { 0xA139029F6A239F72, 0x1C1FFFC1EBC44E80 },
+    { 0xC987434744AC874E, 0xA327FFB266B56220 }, { 0xFBE9141915D7A922, 0x4BF1FF9F0062BAA8 },
+    { 0x9D71AC8FADA6C9B5, 0x6F773FC3603DB4A9 }, { 0xC4CE17B399107C22, 0xCB550FB4384D21D3 },
+    { 0xF6019DA07F549B2B, 0x7E2A53A146606A48 }, { 0x99C102844F94E0FB, 0x2EDA7444CBFC426D },
+    { 0xC0314325637A1939, 0xFA911155FEFB5308 }, { 0xF03D93EEBC589F88, 0x793555AB7EBA27CA },
+    { 0x96267C7535B763B5, 0x4BC1558B2F3458DE }, { 0xBBB01B9283253CA2, 0x9EB1AAEDFB016F16 },
+    { 0xEA9C227723EE8BCB, 0x465E15A979C1CADC }, { 0x92A1958A7675175F, 0x0BFACD89EC191EC9 },
+    { 0xB749FAED14125D36, 0xCEF980EC671F667B }, { 0xE51C79A85916F484, 0x82B7E12780E7401A },
+    { 0x8F31CC0937AE58D2, 0xD1B2ECB8B0908810 }, { 0xB2FE3F0B8599EF07, 0x861FA7E6DCB4AA15 },
+    { 0xDFBDCECE67006AC9, 0x67A791E093E1D49A }, { 0x8BD6A141006042BD, 0xE0C8BB2C5C6D24E0 },
+    { 0xAECC49914078536D, 0x58FAE9F773886E18 }, { 0xDA7F5BF590966848, 0xAF39A475506A899E },
+    { 0x888F99797A5E012D, 0x6D8406C952429603 }, { 0xAAB37FD7D8F58178, 0xC8E5087BA6D33B83 },
+    { 0xD5605FCDCF32E1D6, 0xFB1E4A9A90880A64 }, { 0x855C3BE0A17FCD26, 0x5CF2EEA09A55067F },
+    { 0xA6B34AD8C9DFC06F, 0xF42FAA48C0EA481E }, { 0xD0601D8EFC57B08B, 0xF13B94DAF124DA26 },
+    { 0x823C12795DB6CE57, 0x76C53D08D6B70858 }, { 0xA2CB1717B52481ED, 0x54768C4B0C64CA6E },
+    { 0xCB7DDCDDA26DA268, 0xA9942F5DCF7DFD09 }, { 0xFE5D54150B090B02, 0xD3F93B35435D7C4C },
+    { 0x9EFA548D26E5A6E1, 0xC47BC5014A1A6DAF }, { 0xC6B8E9B0709F109A, 0x359AB6419CA1091B },
+    { 0xF867241C8CC6D4C0, 0xC30163D203C94B62 }, { 0x9B407691D7FC44F8, 0x79E0DE63425DCF1D },
+    { 0xC21094364DFB5636, 0x985915FC12F542E4 }, { 0xF294B943E17A2BC4, 0x3E6F5B7B17B2939D },
+    { 0x979CF3CA6CEC5B5A, 0xA705992CEECF9C42 }, { 0xBD8430BD08277231, 0x50C6FF782A838353 },
+    { 0xECE53CEC4A314EBD, 0xA4F8BF5635246428 }, { 0x940F4613AE5ED136, 0x871B7795E136BE99 },
+    { 0xB913179899F68584, 0x28E2557B59846E3F }, { 0xE757DD7EC07426E5, 0x331AEADA2FE589CF },
+    { 0x9096EA6F3848984F, 0x3FF0D2C85DEF7621 }, { 0xB4BCA50B065ABE63, 0x0FED077A756B53A9 },
+    { 0xE1EBCE4DC7F16DFB, 0xD3E8495912C62894 }, { 0x8D3360F09CF6E4BD, 0x64712DD7ABBBD95C },
+    { 0xB080392CC4349DEC, 0xBD8D794D96AACFB3 }, { 0xDCA04777F541C567, 0xECF0D7A0FC5583A0 },
+    { 0x89E42CAAF9491B60, 0xF41686C49DB57244 }, { 0xAC5D37D5B79B6239, 0x311C2875C522CED5 },
+    { 0xD77485CB25823AC7, 0x7D633293366B828B }, { 0x86A8D39EF77164BC, 0xAE5DFF9C02033197 },
+    { 0xA8530886B54DBDEB, 0xD9F57F830283FDFC }, { 0xD267CAA862A12D66, 0xD072DF63C324FD7B },
+    { 0x8380DEA93DA4BC60, 0x4247CB9E59F71E6D }, { 0xA46116538D0DEB78, 0x52D9BE85F074E608 },
+    { 0xCD795BE870516656, 0x67902E276C921F8B }, { 0x806BD9714632DFF6, 0x00BA1CD8A3DB53B6 },
+    { 0xA086CFCD97BF97F3, 0x80E8A40ECCD228A4 }, { 0xC8A883C0FDAF7DF0, 0x6122CD128006B2CD },
+    { 0xFAD2A4B13D1B5D6C, 0x796B805720085F81 }, { 0x9CC3A6EEC6311A63, 0xCBE3303674053BB0 },
+    { 0xC3F490AA77BD60FC, 0xBEDBFC4411068A9C }, { 0xF4F1B4D515ACB93B, 0xEE92FB5515482D44 },
+    { 0x991711052D8BF3C5, 0x751BDD152D4D1C4A }, { 0xBF5CD54678EEF0B6, 0xD262D45A78A0635D },
+    { 0xEF340A98172AACE4, 0x86FB897116C87C34 }, { 0x9580869F0E7AAC0E, 0xD45D35E6AE3D4DA0 },
+    { 0xBAE0A846D2195712, 0x8974836059CCA109 }, { 0xE998D258869FACD7, 0x2BD1A438703FC94B },
+    { 0x91FF83775423CC06, 0x7B6306A34627DDCF }, { 0xB67F6455292CBF08, 0x1A3BC84C17B1D542 },
+    { 0xE41F3D6A7377EECA, 0x20CABA5F1D9E4A93 }, { 0x8E938662882AF53E, 0x547EB47B7282EE9C },
+    { 0xB23867FB2A35B28D, 0xE99E619A4F23AA43 }, { 0xDEC681F9F4C31F31, 0x6405FA00E2EC94D4 },
+    { 0x8B3C113C38F9F37E, 0xDE83BC408DD3DD04 }, { 0xAE0B158B4738705E, 0x9624AB50B148D445 },
+    { 0xD98DDAEE19068C76, 0x3BADD624DD9B0957 }, { 0x87F8A8D4CFA417C9, 0xE54CA5D70A80E5D6 },
+    { 0xA9F6D30A038D1DBC, 0x5E9FCF4CCD211F4C }, { 0xD47487CC8470652B, 0x7647C3200069671F },
+    { 0x84C8D4DFD2C63F3B, 0x29ECD9F40041E073 }, { 0xA5FB0A17C777CF09, 0xF468107100525890 },
+    { 0xCF79CC9DB955C2CC, 0x7182148D4066EEB4 }, { 0x81AC1FE293D599BF, 0xC6F14CD848405530 },
+    { 0xA21727DB38CB002F, 0xB8ADA00E5A506A7C }, { 0xCA9CF1D206FDC03B, 0xA6D90811F0E4851C },
+    { 0xFD442E4688BD304A, 0x908F4A166D1DA663 }, { 0x9E4A9CEC15763E2E, 0x9A598E4E043287FE },
+    { 0xC5DD44271AD3CDBA, 0x40EFF1E1853F29FD }, { 0xF7549530E188C128, 0xD12BEE59E68EF47C },
+    { 0x9A94DD3E8CF578B9, 0x82BB74F8301958CE }, { 0xC13A148E3032D6E7, 0xE36A52363C1FAF01 },
+    { 0xF18899B1BC3F8CA1, 0xDC44E6C3CB279AC1 }, { 0x96F5600F15A7B7E5, 0x29AB103A5EF8C0B9 },
+    { 0xBCB2B812DB11A5DE, 0x7415D448F6B6F0E7 }, { 0xEBDF661791D60F56, 0x111B495B3464AD21 },
+    { 0x936B9FCEBB25C995, 0xCAB10DD900BEEC34 }, { 0xB84687C269EF3BFB, 0x3D5D514F40EEA742 },
+    { 0xE65829B3046B0AFA, 0x0CB4A5A3112A5112 }, { 0x8FF71A0FE2C2E6DC, 0x47F0E785EABA72AB },
+    { 0xB3F4E093DB73A093, 0x59ED216765690F56 }, { 0xE0F218B8D25088B8, 0x306869C13EC3532C },
+    { 0x8C974F7383725573, 0x1E414218C73A13FB }, { 0xAFBD2350644EEACF, 0xE5D1929EF90898FA },
+    { 0xDBAC6C247D62A583, 0xDF45F746B74ABF39 }, { 0x894BC396CE5DA772, 0x6B8BBA8C328EB783 },
+    { 0xAB9EB47C81F5114F, 0x066EA92F3F326564 }, { 0xD686619BA27255A2, 0xC80A537B0EFEFEBD },
+    { 0x8613FD0145877585, 0xBD06742CE95F5F36 }, { 0xA798FC4196E952E7, 0x2C48113823B73704 },
+    { 0xD17F3B51FCA3A7A0, 0xF75A15862CA504C5 }, { 0x82EF85133DE648C4, 0x9A984D73DBE722FB },
+    { 0xA3AB66580D5FDAF5, 0xC13E60D0D2E0EBBA }, { 0xCC963FEE10B7D1B3, 0x318DF905079926A8 },
+    { 0xFFBBCFE994E5C61F, 0xFDF17746497F7052 }, { 0x9FD561F1FD0F9BD3, 0xFEB6EA8BEDEFA633 },
+    { 0xC7CABA6E7C5382C8, 0xFE64A52EE96B8FC0 }, { 0xF9BD690A1B68637B, 0x3DFDCE7AA3C673B0 },
+    { 0x9C1661A651213E2D, 0x06BEA10CA65C084E }, { 0xC31BFA0FE5698DB8, 0x486E494FCFF30A62 },
+    { 0xF3E2F893DEC3F126, 0x5A89DBA3C3EFCCFA }, { 0x986DDB5C6B3A76B7, 0xF89629465A75E01C },
+    { 0xBE89523386091465, 0xF6BBB397F1135823 }, { 0xEE2BA6C0678B597F, 0x746AA07DED582E2C },
+    { 0x94DB483840B717EF, 0xA8C2A44EB4571CDC }, { 0xBA121A4650E4DDEB, 0x92F34D62616CE413 },
+    { 0xE896A0D7E51E1566, 0x77B020BAF9C81D17 }, { 0x915E2486EF32CD60, 0x0ACE1474DC1D122E },
+    { 0xB5B5ADA8AAFF80B8, 0x0D819992132456BA }, { 0xE3231912D5BF60E6, 0x10E1FFF697ED6C69 },
+    { 0x8DF5EFABC5979C8F, 0xCA8D3FFA1EF463C1 }, { 0xB1736B96B6FD83B3, 0xBD308FF8A6B17CB2 },
+    { 0xDDD0467C64BCE4A0, 0xAC7CB3F6D05DDBDE }, { 0x8AA22C0DBEF60EE4, 0x6BCDF07A423AA96B },
+    { 0xAD4AB7112EB3929D, 0x86C16C98D2C953C6 }, { 0xD89D64D57A607744, 0xE871C7BF077BA8B7 },
+    { 0x87625F056C7C4A8B, 0x11471CD764AD4972 }, { 0xA93AF6C6C79B5D2D, 0xD598E40D3DD89BCF },
+    { 0xD389B47879823479, 0x4AFF1D108D4EC2C3 }, { 0x843610CB4BF160CB, 0xCEDF722A585139BA },
+    { 0xA54394FE1EEDB8FE, 0xC2974EB4EE658828 }, { 0xCE947A3DA6A9273E, 0x733D226229FEEA32 },
+    { 0x811CCC668829B887, 0x0806357D5A3F525F }, { 0xA163FF802A3426A8, 0xCA07C2DCB0CF26F7 },
+    { 0xC9BCFF6034C13052, 0xFC89B393DD02F0B5 }, { 0xFC2C3F3841F17C67, 0xBBAC2078D443ACE2 },
+    { 0x9D9BA7832936EDC0, 0xD54B944B84AA4C0D }, { 0xC5029163F384A931, 0x0A9E795E65D4DF11 },
+    { 0xF64335BCF065D37D, 0x4D4617B5FF4A16D5 }, { 0x99EA0196163FA42E, 0x504BCED1BF8E4E45 },
+    { 0xC06481FB9BCF8D39, 0xE45EC2862F71E1D6 }, { 0xF07DA27A82C37088, 0x5D767327BB4E5A4C },
+    { 0x964E858C91BA2655, 0x3A6A07F8D510F86F }, { 0xBBE226EFB628AFEA, 0x890489F70A55368B },
+    { 0xEADAB0ABA3B2DBE5, 0x2B45AC74CCEA842E }, { 0x92C8AE6B464FC96F, 0x3B0B8BC90012929D },
+    { 0xB77ADA0617E3BBCB, 0x09CE6EBB40173744 }, { 0xE55990879DDCAABD, 0xCC420A6A101D0515 },
+    { 0x8F57FA54C2A9EAB6, 0x9FA946824A12232D }, { 0xB32DF8E9F3546564, 0x47939822DC96ABF9 },
+    { 0xDFF9772470297EBD, 0x59787E2B93BC56F7 }, { 0x8BFBEA76C619EF36, 0x57EB4EDB3C55B65A },
+    { 0xAEFAE51477A06B03, 0xEDE622920B6B23F1 }, { 0xDAB99E59958885C4, 0xE95FAB368E45ECED },
+    { 0x88B402F7FD75539B, 0x11DBCB0218EBB414 }, { 0xAAE103B5FCD2A881, 0xD652BDC29F26A119 },
+    { 0xD59944A37C0752A2, 0x4BE76D3346F0495F }, { 0x857FCAE62D8493A5, 0x6F70A4400C562DDB },
+    { 0xA6DFBD9FB8E5B88E, 0xCB4CCD500F6BB952 }, { 0xD097AD07A71F26B2, 0x7E2000A41346A7A7 },
+    { 0x825ECC24C873782F, 0x8ED400668C0C28C8 }, { 0xA2F67F2DFA90563B, 0x728900802F0F32FA },
+    { 0xCBB41EF979346BCA, 0x4F2B40A03AD2FFB9 }, { 0xFEA126B7D78186BC, 0xE2F610C84987BFA8 },
+    { 0x9F24B832E6B0F436, 0x0DD9CA7D2DF4D7C9 }, { 0xC6EDE63FA05D3143, 0x91503D1C79720DBB },
+    { 0xF8A95FCF88747D94, 0x75A44C6397CE912A }, { 0x9B69DBE1B548CE7C, 0xC986AFBE3EE11ABA },
+    { 0xC24452DA229B021B, 0xFBE85BADCE996168 }, { 0xF2D56790AB41C2A2, 0xFAE27299423FB9C3 },
+    { 0x97C560BA6B0919A5, 0xDCCD879FC967D41A }, { 0xBDB6B8E905CB600F, 0x5400E987BBC1C920 },
+    { 0xED246723473E3813, 0x290123E9AAB23B68 }, { 0x9436C0760C86E30B, 0xF9A0B6720AAF6521 },
+    { 0xB94470938FA89BCE, 0xF808E40E8D5B3E69 }, { 0xE7958CB87392C2C2, 0xB60B1D1230B20E04 },
+    { 0x90BD77F3483BB9B9, 0xB1C6F22B5E6F48C2 }, { 0xB4ECD5F01A4AA828, 0x1E38AEB6360B1AF3 },
+    { 0xE2280B6C20DD5232, 0x25C6DA63C38DE1B0 }, { 0x8D590723948A535F, 0x579C487E5A38AD0E },
+    { 0xB0AF48EC79ACE837, 0x2D835A9DF0C6D851 }, { 0xDCDB1B2798182244, 0xF8E431456CF88E65 },
+    { 0x8A08F0F8BF0F156B, 0x1B8E9ECB641B58FF }, { 0xAC8B2D36EED2DAC5, 0xE272467E3D222F3F },
+    { 0xD7ADF884AA879177, 0x5B0ED81DCC6ABB0F }, { 0x86CCBB52EA94BAEA, 0x98E947129FC2B4E9 },
+    { 0xA87FEA27A539E9A5, 0x3F2398D747B36224 }, { 0xD29FE4B18E88640E, 0x8EEC7F0D19A03AAD },
+    { 0x83A3EEEEF9153E89, 0x1953CF68300424AC }, { 0xA48CEAAAB75A8E2B, 0x5FA8C3423C052DD7 },
+    { 0xCDB02555653131B6, 0x3792F412CB06794D }, { 0x808E17555F3EBF11, 0xE2BBD88BBEE40BD0 },
+    { 0xA0B19D2AB70E6ED6, 0x5B6ACEAEAE9D0EC4 }, { 0xC8DE047564D20A8B, 0xF245825A5A445275 },
+    { 0xFB158592BE068D2E, 0xEED6E2F0F0D56712 }, { 0x9CED737BB6C4183D, 0x55464DD69685606B },
+    { 0xC428D05AA4751E4C, 0xAA97E14C3C26B886 }, { 0xF53304714D9265DF, 0xD53DD99F4B3066A8 },
+    { 0x993FE2C6D07B7FAB, 0xE546A8038EFE4029 }, { 0xBF8FDB78849A5F96, 0xDE98520472BDD033 },
+    { 0xEF73D256A5C0F77C, 0x963E66858F6D4440 }, { 0x95A8637627989AAD, 0xDDE7001379A44AA8 },
+    { 0xBB127C53B17EC159, 0x5560C018580D5D52 }, { 0xE9D71B689DDE71AF, 0xAAB8F01E6E10B4A6 },
+    { 0x9226712162AB070D, 0xCAB3961304CA70E8 }, { 0xB6B00D69BB55C8D1, 0x3D607B97C5FD0D22 },
+    { 0xE45C10C42A2B3B05, 0x8CB89A7DB77C506A }, { 0x8EB98A7A9A5B04E3, 0x77F3608E92ADB242 },
+    { 0xB267ED1940F1C61C, 0x55F038B237591ED3 }, { 0xDF01E85F912E37A3, 0x6B6C46DEC52F6688 },
+    { 0x8B61313BBABCE2C6, 0x2323AC4B3B3DA015 }, { 0xAE397D8AA96C1B77, 0xABEC975E0A0D081A },
+    { 0xD9C7DCED53C72255, 0x96E7BD358C904A21 }, { 0x881CEA14545C7575, 0x7E50D64177DA2E54 },
+    { 0xAA242499697392D2, 0xDDE50BD1D5D0B9E9 }, { 0xD4AD2DBFC3D07787, 0x955E4EC64B44E864 },
+    { 0x84EC3C97DA624AB4, 0xBD5AF13BEF0B113E }, { 0xA6274BBDD0FADD61, 0xECB1AD8AEACDD58E },
+    { 0xCFB11EAD453994BA, 0x67DE18EDA5814AF2 }, { 0x81CEB32C4B43FCF4, 0x80EACF948770CED7 },
+    { 0xA2425FF75E14FC31, 0xA1258379A94D028D }, { 0xCAD2F7F5359A3B3E, 0x096EE45813A04330 },
+    { 0xFD87B5F28300CA0D, 0x8BCA9D6E188853FC }, { 0x9E74D1B791E07E48, 0x775EA264CF55347E },
+    { 0xC612062576589DDA, 0x95364AFE032A819E }, { 0xF79687AED3EEC551, 0x3A83DDBD83F52205 },
+    { 0x9ABE14CD44753B52, 0xC4926A9672793543 }, { 0xC16D9A0095928A27, 0x75B7053C0F178294 },
+    { 0xF1C90080BAF72CB1, 0x5324C68B12DD6339 }, { 0x971DA05074DA7BEE, 0xD3F6FC16EBCA5E04 },
+    { 0xBCE5086492111AEA, 0x88F4BB1CA6BCF585 }, { 0xEC1E4A7DB69561A5, 0x2B31E9E3D06C32E6 },
+    { 0x9392EE8E921D5D07, 0x3AFF322E62439FD0 }, { 0xB877AA3236A4B449, 0x09BEFEB9FAD487C3 },
+    { 0xE69594BEC44DE15B, 0x4C2EBE687989A9B4 }, { 0x901D7CF73AB0ACD9, 0x0F9D37014BF60A11 },
+    { 0xB424DC35095CD80F, 0x538484C19EF38C95 }, { 0xE12E13424BB40E13, 0x2865A5F206B06FBA },
+    { 0x8CBCCC096F5088CB, 0xF93F87B7442E45D4 }, { 0xAFEBFF0BCB24AAFE, 0xF78F69A51539D749 },
+    { 0xDBE6FECEBDEDD5BE, 0xB573440E5A884D1C }, { 0x89705F4136B4A597, 0x31680A88F8953031 },
+    { 0xABCC77118461CEFC, 0xFDC20D2B36BA7C3E }, { 0xD6BF94D5E57A42BC, 0x3D32907604691B4D },
+    { 0x8637BD05AF6C69B5, 0xA63F9A49C2C1B110 }, { 0xA7C5AC471B478423, 0x0FCF80DC33721D54 },
+    { 0xD1B71758E219652B, 0xD3C36113404EA4A9 }, { 0x83126E978D4FDF3B, 0x645A1CAC083126EA },
+    { 0xA3D70A3D70A3D70A, 0x3D70A3D70A3D70A4 }, { 0xCCCCCCCCCCCCCCCC, 0xCCCCCCCCCCCCCCCD },
+    { 0x8000000000000000, 0x0000000000000000 }, { 0xA000000000000000, 0x0000000000000000 },
+    { 0xC800000000000000, 0x0000000000000000 }, { 0xFA00000000000000, 0x0000000000000000 },
+    { 0x9C40000000000000, 0x0000000000000000 }, { 0xC350000000000000, 0x0000000000000000 },
+    { 0xF424000000000000, 0x0000000000000000 }, { 0x9896800000000000, 0x0000000000000000 },
+    { 0xBEBC200000000000, 0x0000000000000000 }, { 0xEE6B280000000000, 0x0000000000000000 },
+    { 0x9502F90000000000, 0x0000000000000000 }, { 0xBA43B74000000000, 0x0000000000000000 },
+    { 0xE8D4A51000000000, 0x0000000000000000 }, { 0x9184E72A00000000, 0x0000000000000000 },
+    { 0xB5E620F480000000, 0x0000000000000000 }, { 0xE35FA931A0000000, 0x0000000000000000 },
+    { 0x8E1BC9BF04000000, 0x0000000000000000 }, { 0xB1A2BC2EC5000000, 0x0000000000000000 },
+    { 0xDE0B6B3A76400000, 0x0000000000000000 }, { 0x8AC7230489E80000, 0x0000000000000000 },
+    { 0xAD78EBC5AC620000, 0x0000000000000000 }, { 0xD8D726B7177A8000, 0x0000000000000000 },
+    { 0x878678326EAC9000, 0x0000000000000000 }, { 0xA968163F0A57B400, 0x0000000000000000 },
+    { 0xD3C21BCECCEDA100, 0x0000000000000000 }, { 0x84595161401484A0, 0x0000000000000000 },
+    { 0xA56FA5B99019A5C8, 0x0000000000000000 }, { 0xCECB8F27F4200F3A, 0x0000000000000000 },
+    { 0x813F3978F8940984, 0x4000000000000000 }, { 0xA18F07D736B90BE5, 0x5000000000000000 },
+    { 0xC9F2C9CD04674EDE, 0xA400000000000000 }, { 0xFC6F7C4045812296, 0x4D00000000000000 },
+    { 0x9DC5ADA82B70B59D, 0xF020000000000000 }, { 0xC5371912364CE305, 0x6C28000000000000 },
+    { 0xF684DF56C3E01BC6, 0xC732000000000000 }, { 0x9A130B963A6C115C, 0x3C7F400000000000 },
+    { 0xC097CE7BC90715B3, 0x4B9F100000000000 }, { 0xF0BDC21ABB48DB20, 0x1E86D40000000000 },
+    { 0x96769950B50D88F4, 0x1314448000000000 }, { 0xBC143FA4E250EB31, 0x17D955A000000000 },
+    { 0xEB194F8E1AE525FD, 0x5DCFAB0800000000 }, { 0x92EFD1B8D0CF37BE, 0x5AA1CAE500000000 },
+    { 0xB7ABC627050305AD, 0xF14A3D9E40000000 }, { 0xE596B7B0C643C719, 0x6D9CCD05D0000000 },
+    { 0x8F7E32CE7BEA5C6F, 0xE4820023A2000000 }, { 0xB35DBF821AE4F38B, 0xDDA2802C8A800000 },
+    { 0xE0352F62A19E306E, 0xD50B2037AD200000 }, { 0x8C213D9DA502DE45, 0x4526F422CC340000 },
+    { 0xAF298D050E4395D6, 0x9670B12B7F410000 }, { 0xDAF3F04651D47B4C, 0x3C0CDD765F114000 },
+    { 0x88D8762BF324CD0F, 0xA5880A69FB6AC800 }, { 0xAB0E93B6EFEE0053, 0x8EEA0D047A457A00 },
+    { 0xD5D238A4ABE98068, 0x72A4904598D6D880 }, { 0x85A36366EB71F041, 0x47A6DA2B7F864750 },
+    { 0xA70C3C40A64E6C51, 0x999090B65F67D924 }, { 0xD0CF4B50CFE20765, 0xFFF4B4E3F741CF6D },
+    { 0x82818F1281ED449F, 0xBFF8F10E7A8921A4 }, { 0xA321F2D7226895C7, 0xAFF72D52192B6A0D },
+    { 0xCBEA6F8CEB02BB39, 0x9BF4F8A69F764490 }, { 0xFEE50B7025C36A08, 0x02F236D04753D5B4 },
+    { 0x9F4F2726179A2245, 0x01D762422C946590 }, { 0xC722F0EF9D80AAD6, 0x424D3AD2B7B97EF5 },
+    { 0xF8EBAD2B84E0D58B, 0xD2E0898765A7DEB2 }, { 0x9B934C3B330C8577, 0x63CC55F49F88EB2F },
+    { 0xC2781F49FFCFA6D5, 0x3CBF6B71C76B25FB }, { 0xF316271C7FC3908A, 0x8BEF464E3945EF7A },
+    { 0x97EDD871CFDA3A56, 0x97758BF0E3CBB5AC }, { 0xBDE94E8E43D0C8EC, 0x3D52EEED1CBEA317 },
+    { 0xED63A231D4C4FB27, 0x4CA7AAA863EE4BDD }, { 0x945E455F24FB1CF8, 0x8FE8CAA93E74EF6A },
+    { 0xB975D6B6EE39E436, 0xB3E2FD538E122B44 }, { 0xE7D34C64A9C85D44, 0x60DBBCA87196B616 },
+    { 0x90E40FBEEA1D3A4A, 0xBC8955E946FE31CD }, { 0xB51D13AEA4A488DD, 0x6BABAB6398BDBE41 },
+    { 0xE264589A4DCDAB14, 0xC696963C7EED2DD1 }, { 0x8D7EB76070A08AEC, 0xFC1E1DE5CF543CA2 },
+    { 0xB0DE65388CC8ADA8, 0x3B25A55F43294BCB }, { 0xDD15FE86AFFAD912, 0x49EF0EB713F39EBE },
+    { 0x8A2DBF142DFCC7AB, 0x6E3569326C784337 }, { 0xACB92ED9397BF996, 0x49C2C37F07965404 },
+    { 0xD7E77A8F87DAF7FB, 0xDC33745EC97BE906 }, { 0x86F0AC99B4E8DAFD, 0x69A028BB3DED71A3 },
+    { 0xA8ACD7C0222311BC, 0xC40832EA0D68CE0C }, { 0xD2D80DB02AABD62B, 0xF50A3FA490C30190 },
+    { 0x83C7088E1AAB65DB, 0x792667C6DA79E0FA }, { 0xA4B8CAB1A1563F52, 0x577001B891185938 },
+    { 0xCDE6FD5E09ABCF26, 0xED4C0226B55E6F86 }, { 0x80B05E5AC60B6178, 0x544F8158315B05B4 },
+    { 0xA0DC75F1778E39D6, 0x696361AE3DB1C721 }, { 0xC913936DD571C84C, 0x03BC3A19CD1E38E9 },
+    { 0xFB5878494ACE3A5F, 0x04AB48A04065C723 }, { 0x9D174B2DCEC0E47B, 0x62EB0D64283F9C76 },
+    { 0xC45D1DF942711D9A, 0x3BA5D0BD324F8394 }, { 0xF5746577930D6500, 0xCA8F44EC7EE36479 },
+    { 0x9968BF6ABBE85F20, 0x7E998B13CF4E1ECB }, { 0xBFC2EF456AE276E8, 0x9E3FEDD8C321A67E },
+    { 0xEFB3AB16C59B14A2, 0xC5CFE94EF3EA101E }, { 0x95D04AEE3B80ECE5, 0xBBA1F1D158724A12 },
+    { 0xBB445DA9CA61281F, 0x2A8A6E45AE8EDC97 }, { 0xEA1575143CF97226, 0xF52D09D71A3293BD },
+    { 0x924D692CA61BE758, 0x593C2626705F9C56 }, { 0xB6E0C377CFA2E12E, 0x6F8B2FB00C77836C },
+    { 0xE498F455C38B997A, 0x0B6DFB9C0F956447 }, { 0x8EDF98B59A373FEC, 0x4724BD4189BD5EAC },
+    { 0xB2977EE300C50FE7, 0x58EDEC91EC2CB657 }, { 0xDF3D5E9BC0F653E1, 0x2F2967B66737E3ED },
+    { 0x8B865B215899F46C, 0xBD79E0D20082EE74 }, { 0xAE67F1E9AEC07187, 0xECD8590680A3AA11 },
+    { 0xDA01EE641A708DE9, 0xE80E6F4820CC9495 }, { 0x884134FE908658B2, 0x3109058D147FDCDD },
+    { 0xAA51823E34A7EEDE, 0xBD4B46F0599FD415 }, { 0xD4E5E2CDC1D1EA96, 0x6C9E18AC7007C91A },
+    { 0x850FADC09923329E, 0x03E2CF6BC604DDB0 }, { 0xA6539930BF6BFF45, 0x84DB8346B786151C },
+    { 0xCFE87F7CEF46FF16, 0xE612641865679A63 }, { 0x81F14FAE158C5F6E, 0x4FCB7E8F3F60C07E },
+    { 0xA26DA3999AEF7749, 0xE3BE5E330F38F09D }, { 0xCB090C8001AB551C, 0x5CADF5BFD3072CC5 },
+    { 0xFDCB4FA002162A63, 0x73D9732FC7C8F7F6 }, { 0x9E9F11C4014DDA7E, 0x2867E7FDDCDD9AFA },
+    { 0xC646D63501A1511D, 0xB281E1FD541501B8 }, { 0xF7D88BC24209A565, 0x1F225A7CA91A4226 },
+    { 0x9AE757596946075F, 0x3375788DE9B06958 }, { 0xC1A12D2FC3978937, 0x0052D6B1641C83AE },
+    { 0xF209787BB47D6B84, 0xC0678C5DBD23A49A }, { 0x9745EB4D50CE6332, 0xF840B7BA963646E0 },
+    { 0xBD176620A501FBFF, 0xB650E5A93BC3D898 }, { 0xEC5D3FA8CE427AFF, 0xA3E51F138AB4CEBE },
+    { 0x93BA47C980E98CDF, 0xC66F336C36B10137 }, { 0xB8A8D9BBE123F017, 0xB80B0047445D4184 },
+    { 0xE6D3102AD96CEC1D, 0xA60DC059157491E5 }, { 0x9043EA1AC7E41392, 0x87C89837AD68DB2F },
+    { 0xB454E4A179DD1877, 0x29BABE4598C311FB }, { 0xE16A1DC9D8545E94, 0xF4296DD6FEF3D67A },
+    { 0x8CE2529E2734BB1D, 0x1899E4A65F58660C }, { 0xB01AE745B101E9E4, 0x5EC05DCFF72E7F8F },
+    { 0xDC21A1171D42645D, 0x76707543F4FA1F73 }, { 0x899504AE72497EBA, 0x6A06494A791C53A8 },
+    { 0xABFA45DA0EDBDE69, 0x0487DB9D17636892 }, { 0xD6F8D7509292D603, 0x45A9D2845D3C42B6 },
+    { 0x865B86925B9BC5C2, 0x0B8A2392BA45A9B2 }, { 0xA7F26836F282B732, 0x8E6CAC7768D7141E },
+    { 0xD1EF0244AF2364FF, 0x3207D795430CD926 }, { 0x8335616AED761F1F, 0x7F44E6BD49E807B8 },
+    { 0xA402B9C5A8D3A6E7, 0x5F16206C9C6209A6 }, { 0xCD036837130890A1, 0x36DBA887C37A8C0F },
+    { 0x802221226BE55A64, 0xC2494954DA2C9789 }, { 0xA02AA96B06DEB0FD, 0xF2DB9BAA10B7BD6C },
+    { 0xC83553C5C8965D3D, 0x6F92829494E5ACC7 }, { 0xFA42A8B73ABBF48C, 0xCB772339BA1F17F9 },
+    { 0x9C69A97284B578D7, 0xFF2A760414536EFB }, { 0xC38413CF25E2D70D, 0xFEF5138519684ABA },
+    { 0xF46518C2EF5B8CD1, 0x7EB258665FC25D69 }, { 0x98BF2F79D5993802, 0xEF2F773FFBD97A61 },
+    { 0xBEEEFB584AFF8603, 0xAAFB550FFACFD8FA }, { 0xEEAABA2E5DBF6784, 0x95BA2A53F983CF38 },
+    { 0x952AB45CFA97A0B2, 0xDD945A747BF26183 }, { 0xBA756174393D88DF, 0x94F971119AEEF9E4 },
+    { 0xE912B9D1478CEB17, 0x7A37CD5601AAB85D }, { 0x91ABB422CCB812EE, 0xAC62E055C10AB33A },
+    { 0xB616A12B7FE617AA, 0x577B986B314D6009 }, { 0xE39C49765FDF9D94, 0xED5A7E85FDA0B80B },
+    { 0x8E41ADE9FBEBC27D, 0x14588F13BE847307 }, { 0xB1D219647AE6B31C, 0x596EB2D8AE258FC8 },
+    { 0xDE469FBD99A05FE3, 0x6FCA5F8ED9AEF3BB }, { 0x8AEC23D680043BEE, 0x25DE7BB9480D5854 },
+    { 0xADA72CCC20054AE9, 0xAF561AA79A10AE6A }, { 0xD910F7FF28069DA4, 0x1B2BA1518094DA04 },
+    { 0x87AA9AFF79042286, 0x90FB44D2F05D0842 }, { 0xA99541BF57452B28, 0x353A1607AC744A53 },
+    { 0xD3FA922F2D1675F2, 0x42889B8997915CE8 }, { 0x847C9B5D7C2E09B7, 0x69956135FEBADA11 },
+    { 0xA59BC234DB398C25, 0x43FAB9837E699095 }, { 0xCF02B2C21207EF2E, 0x94F967E45E03F4BB },
+    { 0x8161AFB94B44F57D, 0x1D1BE0EEBAC278F5 }, { 0xA1BA1BA79E1632DC, 0x6462D92A69731732 },
+    { 0xCA28A291859BBF93, 0x7D7B8F7503CFDCFE }, { 0xFCB2CB35E702AF78, 0x5CDA735244C3D43E },
+    { 0x9DEFBF01B061ADAB, 0x3A0888136AFA64A7 }, { 0xC56BAEC21C7A1916, 0x088AAA1845B8FDD0 },
+    { 0xF6C69A72A3989F5B, 0x8AAD549E57273D45 }, { 0x9A3C2087A63F6399, 0x36AC54E2F678864B },
+    { 0xC0CB28A98FCF3C7F, 0x84576A1BB416A7DD }, { 0xF0FDF2D3F3C30B9F, 0x656D44A2A11C51D5 },
+    { 0x969EB7C47859E743, 0x9F644AE5A4B1B325 }, { 0xBC4665B596706114, 0x873D5D9F0DDE1FEE },
+    { 0xEB57FF22FC0C7959, 0xA90CB506D155A7EA }, { 0x9316FF75DD87CBD8, 0x09A7F12442D588F2 },
+    { 0xB7DCBF5354E9BECE, 0x0C11ED6D538AEB2F }, { 0xE5D3EF282A242E81, 0x8F1668C8A86DA5FA },
+    { 0x8FA475791A569D10, 0xF96E017D694487BC }, { 0xB38D92D760EC4455, 0x37C981DCC395A9AC },
+    { 0xE070F78D3927556A, 0x85BBE253F47B1417 }, { 0x8C469AB843B89562, 0x93956D7478CCEC8E },
+    { 0xAF58416654A6BABB, 0x387AC8D1970027B2 }, { 0xDB2E51BFE9D0696A, 0x06997B05FCC0319E },
+    { 0x88FCF317F22241E2, 0x441FECE3BDF81F03 }, { 0xAB3C2FDDEEAAD25A, 0xD527E81CAD7626C3 },
+    { 0xD60B3BD56A5586F1, 0x8A71E223D8D3B074 }, { 0x85C7056562757456, 0xF6872D5667844E49 },
+    { 0xA738C6BEBB12D16C, 0xB428F8AC016561DB }, { 0xD106F86E69D785C7, 0xE13336D701BEBA52 },
+    { 0x82A45B450226B39C, 0xECC0024661173473 }, { 0xA34D721642B06084, 0x27F002D7F95D0190 },
+    { 0xCC20CE9BD35C78A5, 0x31EC038DF7B441F4 }, { 0xFF290242C83396CE, 0x7E67047175A15271 },
+    { 0x9F79A169BD203E41, 0x0F0062C6E984D386 }, { 0xC75809C42C684DD1, 0x52C07B78A3E60868 },
+    { 0xF92E0C3537826145, 0xA7709A56CCDF8A82 }, { 0x9BBCC7A142B17CCB, 0x88A66076400BB691 },
+    { 0xC2ABF989935DDBFE, 0x6ACFF893D00EA435 }, { 0xF356F7EBF83552FE, 0x0583F6B8C4124D43 },
+    { 0x98165AF37B2153DE, 0xC3727A337A8B704A }, { 0xBE1BF1B059E9A8D6, 0x744F18C0592E4C5C },
+    { 0xEDA2EE1C7064130C, 0x1162DEF06F79DF73 }, { 0x9485D4D1C63E8BE7, 0x8ADDCB5645AC2BA8 },
+    { 0xB9A74A0637CE2EE1, 0x6D953E2BD7173692 }, { 0xE8111C87C5C1BA99, 0xC8FA8DB6CCDD0437 },
+    { 0x910AB1D4DB9914A0, 0x1D9C9892400A22A2 }, { 0xB54D5E4A127F59C8, 0x2503BEB6D00CAB4B },
+    { 0xE2A0B5DC971F303A, 0x2E44AE64840FD61D }, { 0x8DA471A9DE737E24, 0x5CEAECFED289E5D2 },
+    { 0xB10D8E1456105DAD, 0x7425A83E872C5F47 }, { 0xDD50F1996B947518, 0xD12F124E28F77719 },
+    { 0x8A5296FFE33CC92F, 0x82BD6B70D99AAA6F }, { 0xACE73CBFDC0BFB7B, 0x636CC64D1001550B },
+    { 0xD8210BEFD30EFA5A, 0x3C47F7E05401AA4E }, { 0x8714A775E3E95C78, 0x65ACFAEC34810A71 },
+    { 0xA8D9D1535CE3B396, 0x7F1839A741A14D0D }, { 0xD31045A8341CA07C, 0x1EDE48111209A050 },
+    { 0x83EA2B892091E44D, 0x934AED0AAB460432 }, { 0xA4E4B66B68B65D60, 0xF81DA84D5617853F },
+    { 0xCE1DE40642E3F4B9, 0x36251260AB9D668E }, { 0x80D2AE83E9CE78F3, 0xC1D72B7C6B426019 },
+    { 0xA1075A24E4421730, 0xB24CF65B8612F81F }, { 0xC94930AE1D529CFC, 0xDEE033F26797B627 },
+    { 0xFB9B7CD9A4A7443C, 0x169840EF017DA3B1 }, { 0x9D412E0806E88AA5, 0x8E1F289560EE864E },
+    { 0xC491798A08A2AD4E, 0xF1A6F2BAB92A27E2 }, { 0xF5B5D7EC8ACB58A2, 0xAE10AF696774B1DB },
+    { 0x9991A6F3D6BF1765, 0xACCA6DA1E0A8EF29 }, { 0xBFF610B0CC6EDD3F, 0x17FD090A58D32AF3 },
+    { 0xEFF394DCFF8A948E, 0xDDFC4B4CEF07F5B0 }, { 0x95F83D0A1FB69CD9, 0x4ABDAF101564F98E },
+    { 0xBB764C4CA7A4440F, 0x9D6D1AD41ABE37F1 }, { 0xEA53DF5FD18D5513, 0x84C86189216DC5ED },
+    { 0x92746B9BE2F8552C, 0x32FD3CF5B4E49BB4 }, { 0xB7118682DBB66A77, 0x3FBC8C33221DC2A1 },
+    { 0xE4D5E82392A40515, 0x0FABAF3FEAA5334A }, { 0x8F05B1163BA6832D, 0x29CB4D87F2A7400E },
+    { 0xB2C71D5BCA9023F8, 0x743E20E9EF511012 }, { 0xDF78E4B2BD342CF6, 0x914DA9246B255416 },
+    { 0x8BAB8EEFB6409C1A, 0x1AD089B6C2F7548E }, { 0xAE9672ABA3D0C320, 0xA184AC2473B529B1 },
+    { 0xDA3C0F568CC4F3E8, 0xC9E5D72D90A2741E }, { 0x8865899617FB1871, 0x7E2FA67C7A658892 },
+    { 0xAA7EEBFB9DF9DE8D, 0xDDBB901B98FEEAB7 }, { 0xD51EA6FA85785631, 0x552A74227F3EA565 },
+    { 0x8533285C936B35DE, 0xD53A88958F87275F }, { 0xA67FF273B8460356, 0x8A892ABAF368F137 },
+    { 0xD01FEF10A657842C, 0x2D2B7569B0432D85 }, { 0x8213F56A67F6B29B, 0x9C3B29620E29FC73 },
+    { 0xA298F2C501F45F42, 0x8349F3BA91B47B8F }, { 0xCB3F2F7642717713, 0x241C70A936219A73 },
+    { 0xFE0EFB53D30DD4D7, 0xED238CD383AA0110 }, { 0x9EC95D1463E8A506, 0xF4363804324A40AA },
+    { 0xC67BB4597CE2CE48, 0xB143C6053EDCD0D5 }, { 0xF81AA16FDC1B81DA, 0xDD94B7868E94050A },
+    { 0x9B10A4E5E9913128, 0xCA7CF2B4191C8326 }, { 0xC1D4CE1F63F57D72, 0xFD1C2F611F63A3F0 },
+    { 0xF24A01A73CF2DCCF, 0xBC633B39673C8CEC }, { 0x976E41088617CA01, 0xD5BE0503E085D813 },
+    { 0xBD49D14AA79DBC82, 0x4B2D8644D8A74E18 }, { 0xEC9C459D51852BA2, 0xDDF8E7D60ED1219E },
+    { 0x93E1AB8252F33B45, 0xCABB90E5C942B503 }, { 0xB8DA1662E7B00A17, 0x3D6A751F3B936243 },
+    { 0xE7109BFBA19C0C9D, 0x0CC512670A783AD4 }, { 0x906A617D450187E2, 0x27FB2B80668B24C5 },
+    { 0xB484F9DC9641E9DA, 0xB1F9F660802DEDF6 }, { 0xE1A63853BBD26451, 0x5E7873F8A0396973 },
+    { 0x8D07E33455637EB2, 0xDB0B487B6423E1E8 }, { 0xB049DC016ABC5E5F, 0x91CE1A9A3D2CDA62 },
+    { 0xDC5C5301C56B75F7, 0x7641A140CC7810FB }, { 0x89B9B3E11B6329BA, 0xA9E904C87FCB0A9D },
+    { 0xAC2820D9623BF429, 0x546345FA9FBDCD44 }, { 0xD732290FBACAF133, 0xA97C177947AD4095 },
+    { 0x867F59A9D4BED6C0, 0x49ED8EABCCCC485D }, { 0xA81F301449EE8C70, 0x5C68F256BFFF5A74 },
+    { 0xD226FC195C6A2F8C, 0x73832EEC6FFF3111 }, { 0x83585D8FD9C25DB7, 0xC831FD53C5FF7EAB },
+    { 0xA42E74F3D032F525, 0xBA3E7CA8B77F5E55 }, { 0xCD3A1230C43FB26F, 0x28CE1BD2E55F35EB },
+    { 0x80444B5E7AA7CF85, 0x7980D163CF5B81B3 }, { 0xA0555E361951C366, 0xD7E105BCC332621F },
+    { 0xC86AB5C39FA63440, 0x8DD9472BF3FEFAA7 }, { 0xFA856334878FC150, 0xB14F98F6F0FEB951 },
+    { 0x9C935E00D4B9D8D2, 0x6ED1BF9A569F33D3 }, { 0xC3B8358109E84F07, 0x0A862F80EC4700C8 },
+    { 0xF4A642E14C6262C8, 0xCD27BB612758C0FA }, { 0x98E7E9CCCFBD7DBD, 0x8038D51CB897789C },
+    { 0xBF21E44003ACDD2C, 0xE0470A63E6BD56C3 }, { 0xEEEA5D5004981478, 0x1858CCFCE06CAC74 },
+    { 0x95527A5202DF0CCB, 0x0F37801E0C43EBC8 }, { 0xBAA718E68396CFFD, 0xD30560258F54E6BA },
+    { 0xE950DF20247C83FD, 0x47C6B82EF32A2069 }, { 0x91D28B7416CDD27E, 0x4CDC331D57FA5441 },
+    { 0xB6472E511C81471D, 0xE0133FE4ADF8E952 }, { 0xE3D8F9E563A198E5, 0x58180FDDD97723A6 },
+    { 0x8E679C2F5E44FF8F, 0x570F09EAA7EA7648 }
+};
+
+typedef struct
+{
+    unsigned long long high;
+    unsigned long long low;
+} uint128;
+
+static uint128 multiply_64(const unsigned long long a, const unsigned long long b)
+{
+    uint128 product;
+#if defined(__SIZEOF_INT128__)
+    __extension__ unsigned __int128 full = (unsigned __int128)a * b;
+    product.high = (unsigned long long)(full >> 64);
+    product.low = (unsigned long long)full;
+#else
+    unsigned long long a_low = a & 0xFFFFFFFFULL;
+    unsigned long long a_high = a >> 32;
+    unsigned long long b_low = b & 0xFFFFFFFFULL;
+    unsigned long long b_high = b >> 32;
+    unsigned long long low_low = a_low * b_low;
+    unsigned long long low_high = a_low * b_high;
+    unsigned long long high_low = a_high * b_low;
+    unsigned long long middle = (low_low >> 32) + (low_high & 0xFFFFFFFFULL) + (high_low & 0xFFFFFFFFULL);
+    product.high = (a_high * b_high) + (low_high >> 32) + (high_low >> 32) + (middle >> 32);
+    product.low = (middle << 32) | (low_low & 0xFFFFFFFFULL);
+#endif
+    return product;
+}
+
+static int leading_zeros_64(unsigned long long value)
+{
+    int count = 0;
+#if defined(__GNUC__)
+    if (value != 0)
+    {
+        return __builtin_clzll(value);
+    }
+#endif
+    if (value == 0)
+    {
+        return 64;
+    }
+    while (!(value & 0x8000000000000000ULL))
+    {
+        value <<= 1;
+        count++;
+    }
+    return count;
+}
+
+static double bits_to_double(const unsigned long long bits)
+{
+    double number = 0;
+    memcpy(&number, &bits, sizeof(number));
+    return number;
+}
+
+static unsigned long long double_to_bits(const double number)
+{
+    unsigned long long bits = 0;
+    memcpy(&bits, &number, sizeof(bits));
+    return bits;
+}
+
+/* mantissa * 10^exponent, rounded to nearest, for a non-zero mantissa. Returns false if the product is too close to a halfway point
+ * (or is subnormal) to be decided with 128 bits of 5^exponent. */
+static cJSON_bool eisel_lemire(const unsigned long long mantissa, const int exponent, const cJSON_bool negative, double * const number)
+{
+    const unsigned long long *power = NULL;
+    unsigned long long significand = mantissa;
+    unsigned long long upper = 0;
+    unsigned long long lower = 0;
+    unsigned long long upper_bit = 0;
+    unsigned long long bits = 0;
+    long binary_exponent = 0;
+    int shift = 0;
+    uint128 product;
+
+    if (exponent < CJSON_SMALLEST_POWER)
+    {
+        *number = negative ? -0.0 : 0.0;
+        return true;
+    }
+    if (exponent > CJSON_LARGEST_POWER)
+    {
+        *number = negative ? -HUGE_VAL : HUGE_VAL;
+        return true;
+    }
+
+    power = powers_of_five[exponent - CJSON_SMALLEST_POWER];
+    /* floor(log2(10) * exponent), without relying on the rounding of signed division or shifts */
+    binary_exponent = (217706L * exponent) / 65536L;
+    if ((217706L * exponent) % 65536L < 0)
+    {
+        binary_exponent--;
+    }
+    binary_exponent += 1024 + 63;
+
+    shift = leading_zeros_64(significand);
+    significand <<= shift;
+
+    product = multiply_64(significand, power[0]);
+    upper = product.high;
+    lower = product.low;
+    /* the 9 bits below the 55 we keep are all ones, and the low bits could carry into them: use the low half of 5^exponent as well */
+    if (((upper & 0x1FF) == 0x1FF) && ((lower + significand) < lower))
+    {
+        uint128 second = multiply_64(significand, power[1]);
+        unsigned long long middle = lower + second.high;
+        if (middle < lower)
+        {
+            upper++;
+        }
+        if (((middle + 1) == 0) && ((upper & 0x1FF) == 0x1FF) && ((second.low + significand) < second.low))
+        {
+            return false;
+        }
+        lower = middle;
+    }
+
+    upper_bit = upper >> 63;
+    bits = upper >> (upper_bit + 9);
+    shift += (int)(1 ^ upper_bit);
+
+    /* maybe exactly halfway between two doubles */
+    if ((lower == 0) && ((upper & 0x1FF) == 0) && ((bits & 3) == 1))
+    {
+        return false;
+    }
+
+    /* round to nearest, even */
+    bits += bits & 1;
+    bits >>= 1;
+    if (bits >= (1ULL << 53))
+    {
+        bits = 1ULL << 52;
+        shift--;
+    }
+    bits &= ~(1ULL << 52);
+
+    binary_exponent -= shift;
+    if ((binary_exponent < 1) || (binary_exponent > 2046))
+    {
+        return false;
+    }
+
+    bits |= (unsigned long long)binary_exponent << 52;
+    if (negative)
+    {
+        bits |= 1ULL << 63;
+    }
+    *number = bits_to_double(bits);
+
+    return true;
+}
+
+/* The exact conversion: the digits are shifted by powers of two, in decimal, until they hold the 53 bits of the result
+ * (the algorithm of strconv in Go). Only used when eisel_lemire cannot decide. */
+#define CJSON_DECIMAL_DIGITS 800
+#define CJSON_MAX_SHIFT 60
+
+typedef struct
+{
+    unsigned char digits[CJSON_DECIMAL_DIGITS]; /* values 0-9, without leading or trailing zeros */
+    int count;
+    int point; /* the position of the decimal point relative to the first digit */
+    cJSON_bool truncated; /* digits were dropped, and at least one of them was not a zero */
+} decimal;
+
+static void decimal_trim(decimal * const value)
+{
+    while ((value->count > 0) && (value->digits[value->count - 1] == 0))
+    {
+        value->count--;
+    }
+    if (value->count == 0)
+    {
+        value->point = 0;
+    }
+}
+
+static void decimal_left_shift(decimal * const value, const unsigned int shift)
+{
+    /* the result is written backwards into a scratch buffer, then reversed into place */
+    unsigned char reversed[CJSON_DECIMAL_DIGITS + 20];
+    unsigned long long carry = 0;
+    int written = 0;
+    int read = 0;
+    int i = 0;
+
+    for (read = value->count - 1; read >= 0; read--)
+    {
+        carry += (unsigned long long)value->digits[read] << shift;
+        reversed[written++] = (unsigned char)(carry % 10);
+        carry /= 10;
+    }
+    while (carry > 0)
+    {
+        reversed[written++] = (unsigned char)(carry % 10);
+        carry /= 10;
+    }
+
+    value->point += written - value->count;
+    value->count = 0;
+    for (i = written - 1; i >= 0; i--)
+    {
+        if (value->count < CJSON_DECIMAL_DIGITS)
+        {
+            value->digits[value->count++] = reversed[i];
+        }
+        else if (reversed[i] != 0)
+        {
+            value->truncated = true;
+        }
+    }
+    decimal_trim(value);
+}
+
+static void decimal_right_shift(decimal * const value, const unsigned int shift)
+{
+    const unsigned long long mask = (1ULL << shift) - 1;
+    unsigned long long remainder = 0;
+    int read = 0;
+    int written = 0;
+
+    /* pick up enough leading digits to produce the first digit of the result */
+    for (; (remainder >> shift) == 0; read++)
+    {
+        if (read >= value->count)
+        {
+            if (remainder == 0)
+            {
+                value->count = 0;
+                value->point = 0;
+                return;
+            }
+            while ((remainder >> shift) == 0)
+            {
+                remainder *= 10;
+                read++;
+            }
+            break;
+        }
+        remainder = (remainder * 10) + value->digits[read];
+    }
+    value->point -= read - 1;
+
+    for (; read < value->count; read++)
+    {
+        unsigned char digit = value->digits[read];
+        value->digits[written++] = (unsigned char)(remainder >> shift);
+        remainder = ((remainder & mask) * 10) + digit;
+    }
+    while (remainder > 0)
+    {
+        unsigned char digit = (unsigned char)(remainder >> shift);
+        remainder = (remainder & mask) * 10;
+        if (written < CJSON_DECIMAL_DIGITS)
+        {
+            value->digits[written++] = digit;
+        }
+        else if (digit > 0)
+        {
+            value->truncated = true;
+        }
+    }
+    value->count = written;
+    decimal_trim(value);
+}
+
+static void decimal_shift(decimal * const value, int shift)
+{
+    if (value->count == 0)
+    {
+        return;
+    }
+    while (shift > 0)
+    {
+        int step = (shift > CJSON_MAX_SHIFT) ? CJSON_MAX_SHIFT : shift;
+        decimal_left_shift(value, (unsigned int)step);
+        shift -= step;
+    }
+    while (shift < 0)
+    {
+        int step = (-shift > CJSON_MAX_SHIFT) ? CJSON_MAX_SHIFT : -shift;
+        decimal_right_shift(value, (unsigned int)step);
+        shift += step;
+    }
+}
+
+/* the integer part of the value, rounded to nearest, even */
+static unsigned long long decimal_rounded_integer(const decimal * const value)
+{
+    unsigned long long integer = 0;
+    cJSON_bool round_up = false;
+    int i = 0;
+
+    if (value->point > 20)
+    {
+        return 0xFFFFFFFFFFFFFFFFULL;
+    }
+    for (i = 0; (i < value->point) && (i < value->count); i++)
+    {
+        integer = (integer * 10) + value->digits[i];
+    }
+    for (; i < value->point; i++)
+    {
+        integer *= 10;
+    }
+
+    if ((value->point >= 0) && (value->point < value->count))
+    {
+        if ((value->digits[value->point] == 5) && ((value->point + 1) == value->count))
+        {
+            /* exactly halfway, unless digits were dropped */
+            round_up = value->truncated || ((value->point > 0) && (value->digits[value->point - 1] % 2 == 1));
+        }
+        else
+        {
+            round_up = value->digits[value->point] >= 5;
+        }
+    }
+
+    return integer + (round_up ? 1 : 0);
+}
+
+static double decimal_to_double(decimal * const value, const cJSON_bool negative)
+{
+    /* the number of binary digits to shift by to move the point past a given number of decimal digits */
+    static const int shifts[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+    const int shifts_count = (int)(sizeof(shifts) / sizeof(shifts[0]));
+    unsigned long long mantissa = 0;
+    int exponent = 0;
+
+    if ((value->count == 0) || (value->point < -330))
+    {
+        return negative ? -0.0 : 0.0;
+    }
+    if (value->point > 310)
+    {
+        return negative ? -HUGE_VAL : HUGE_VAL;
+    }
+
+    /* scale into [1/2, 1) */
+    while (value->point > 0)
+    {
+        int shift = (value->point >= shifts_count) ? 27 : shifts[value->point];
+        decimal_shift(value, -shift);
+        exponent += shift;
+    }
+    while ((value->point < 0) || ((value->point == 0) && (value->digits[0] < 5)))
+    {
+        int shift = (-value->point >= shifts_count) ? 27 : shifts[-value->point];
+        decimal_shift(value, shift);
+        exponent -= shift;
+    }
+    exponent--;
+
+    /* below the smallest normal exponent the value is denormalized */
+    if (exponent < -1022)
+    {
+        decimal_shift(value, -(-1022 - exponent));
+        exponent = -1022;
+    }
+    if (exponent > 1023)
+    {
+        return negative ? -HUGE_VAL : HUGE_VAL;
+    }
+
+    decimal_shift(value, 53);
+    mantissa = decimal_rounded_integer(value);
+    if (mantissa == (2ULL << 52))
+    {
+        mantissa >>= 1;
+        exponent++;
+        if (exponent > 1023)
+        {
+            return negative ? -HUGE_VAL : HUGE_VAL;
+        }
+    }
+    if (!(mantissa & (1ULL << 52)))
+    {
+        exponent = -1023;
+    }
+
+    mantissa &= (1ULL << 52) - 1;
+    mantissa |= (unsigned long long)(exponent + 1023) << 52;
+    if (negative)
+    {
+        mantissa |= 1ULL << 63;
+    }
+
+    return bits_to_double(mantissa);
+}
+
+/* Reads a number the way strtod reads a decimal one (a sign and digits, then an optional fraction and exponent),
+ * from at most length bytes. Returns the number of bytes read, 0 if there is no number. */
+static size_t read_number(const unsigned char * const input, const size_t length, double * const number)
+{
+    /* the powers of ten a double holds exactly */
+    static const double exact_powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    unsigned long long mantissa = 0;
+    cJSON_bool negative = false;
+    const unsigned char *point = NULL;
+    const unsigned char *first_significant = NULL;
+    size_t digits = 0;
+    size_t significant = 0; /* digits from the first non-zero one on */
+    long digits_after_point = 0; /* up to the last digit in mantissa */
+    long exponent = 0;
+    size_t mantissa_end = 0;
+    size_t end = 0;
+    size_t i = 0;
+
+    if ((length > 0) && ((input[0] == '-') || (input[0] == '+')))
+    {
+        negative = (input[0] == '-');
+        i++;
+    }
+
+    for (; i < length; i++)
+    {
+        if ((input[i] == '.') && (point == NULL))
+        {
+            point = input + i;
+            continue;
+        }
+        if ((input[i] < '0') || (input[i] > '9'))
+        {
+            break;
+        }
+
+        digits++;
+        if ((first_significant == NULL) && (input[i] != '0'))
+        {
+            first_significant = input + i;
+        }
+        if ((first_significant != NULL) && (significant++ >= 19))
+        {
+            continue;
+        }
+        if (point != NULL)
+        {
+            digits_after_point++;
+        }
+        if (first_significant != NULL)
+        {
+            mantissa = (mantissa * 10) + (unsigned long long)(input[i] - '0');
+        }
+    }
+    if (digits == 0)
+    {
+        return 0;
+    }
+    mantissa_end = i;
+    end = i;
+
+    /* the exponent is only part of the number if it has digits */
+    if ((i < length) && ((input[i] == 'e') || (input[i] == 'E')))
+    {
+        cJSON_bool negative_exponent = false;
+        size_t j = i + 1;
+        if ((j < length) && ((input[j] == '-') || (input[j] == '+')))
+        {
+            negative_exponent = (input[j] == '-');
+            j++;
+        }
+        if ((j < length) && (input[j] >= '0') && (input[j] <= '9'))
+        {
+            for (; (j < length) && (input[j] >= '0') && (input[j] <= '9'); j++)
+            {
+                /* past this, the number is zero or infinite anyway */
+                if (exponent < 100000)
+                {
+                    exponent = (exponent * 10) + (input[j] - '0');
+                }
+            }
+            if (negative_exponent)
+            {
+                exponent = -exponent;
+            }
+            end = j;
+        }
+    }
+
+    if (first_significant == NULL)
+    {
+        *number = negative ? -0.0 : 0.0;
+        return end;
+    }
+
+    if ((significant <= 19) && ((exponent - digits_after_point) >= INT_MIN) && ((exponent - digits_after_point) <= INT_MAX))
+    {
+        int power = (int)(exponent - digits_after_point);
+
+#if !defined(FLT_EVAL_METHOD) || (FLT_EVAL_METHOD == 0)
+        /* both operands are exact, so the single rounding of the operation is correct (Clinger's fast path) */
+        if ((mantissa <= (1ULL << 53)) && (power >= -22) && (power <= 22))
+        {
+            double value = (double)mantissa;
+            value = (power < 0) ? (value / exact_powers[-power]) : (value * exact_powers[power]);
+            *number = negative ? -value : value;
+            return end;
+        }
+#else
+        (void)exact_powers;
+#endif
+        if (eisel_lemire(mantissa, power, negative, number))
+        {
+            return end;
+        }
+    }
+
+    {
+        decimal value;
+        const unsigned char *digit = first_significant;
+        long decimal_point = 0;
+
+        /* the position of the point relative to the first significant digit */
+        if ((point != NULL) && (point < first_significant))
+        {
+            decimal_point = -(long)(first_significant - point - 1);
+        }
+        else
+        {
+            decimal_point = (long)(((point != NULL) ? point : (input + mantissa_end)) - first_significant);
+        }
+        decimal_point += exponent;
+
+        value.count = 0;
+        value.truncated = false;
+        for (; digit < (input + mantissa_end); digit++)
+        {
+            if (*digit == '.')
+            {
+                continue;
+            }
+            if (value.count < CJSON_DECIMAL_DIGITS)
+            {
+                value.digits[value.count++] = (unsigned char)(*digit - '0');
+            }
+            else if (*digit != '0')
+            {
+                value.truncated = true;
+            }
+        }
+        value.point = (decimal_point > 100000) ? 100000 : ((decimal_point < -100000) ? -100000 : (int)decimal_point);
+        decimal_trim(&value);
+
+        *number = decimal_to_double(&value, negative);
+    }
+
+    return end;
+}
+
+/* Grisu2 (Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with Integers"): the digits of a positive double
+ * that read back to it, found with 64-bit integers scaled by a cached power of ten. */
+typedef struct
+{
+    unsigned long long f;
+    int e;
+} diy_fp;
+
+/* normalized 10^k, rounded, for k from -300 to 324 in steps of 8 */
+typedef struct
+{
+    unsigned long long f;
+    int e;
+    int k;
+} cached_power;
+
+static const cached_power cached_powers[] = {
+    { 0xAB70FE17C79AC6CA, -1060, -300 }, { 0xFF77B1FCBEBCDC4F, -1034, -292 },
+    { 0xBE5691EF416BD60C, -1007, -284 }, { 0x8DD01FAD907FFC3C, -980, -276 },
+    { 0xD3515C2831559A83, -954, -268 }, { 0x9D71AC8FADA6C9B5, -927, -260 },
+    { 0xEA9C227723EE8BCB, -901, -252 }, { 0xAECC49914078536D, -874, -244 },
+    { 0x823C12795DB6CE57, -847, -236 }, { 0xC21094364DFB5637, -821, -228 },
+    { 0x9096EA6F3848984F, -794, -220 }, { 0xD77485CB25823AC7, -768, -212 },
+    { 0xA086CFCD97BF97F4, -741, -204 }, { 0xEF340A98172AACE5, -715, -196 },
+    { 0xB23867FB2A35B28E, -688, -188 }, { 0x84C8D4DFD2C63F3B, -661, -180 },
+    { 0xC5DD44271AD3CDBA, -635, -172 }, { 0x936B9FCEBB25C996, -608, -164 },
+    { 0xDBAC6C247D62A584, -582, -156 }, { 0xA3AB66580D5FDAF6, -555, -148 },
+    { 0xF3E2F893DEC3F126, -529, -140 }, { 0xB5B5ADA8AAFF80B8, -502, -132 },
+    { 0x87625F056C7C4A8B, -475, -124 }, { 0xC9BCFF6034C13053, -449, -116 },
+    { 0x964E858C91BA2655, -422, -108 }, { 0xDFF9772470297EBD, -396, -100 },
+    { 0xA6DFBD9FB8E5B88F, -369, -92 }, { 0xF8A95FCF88747D94, -343, -84 },
+    { 0xB94470938FA89BCF, -316, -76 }, { 0x8A08F0F8BF0F156B, -289, -68 },
+    { 0xCDB02555653131B6, -263, -60 }, { 0x993FE2C6D07B7FAC, -236, -52 },
+    { 0xE45C10C42A2B3B06, -210, -44 }, { 0xAA242499697392D3, -183, -36 },
+    { 0xFD87B5F28300CA0E, -157, -28 }, { 0xBCE5086492111AEB, -130, -20 },
+    { 0x8CBCCC096F5088CC, -103, -12 }, { 0xD1B71758E219652C, -77, -4 },
+    { 0x9C40000000000000, -50, 4 }, { 0xE8D4A51000000000, -24, 12 },
+    { 0xAD78EBC5AC620000, 3, 20 }, { 0x813F3978F8940984, 30, 28 },
+    { 0xC097CE7BC90715B3, 56, 36 }, { 0x8F7E32CE7BEA5C70, 83, 44 },
+    { 0xD5D238A4ABE98068, 109, 52 }, { 0x9F4F2726179A2245, 136, 60 },
+    { 0xED63A231D4C4FB27, 162, 68 }, { 0xB0DE65388CC8ADA8, 189, 76 },
+    { 0x83C7088E1AAB65DB, 216, 84 }, { 0xC45D1DF942711D9A, 242, 92 },
+    { 0x924D692CA61BE758, 269, 100 }, { 0xDA01EE641A708DEA, 295, 108 },
+    { 0xA26DA3999AEF774A, 322, 116 }, { 0xF209787BB47D6B85, 348, 124 },
+    { 0xB454E4A179DD1877, 375, 132 }, { 0x865B86925B9BC5C2, 402, 140 },
+    { 0xC83553C5C8965D3D, 428, 148 }, { 0x952AB45CFA97A0B3, 455, 156 },
+    { 0xDE469FBD99A05FE3, 481, 164 }, { 0xA59BC234DB398C25, 508, 172 },
+    { 0xF6C69A72A3989F5C, 534, 180 }, { 0xB7DCBF5354E9BECE, 561, 188 },
+    { 0x88FCF317F22241E2, 588, 196 }, { 0xCC20CE9BD35C78A5, 614, 204 },
+    { 0x98165AF37B2153DF, 641, 212 }, { 0xE2A0B5DC971F303A, 667, 220 },
+    { 0xA8D9D1535CE3B396, 694, 228 }, { 0xFB9B7CD9A4A7443C, 720, 236 },
+    { 0xBB764C4CA7A44410, 747, 244 }, { 0x8BAB8EEFB6409C1A, 774, 252 },
+    { 0xD01FEF10A657842C, 800, 260 }, { 0x9B10A4E5E9913129, 827, 268 },
+    { 0xE7109BFBA19C0C9D, 853, 276 }, { 0xAC2820D9623BF429, 880, 284 },
+    { 0x80444B5E7AA7CF85, 907, 292 }, { 0xBF21E44003ACDD2D, 933, 300 },
+    { 0x8E679C2F5E44FF8F, 960, 308 }, { 0xD433179D9C8CB841, 986, 316 },
+    { 0x9E19DB92B4E31BA9, 1013, 324 }
+};
+
+#define CJSON_GRISU_ALPHA -60
+#define CJSON_GRISU_GAMMA -32
+
+static diy_fp diy_fp_multiply(const diy_fp x, const diy_fp y)
+{
+    uint128 product = multiply_64(x.f, y.f);
+    diy_fp result;
+
+    /* round the low half into the high one */
+    result.f = product.high + (product.low >> 63);
+    result.e = x.e + y.e + 64;
+
+    return result;
+}
+
+static diy_fp diy_fp_normalize(diy_fp x)
 {
-    static char version[15];
-    sprintf(version, "%i.%i.%i", CJSON_VERSION_MAJOR, CJSON_VERSION_MINOR, CJSON_VERSION_PATCH);
+    int shift = leading_zeros_64(x.f);
 
-    return version;
+    x.f <<= shift;
+    x.e -= shift;
+
+    return x;
 }
 
-/* Case insensitive string comparison, doesn't consider two NULL pointers equal though */
-static int case_insensitive_strcmp(const unsigned char *string1, const unsigned char *string2)
+static void grisu2_round(unsigned char * const buffer, const int length, const unsigned long long distance, const unsigned long long delta, unsigned long long rest, const unsigned long long ten_k)
 {
-    if ((string1 == NULL) || (string2 == NULL))
+    /* move the last digit down while that brings the result closer to the exact value and keeps it in the rounding interval */
+    while ((rest < distance) && ((delta - rest) >= ten_k) && (((rest + ten_k) < distance) || ((distance - rest) > (rest + ten_k - distance))))
     {
-        return 1;
+        buffer[length - 1]--;
+        rest += ten_k;
     }
+}
 
-    if (string1 == string2)
+/* Writes the digits of w, with the interval [minus, plus] of the numbers that read back to the same double, all scaled so plus.e is in [alpha, gamma]. */
+static int grisu2_digits(unsigned char * const buffer, int * const decimal_exponent, const diy_fp minus, const diy_fp w, const diy_fp plus)
+{
+    static const unsigned int powers_of_ten[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+    const int shift = -plus.e;
+    const unsigned long long one = 1ULL << shift;
+    unsigned long long delta = plus.f - minus.f;
+    unsigned long long distance = plus.f - w.f;
+    unsigned int integral = (unsigned int)(plus.f >> shift);
+    unsigned long long fractional = plus.f & (one - 1);
+    int length = 0;
+    int remaining = 10;
+
+    /* the number of digits of the integral part */
+    while ((remaining > 1) && (integral < powers_of_ten[remaining - 1]))
     {
-        return 0;
+        remaining--;
     }
 
-    for(; tolower(*string1) == tolower(*string2); (void)string1++, string2++)
+    while (remaining > 0)
     {
-        if (*string1 == '\0')
+        unsigned int power = powers_of_ten[remaining - 1];
+        unsigned long long rest = 0;
+
+        buffer[length++] = (unsigned char)('0' + (integral / power));
+        integral %= power;
+        remaining--;
+
+        rest = ((unsigned long long)integral << shift) + fractional;
+        if (rest <= delta)
         {
-            return 0;
+            *decimal_exponent += remaining;
+            grisu2_round(buffer, length, distance, delta, rest, (unsigned long long)power << shift);
+            return length;
         }
     }
 
-    return tolower(*string1) - tolower(*string2);
-}
-
-typedef struct internal_hooks
-{
-    void *(CJSON_CDECL *allocate)(size_t size);
-    void (CJSON_CDECL *deallocate)(void *pointer);
-    void *(CJSON_CDECL *reallocate)(void *pointer, size_t size);
-} internal_hooks;
+    for (;;)
+    {
+        fractional *= 10;
+        delta *= 10;
+        distance *= 10;
 
-#if defined(_MSC_VER)
-/* work around MSVC error C2322: '...' address of dllimport '...' is not static */
-static void * CJSON_CDECL internal_malloc(size_t size)
-{
-    return malloc(size);
-}
-static void CJSON_CDECL internal_free(void *pointer)
-{
-    free(pointer);
-}
-static void * CJSON_CDECL internal_realloc(void *pointer, size_t size)
-{
-    return realloc(pointer, size);
-}
-#else
-#define internal_malloc malloc
-#define internal_free free
-#define internal_realloc realloc
-#endif
+        buffer[length++] = (unsigned char)('0' + (fractional >> shift));
+        fractional &= one - 1;
+        (*decimal_exponent)--;
 
-/* strlen of character literals resolved at compile time */
-#define static_strlen(string_literal) (sizeof(string_literal) - sizeof(""))
+        if (fractional <= delta)
+        {
+            break;
+        }
+    }
+    grisu2_round(buffer, length, distance, delta, fractional, one);
 
-static internal_hooks global_hooks = { internal_malloc, internal_free, internal_realloc };
+    return length;
+}
 
-static unsigned char* cJSON_strdup(const unsigned char* string, const internal_hooks * const hooks)
+/* The digits of a finite, positive number, and the exponent of their last digit. */
+static int grisu2(const double number, unsigned char * const buffer, int * const decimal_exponent)
 {
-    size_t length = 0;
-    unsigned char *copy = NULL;
-
-    if (string == NULL)
+    const unsigned long long bits = double_to_bits(number);
+    const unsigned long long fraction = bits & ((1ULL << 52) - 1);
+    const int biased_exponent = (int)((bits >> 52) & 0x7FF);
+    diy_fp value;
+    diy_fp plus;
+    diy_fp minus;
+    diy_fp power;
+    const cached_power *cached = NULL;
+    int k = 0;
+    int index = 0;
+
+    if (biased_exponent == 0)
+    {
+        value.f = fraction;
+        value.e = 1 - 1075;
+    }
+    else
     {
-        return NULL;
+        value.f = fraction | (1ULL << 52);
+        value.e = biased_exponent - 1075;
     }
 
-    length = strlen((const char*)string) + sizeof("");
-    copy = (unsigned char*)hooks->allocate(length);
-    if (copy == NULL)
+    /* the boundaries halfway to the neighbouring doubles; the lower one is closer at powers of two */
+    plus.f = (value.f << 1) + 1;
+    plus.e = value.e - 1;
+    if ((fraction == 0) && (biased_exponent > 1))
     {
-        return NULL;
+        minus.f = (value.f << 2) - 1;
+        minus.e = value.e - 2;
     }
-    memcpy(copy, string, length);
+    else
+    {
+        minus.f = (value.f << 1) - 1;
+        minus.e = value.e - 1;
+    }
+    plus = diy_fp_normalize(plus);
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+    value = diy_fp_normalize(value);
 
-    return copy;
+    /* a power of ten c such that the exponent of plus * c is in [alpha, gamma] */
+    k = CJSON_GRISU_ALPHA - plus.e - 1;
+    k = (k * 78913) / (1 << 18) + (k > 0);
+    index = (300 + k + 7) / 8;
+    cached = &cached_powers[index];
+    power.f = cached->f;
+    power.e = cached->e;
+
+    value = diy_fp_multiply(value, power);
+    plus = diy_fp_multiply(plus, power);
+    minus = diy_fp_multiply(minus, power);
+    /* shrink the interval by one unit on each side for the rounding errors of the multiplications */
+    plus.f--;
+    minus.f++;
+
+    *decimal_exponent = -cached->k;
+
+    return grisu2_digits(buffer, decimal_exponent, minus, value, plus);
 }
 
-CJSON_PUBLIC(void) cJSON_InitHooks(cJSON_Hooks* hooks)
+/* Formats the shortest digits of a finite number, the way JavaScript does: plain notation from 1e-6 to 1e21, exponent notation outside.
+ * Returns the length; the buffer needs 26 bytes. */
+static int format_double(const double number, unsigned char * const output)
 {
-    if (hooks == NULL)
+    unsigned char digits[20];
+    unsigned char *out = output;
+    int exponent = 0;
+    int length = 0;
+    int point = 0;
+    int i = 0;
+
+    if (number == 0)
     {
-        /* Reset hooks */
-        global_hooks.allocate = malloc;
-        global_hooks.deallocate = free;
-        global_hooks.reallocate = realloc;
-        return;
+        output[0] = '0';
+        output[1] = '\0';
+        return 1;
     }
-
-    global_hooks.allocate = malloc;
-    if (hooks->malloc_fn != NULL)
+    if (number < 0)
     {
-        global_hooks.allocate = hooks->malloc_fn;
+        *out++ = '-';
     }
 
-    global_hooks.deallocate = free;
-    if (hooks->free_fn != NULL)
+    length = grisu2((number < 0) ? -number : number, digits, &exponent);
+    /* the position of the decimal point after the first digit */
+    point = length + exponent;
+
+    if ((length <= point) && (point <= 21))
     {
-        global_hooks.deallocate = hooks->free_fn;
+        /* an integer: the digits and zeros */
+        memcpy(out, digits, (size_t)length);
+        out += length;
+        for (i = length; i < point; i++)
+        {
+            *out++ = '0';
+        }
     }
-
-    /* use realloc only if both free and malloc are used */
-    global_hooks.reallocate = NULL;
-    if ((global_hooks.allocate == malloc) && (global_hooks.deallocate == free))
+    else if ((0 < point) && (point <= 21))
     {
-        global_hooks.reallocate = realloc;
+        memcpy(out, digits, (size_t)point);
+        out += point;
+        *out++ = '.';
+        memcpy(out, digits + point, (size_t)(length - point));
+        out += length - point;
     }
-}
-
-/* Internal constructor. */
-static cJSON *cJSON_New_Item(const internal_hooks * const hooks)
-{
-    cJSON* node = (cJSON*)hooks->allocate(sizeof(cJSON));
-    if (node)
+    else if ((-6 < point) && (point <= 0))
     {
-        memset(node, '\0', sizeof(cJSON));
+        *out++ = '0';
+        *out++ = '.';
+        for (i = point; i < 0; i++)
+        {
+            *out++ = '0';
+        }
+        memcpy(out, digits, (size_t)length);
+        out += length;
     }
-
-    return node;
-}
-
-/* Delete a cJSON structure. */
-CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
-{
-    cJSON *next = NULL;
-    while (item != NULL)
+    else
     {
-        next = item->next;
-        if (!(item->type & cJSON_IsReference) && (item->child != NULL))
+        int printed_exponent = point - 1;
+
+        *out++ = digits[0];
+        if (length > 1)
         {
-            cJSON_Delete(item->child);
+            *out++ = '.';
+            memcpy(out, digits + 1, (size_t)(length - 1));
+            out += length - 1;
         }
-        if (!(item->type & cJSON_IsReference) && (item->valuestring != NULL))
+        *out++ = 'e';
+        *out++ = (printed_exponent < 0) ? '-' : '+';
+        if (printed_exponent < 0)
         {
-            global_hooks.deallocate(item->valuestring);
+            printed_exponent = -printed_exponent;
         }
-        if (!(item->type & cJSON_StringIsConst) && (item->string != NULL))
+        if (printed_exponent >= 100)
         {
-            global_hooks.deallocate(item->string);
+            *out++ = (unsigned char)('0' + (printed_exponent / 100));
         }
-        global_hooks.deallocate(item);
-        item = next;
+        if (printed_exponent >= 10)
+        {
+            *out++ = (unsigned char)('0' + ((printed_exponent / 10) % 10));
+        }
+        *out++ = (unsigned char)('0' + (printed_exponent % 10));
     }
-}
+    *out = '\0';
 
-/* get the decimal point character of the current locale */
-static unsigned char get_decimal_point(void)
-{
-#ifdef ENABLE_LOCALES
-    struct lconv *lconv = localeconv();
-    return (unsigned char) lconv->decimal_point[0];
-#else
-    return '.';
-#endif
+    return (int)(out - output);
 }
 
-typedef struct
-{
-    const unsigned char *content;
-    size_t length;
-    size_t offset;
-    size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
-    internal_hooks hooks;
-} parse_buffer;
-
-/* check if the given size is left to read in a given parse buffer (starting with 1) */
-#define can_read(buffer, size) ((buffer != NULL) && (((buffer)->offset + size) <= (buffer)->length))
-/* check if the buffer can be accessed at the given index (starting with 0) */
-#define can_access_at_index(buffer, index) ((buffer != NULL) && (((buffer)->offset + index) < (buffer)->length))
-#define cannot_access_at_index(buffer, index) (!can_access_at_index(buffer, index))
-/* get a pointer to the buffer at the position */
-#define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
-
 /* Parse the input text to generate a number, and populate the result into item. */
 static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_buffer)
 {
     double number = 0;
-    unsigned char *after_end = NULL;
-    unsigned char number_c_string[64];
-    unsigned char decimal_point = get_decimal_point();
-    size_t i = 0;
+    size_t length = 0;
 
     if ((input_buffer == NULL) || (input_buffer->content == NULL))
     {
         return false;
     }
 
-    /* copy the number into a temporary buffer and replace '.' with the decimal point
-     * of the current locale (for strtod)
-     * This also takes care of '\0' not necessarily being available for marking the end of the input */
-    for (i = 0; (i < (sizeof(number_c_string) - 1)) && can_access_at_index(input_buffer, i); i++)
-    {
-        switch (buffer_at_offset(input_buffer)[i])
-        {
-            case '0':
-            case '1':
-            case '2':
-            case '3':
-            case '4':
-            case '5':
-            case '6':
-            case '7':
-            case '8':
-            case '9':
-            case '+':
-            case '-':
-            case 'e':
-            case 'E':
-                number_c_string[i] = buffer_at_offset(input_buffer)[i];
-                break;
-
-            case '.':
-                number_c_string[i] = decimal_point;
-                break;
-
-            default:
-                goto loop_end;
-        }
-    }
-loop_end:
-    number_c_string[i] = '\0';
-
-    number = strtod((const char*)number_c_string, (char**)&after_end);
-    if (number_c_string == after_end)
+    length = read_number(buffer_at_offset(input_buffer), input_buffer->length - input_buffer->offset, &number);
+    if (length == 0)
     {
         return false; /* parse_error */
     }
@@ -374,7 +1951,7 @@ loop_end:
 
     item->type = cJSON_Number;
 
-    input_buffer->offset += (size_t)(after_end - number_c_string);
+    input_buffer->offset += length;
     return true;
 }
 
@@ -415,12 +1992,12 @@ CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
         strcpy(object->valuestring, valuestring);
         return object->valuestring;
     }
-    copy = (char*) cJSON_strdup((const unsigned char*)valuestring, &global_hooks);
+    copy = node_strdup(object, valuestring);
     if (copy == NULL)
     {
         return NULL;
     }
-    if (object->valuestring != NULL)
+    if ((object->valuestring != NULL) && owns_memory(object))
     {
         cJSON_free(object->valuestring);
     }
@@ -438,6 +2015,9 @@ typedef struct
     cJSON_bool noalloc;
     cJSON_bool format; /* is this print a formatted print */
     internal_hooks hooks;
+    /* when streaming, the printed text is handed to flush whenever the buffer is full */
+    cJSON_bool (*flush)(const unsigned char *data, size_t length, void *sink);
+    void *sink;
 } printbuffer;
 
 /* realloc printbuffer if necessary to have at least "needed" bytes more */
@@ -469,6 +2049,22 @@ static unsigned char* ensure(printbuffer * const p, size_t needed)
         return p->buffer + p->offset;
     }
 
+    if ((p->flush != NULL) && (p->offset > 0))
+    {
+        /* streaming: write out what has been printed so far and reuse the buffer */
+        if (!p->flush(p->buffer, p->offset, p->sink))
+        {
+            return NULL;
+        }
+        needed -= p->offset;
+        p->offset = 0;
+
+        if (needed <= p->length)
+        {
+            return p->buffer;
+        }
+    }
+
     if (p->noalloc) {
         return NULL;
     }
@@ -547,43 +2143,67 @@ static cJSON_bool compare_double(double a, double b)
 }
 
 /* Render the number nicely from the given item into a string. */
-static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
+/* Prints an integer, returns the number of characters. */
+static int format_integer(long value, unsigned char * const output)
 {
-    unsigned char *output_pointer = NULL;
-    double d = item->valuedouble;
+    unsigned char digits[24];
+    unsigned long magnitude = (value < 0) ? 0UL - (unsigned long)value : (unsigned long)value;
+    int count = 0;
     int length = 0;
-    size_t i = 0;
-    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
-    unsigned char decimal_point = get_decimal_point();
-    double test = 0.0;
 
-    if (output_buffer == NULL)
+    do
     {
-        return false;
+        digits[count++] = (unsigned char)('0' + (magnitude % 10));
+        magnitude /= 10;
+    }
+    while (magnitude != 0);
+
+    if (value < 0)
+    {
+        output[length++] = '-';
+    }
+    while (count > 0)
+    {
+        output[length++] = digits[--count];
     }
+    output[length] = '\0';
 
+    return length;
+}
+
+/* Prints a double into a buffer of at least 26 bytes the way numbers are printed: null for NaN and Infinity,
+ * integers that fit an int without a fraction, the shortest digits that read back to the same double otherwise. */
+static int format_number(const double d, const int valueint, unsigned char * const output)
+{
     /* This checks for NaN and Infinity */
     if (isnan(d) || isinf(d))
     {
-        length = sprintf((char*)number_buffer, "null");
+        memcpy(output, "null", sizeof("null"));
+        return (int)static_strlen("null");
     }
-	else if(d == (double)item->valueint)
-	{
-		length = sprintf((char*)number_buffer, "%d", item->valueint);
-	}
-    else
+
+    if (d == (double)valueint)
     {
-        /* Try 15 decimal places of precision to avoid nonsignificant nonzero digits */
-        length = sprintf((char*)number_buffer, "%1.15g", d);
+        return format_integer(valueint, output);
+    }
 
-        /* Check whether the original double can be recovered */
-        if ((sscanf((char*)number_buffer, "%lg", &test) != 1) || !compare_double((double)test, d))
-        {
-            /* If not, print with 17 decimal places of precision */
-            length = sprintf((char*)number_buffer, "%1.17g", d);
-        }
+    /* the shortest digits that read back to the same double, without the decimal point of the locale */
+    return format_double(d, output);
+}
+
+static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output_pointer = NULL;
+    int length = 0;
+    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
+
+    if (output_buffer == NULL)
+    {
+        return false;
     }
 
+    length = format_number(item->valuedouble, item->valueint, number_buffer);
+
     /* sprintf failed or buffer overrun occurred */
     if ((length < 0) || (length > (int)(sizeof(number_buffer) - 1)))
     {
@@ -597,23 +2217,123 @@ static cJSON_bool print_number(const cJSON * const item, printbuffer * const out
         return false;
     }
 
-    /* copy the printed number to the output and replace locale
-     * dependent decimal point with '.' */
-    for (i = 0; i < ((size_t)length); i++)
+    memcpy(output_pointer, number_buffer, (size_t)length + sizeof(""));
+    output_buffer->offset += (size_t)length;
+
+    return true;
+}
+
+/* The buffer of a packed array, which its valuestring points to: a header, then the elements, aligned for a double. */
+typedef struct
+{
+    size_t count;
+    int element_type;
+} packed_array;
+
+#define CJSON_PACKED_HEADER ((sizeof(packed_array) + sizeof(double) - 1) & ~(sizeof(double) - 1))
+#define packed_of(item) ((packed_array*)(void*)(item)->valuestring)
+#define packed_elements(packed) ((unsigned char*)(packed) + CJSON_PACKED_HEADER)
+
+static size_t packed_element_size(const int element_type)
+{
+    switch (element_type)
+    {
+        case cJSON_PackedDouble:
+            return sizeof(double);
+        case cJSON_PackedInt32:
+            return sizeof(int32_t);
+        case cJSON_PackedUint8:
+            return sizeof(uint8_t);
+        default:
+            return 0;
+    }
+}
+
+/* An element of a packed array as a double. */
+static double packed_value(const packed_array * const packed, const size_t index)
+{
+    const unsigned char *elements = packed_elements(packed);
+
+    switch (packed->element_type)
+    {
+        case cJSON_PackedDouble:
+            return ((const double*)(const void*)elements)[index];
+        case cJSON_PackedInt32:
+            return (double)((const int32_t*)(const void*)elements)[index];
+        default:
+            return (double)elements[index];
+    }
+}
+
+/* Render the elements of a packed array without going through nodes. */
+static cJSON_bool print_packed_array(const packed_array * const packed, printbuffer * const output_buffer)
+{
+    const unsigned char *elements = packed_elements(packed);
+    unsigned char *output_pointer = NULL;
+    /* a number, then a comma and a space */
+    unsigned char number_buffer[26 + 2];
+    size_t index = 0;
+    int length = 0;
+
+    for (index = 0; index < packed->count; index++)
+    {
+        if (packed->element_type == cJSON_PackedDouble)
+        {
+            double d = ((const double*)(const void*)elements)[index];
+            int valueint = (d >= INT_MAX) ? INT_MAX : ((d <= (double)INT_MIN) ? INT_MIN : (int)d);
+
+            length = format_number(d, valueint, number_buffer);
+        }
+        else if (packed->element_type == cJSON_PackedInt32)
+        {
+            length = format_integer(((const int32_t*)(const void*)elements)[index], number_buffer);
+        }
+        else
+        {
+            length = format_integer(elements[index], number_buffer);
+        }
+
+        if (index + 1 < packed->count)
+        {
+            number_buffer[length++] = ',';
+            if (output_buffer->format)
+            {
+                number_buffer[length++] = ' ';
+            }
+        }
+
+        output_pointer = ensure(output_buffer, (size_t)length + sizeof(""));
+        if (output_pointer == NULL)
+        {
+            return false;
+        }
+        memcpy(output_pointer, number_buffer, (size_t)length);
+        output_pointer[length] = '\0';
+        output_buffer->offset += (size_t)length;
+    }
+
+    return true;
+}
+
+/* A new packed buffer for count elements, from the hooks (or the arena of the document) the tree is parsed with. */
+static packed_array *packed_allocate(const int element_type, const size_t count, const internal_hooks * const hooks)
+{
+    size_t element_size = packed_element_size(element_type);
+    packed_array *packed = NULL;
+
+    if ((element_size == 0) || (count > ((size_t)-1 - CJSON_PACKED_HEADER) / element_size))
+    {
+        return NULL;
+    }
+
+    packed = (packed_array*)hooks_allocate(hooks, CJSON_PACKED_HEADER + count * element_size);
+    if (packed != NULL)
     {
-        if (number_buffer[i] == decimal_point)
-        {
-            output_pointer[i] = '.';
-            continue;
-        }
-
-        output_pointer[i] = number_buffer[i];
+        packed->count = count;
+        packed->element_type = element_type;
     }
-    output_pointer[i] = '\0';
 
-    output_buffer->offset += (size_t)length;
-
-    return true;
+    return packed;
 }
 
 /* parse 4 digit hexadecimal number */
@@ -774,47 +2494,219 @@ fail:
     return 0;
 }
 
+/* The length of the UTF-8 sequence at the start of input (RFC 3629: no overlong forms, surrogates or code points past U+10FFFF), 0 if it is invalid. */
+static size_t utf8_sequence_length(const unsigned char * const input, const size_t length)
+{
+    size_t sequence_length = 0;
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+    size_t i = 0;
+
+    if ((input[0] >= 0xC2) && (input[0] <= 0xDF))
+    {
+        sequence_length = 2;
+    }
+    else if ((input[0] & 0xF0) == 0xE0)
+    {
+        sequence_length = 3;
+        low = (input[0] == 0xE0) ? 0xA0 : 0x80;
+        high = (input[0] == 0xED) ? 0x9F : 0xBF;
+    }
+    else if ((input[0] >= 0xF0) && (input[0] <= 0xF4))
+    {
+        sequence_length = 4;
+        low = (input[0] == 0xF0) ? 0x90 : 0x80;
+        high = (input[0] == 0xF4) ? 0x8F : 0xBF;
+    }
+    else
+    {
+        return 0;
+    }
+
+    if (length < sequence_length)
+    {
+        return 0;
+    }
+
+    /* the second byte has the tighter bounds, the others are plain continuation bytes */
+    if ((input[1] < low) || (input[1] > high))
+    {
+        return 0;
+    }
+    for (i = 2; i < sequence_length; i++)
+    {
+        if ((input[i] & 0xC0) != 0x80)
+        {
+            return 0;
+        }
+    }
+
+    return sequence_length;
+}
+
+/* The hash of the characters of a key, with the case kept (FNV-1a). */
+static unsigned int intern_hash(const unsigned char *key, size_t length)
+{
+    unsigned int hash = 2166136261u;
+    size_t i = 0;
+
+    for (i = 0; i < length; i++)
+    {
+        hash = (hash ^ (unsigned int)key[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+/* Moves the keys of a table to twice as many slots. */
+static cJSON_bool grow_key_table(cJSON_KeyTable * const table)
+{
+    size_t capacity = (table->capacity == 0) ? 64 : (table->capacity * 2);
+    interned_key *slots = NULL;
+    size_t i = 0;
+
+    slots = (interned_key*)hooks_allocate(&table->hooks, capacity * sizeof(interned_key));
+    if (slots == NULL)
+    {
+        return false;
+    }
+    memset(slots, '\0', capacity * sizeof(interned_key));
+
+    for (i = 0; i < table->capacity; i++)
+    {
+        size_t slot = 0;
+
+        if (table->slots[i].key == NULL)
+        {
+            continue;
+        }
+
+        for (slot = table->slots[i].hash & (capacity - 1); slots[slot].key != NULL; slot = (slot + 1) & (capacity - 1))
+        {
+        }
+        slots[slot] = table->slots[i];
+    }
+
+    if (table->slots != NULL)
+    {
+        hooks_deallocate(&table->hooks, table->slots);
+    }
+
+    table->slots = slots;
+    table->capacity = capacity;
+
+    return true;
+}
+
+/* The stored copy of a key, made the first time the key is seen. Keys are compared by hash and length before their characters. */
+static const char *intern_key(cJSON_KeyTable * const table, const unsigned char *key, size_t length)
+{
+    unsigned int hash = intern_hash(key, length);
+    char *copy = NULL;
+    size_t slot = 0;
+
+    if (table->capacity != 0)
+    {
+        for (slot = hash & (table->capacity - 1); table->slots[slot].key != NULL; slot = (slot + 1) & (table->capacity - 1))
+        {
+            const interned_key *entry = &table->slots[slot];
+            if ((entry->hash == hash) && (entry->length == length) && (memcmp(entry->key, key, length) == 0))
+            {
+                return entry->key;
+            }
+        }
+    }
+
+    /* at most half full, so probe sequences stay short */
+    if (((table->count + 1) * 2 > table->capacity) && !grow_key_table(table))
+    {
+        return NULL;
+    }
+
+    copy = (char*)hooks_allocate(&table->hooks, length + sizeof(""));
+    if (copy == NULL)
+    {
+        return NULL;
+    }
+    memcpy(copy, key, length);
+    copy[length] = '\0';
+
+    for (slot = hash & (table->capacity - 1); table->slots[slot].key != NULL; slot = (slot + 1) & (table->capacity - 1))
+    {
+    }
+    table->slots[slot].key = copy;
+    table->slots[slot].length = length;
+    table->slots[slot].hash = hash;
+    table->count++;
+
+    return copy;
+}
+
 /* Parse the input text into an unescaped cinput, and populate item. */
 static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_buffer)
 {
     const unsigned char *input_pointer = buffer_at_offset(input_buffer) + 1;
     const unsigned char *input_end = buffer_at_offset(input_buffer) + 1;
+    const unsigned char * const content_end = input_buffer->content + input_buffer->length;
     unsigned char *output_pointer = NULL;
     unsigned char *output = NULL;
+    size_t skipped_bytes = 0;
 
-    /* not a string */
-    if (buffer_at_offset(input_buffer)[0] != '\"')
+    /* not a string, or the input ended before it (after a ',' or a '{' at the very end of an input that is not null terminated) */
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '\"'))
     {
         goto fail;
     }
 
     {
-        /* calculate approximate size of the output (overestimate) */
+        /* find the end of the string and calculate approximate size of the output (overestimate),
+         * jumping over the plain ASCII runs and validating the rest on the way */
         size_t allocation_length = 0;
-        size_t skipped_bytes = 0;
-        while (((size_t)(input_end - input_buffer->content) < input_buffer->length) && (*input_end != '\"'))
+        for (;;)
         {
+            input_end += input_buffer->scan->string(input_end, (size_t)(content_end - input_end));
+            if (input_end >= content_end)
+            {
+                goto fail; /* string ended unexpectedly */
+            }
+
+            if (*input_end == '\"')
+            {
+                break;
+            }
+
             /* is escape sequence */
-            if (input_end[0] == '\\')
+            if (*input_end == '\\')
             {
-                if ((size_t)(input_end + 1 - input_buffer->content) >= input_buffer->length)
+                if ((input_end + 1) >= content_end)
                 {
                     /* prevent buffer overflow when last input character is a backslash */
                     goto fail;
                 }
                 skipped_bytes++;
-                input_end++;
+                input_end += 2;
+            }
+            /* control characters have to be escaped */
+            else if (*input_end < 0x20)
+            {
+                input_pointer = input_end;
+                goto fail;
+            }
+            else
+            {
+                size_t sequence_length = utf8_sequence_length(input_end, (size_t)(content_end - input_end));
+                if (sequence_length == 0)
+                {
+                    input_pointer = input_end;
+                    goto fail; /* invalid UTF-8 */
+                }
+                input_end += sequence_length;
             }
-            input_end++;
-        }
-        if (((size_t)(input_end - input_buffer->content) >= input_buffer->length) || (*input_end != '\"'))
-        {
-            goto fail; /* string ended unexpectedly */
         }
 
         /* This is at most how much we need for the output */
         allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
-        output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
+        output = (unsigned char*)hooks_allocate(&input_buffer->hooks, allocation_length + sizeof(""));
         if (output == NULL)
         {
             goto fail; /* allocation failure */
@@ -822,15 +2714,21 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
     }
 
     output_pointer = output;
-    /* loop through the string literal */
+    /* loop through the string literal, copying the runs between escape sequences at once */
     while (input_pointer < input_end)
     {
-        if (*input_pointer != '\\')
+        const unsigned char *escape = (skipped_bytes == 0) ? NULL : (const unsigned char*)memchr(input_pointer, '\\', (size_t)(input_end - input_pointer));
+        if (escape == NULL)
         {
-            *output_pointer++ = *input_pointer++;
+            escape = input_end;
         }
+
+        memcpy(output_pointer, input_pointer, (size_t)(escape - input_pointer));
+        output_pointer += escape - input_pointer;
+        input_pointer = escape;
+
         /* escape sequence */
-        else
+        if (input_pointer < input_end)
         {
             unsigned char sequence_length = 2;
             if ((input_end - input_pointer) < 1)
@@ -892,7 +2790,7 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
 fail:
     if (output != NULL)
     {
-        input_buffer->hooks.deallocate(output);
+        hooks_deallocate(&input_buffer->hooks, output);
     }
 
     if (input_pointer != NULL)
@@ -1052,10 +2950,7 @@ static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
         return buffer;
     }
 
-    while (can_access_at_index(buffer, 0) && (buffer_at_offset(buffer)[0] <= 32))
-    {
-       buffer->offset++;
-    }
+    buffer->offset += buffer->scan->whitespace(buffer_at_offset(buffer), buffer->length - buffer->offset);
 
     if (buffer->offset == buffer->length)
     {
@@ -1097,14 +2992,16 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return
 }
 
 /* Parse an object - create a new root, and populate. */
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+/* Parses with the given hooks and the limits of a context (NULL for the defaults), and reports the error position into the given error
+ * (the global one, or that of a context). Nodes of a document are not freed on failure, the caller drops the whole arena instead. */
+static cJSON *parse_with_hooks(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated, const internal_hooks * const hooks, const cJSON_Context * const context, error * const parse_error)
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    parse_buffer buffer = { 0, 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0 };
     cJSON *item = NULL;
 
     /* reset error position */
-    global_error.json = NULL;
-    global_error.position = 0;
+    parse_error->json = NULL;
+    parse_error->position = 0;
 
     if (value == NULL || 0 == buffer_length)
     {
@@ -1114,77 +3011,339 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer
     buffer.content = (const unsigned char*)value;
     buffer.length = buffer_length;
     buffer.offset = 0;
-    buffer.hooks = global_hooks;
+    buffer.nesting_limit = (context != NULL) ? context->nesting_limit : CJSON_NESTING_LIMIT;
+    buffer.pack_threshold = (context != NULL) ? context->pack_threshold : 0;
+    buffer.keys = (hooks->document != NULL) ? &hooks->document->keys : ((context != NULL) ? context->keys : NULL);
+    buffer.hooks = *hooks;
+    buffer.scan = select_scan_kernels();
 
-    item = cJSON_New_Item(&global_hooks);
+    item = cJSON_New_Item(hooks);
     if (item == NULL) /* memory fail */
     {
         goto fail;
     }
 
-    if (!parse_value(item, buffer_skip_whitespace(skip_utf8_bom(&buffer))))
+    if (!parse_value(item, buffer_skip_whitespace(skip_utf8_bom(&buffer))))
+    {
+        /* parse failure. ep is set. */
+        goto fail;
+    }
+
+    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
+    if (require_null_terminated)
+    {
+        buffer_skip_whitespace(&buffer);
+        if ((buffer.offset >= buffer.length) || buffer_at_offset(&buffer)[0] != '\0')
+        {
+            goto fail;
+        }
+    }
+    if (return_parse_end)
+    {
+        *return_parse_end = (const char*)buffer_at_offset(&buffer);
+    }
+
+    return item;
+
+fail:
+    if (item != NULL)
+    {
+        delete_with_hooks(item, hooks);
+    }
+
+    if (value != NULL)
+    {
+        error local_error;
+        local_error.json = (const unsigned char*)value;
+        local_error.position = 0;
+
+        if (buffer.offset < buffer.length)
+        {
+            local_error.position = buffer.offset;
+        }
+        else if (buffer.length > 0)
+        {
+            local_error.position = buffer.length - 1;
+        }
+
+        if (return_parse_end != NULL)
+        {
+            *return_parse_end = (const char*)local_error.json + local_error.position;
+        }
+
+        *parse_error = local_error;
+    }
+
+    return NULL;
+}
+
+/* Default options for cJSON_Parse */
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    return parse_with_hooks(value, buffer_length, return_parse_end, require_null_terminated, &global_hooks, NULL, &global_error);
+}
+
+CJSON_PUBLIC(cJSON_Document *) cJSON_ParseDocument(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    internal_hooks hooks = global_hooks;
+    cJSON_Document *document = NULL;
+
+    document = (cJSON_Document*)global_hooks.allocate(sizeof(cJSON_Document));
+    if (document == NULL)
+    {
+        global_error.json = NULL;
+        global_error.position = 0;
+        return NULL;
+    }
+
+    document->root = NULL;
+    document->chunks = NULL;
+    /* a tree takes more memory than its text, so the first chunk holds at least the whole input */
+    document->chunk_size = (buffer_length > 4096) ? buffer_length : 4096;
+#ifdef CJSON_ATOMIC_INDEX
+    atomic_flag_clear(&document->lock);
+#endif
+
+    hooks.document = document;
+
+    document->keys.hooks = hooks;
+    document->keys.capacity = 0;
+    document->keys.count = 0;
+    document->keys.slots = NULL;
+
+    document->root = parse_with_hooks(value, buffer_length, return_parse_end, require_null_terminated, &hooks, NULL, &global_error);
+    if (document->root == NULL)
+    {
+        cJSON_DeleteDocument(document);
+        return NULL;
+    }
+
+    return document;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_GetDocumentRoot(const cJSON_Document * const document)
+{
+    if (document == NULL)
+    {
+        return NULL;
+    }
+
+    return document->root;
+}
+
+CJSON_PUBLIC(void) cJSON_DeleteDocument(cJSON_Document *document)
+{
+    document_chunk *chunk = NULL;
+
+    if (document == NULL)
+    {
+        return;
+    }
+
+    chunk = document->chunks;
+    while (chunk != NULL)
+    {
+        document_chunk *next = chunk->next;
+        global_hooks.deallocate(chunk);
+        chunk = next;
+    }
+
+    global_hooks.deallocate(document);
+}
+
+CJSON_PUBLIC(size_t) cJSON_ReadNumber(const char *value, size_t length, double *number)
+{
+    double result = 0;
+    size_t read = 0;
+
+    if ((value == NULL) || (number == NULL))
+    {
+        return 0;
+    }
+
+    read = read_number((const unsigned char*)value, length, &result);
+    if (read > 0)
+    {
+        *number = result;
+    }
+
+    return read;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
+{
+    return cJSON_ParseWithOpts(value, 0, 0);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_length)
+{
+    return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
+}
+
+/* The hooks of a context, completed the way cJSON_InitHooks completes the global ones. */
+static internal_hooks context_hooks(const cJSON_Context * const context)
+{
+    internal_hooks hooks = { NULL, NULL, NULL, NULL };
+
+    hooks.allocate = (context->hooks.malloc_fn != NULL) ? context->hooks.malloc_fn : malloc;
+    hooks.deallocate = (context->hooks.free_fn != NULL) ? context->hooks.free_fn : free;
+
+    /* use realloc only if both free and malloc are used */
+    if ((hooks.allocate == malloc) && (hooks.deallocate == free))
+    {
+        hooks.reallocate = realloc;
+    }
+
+    return hooks;
+}
+
+CJSON_PUBLIC(void) cJSON_InitContext(cJSON_Context *context, const cJSON_Hooks *hooks)
+{
+    if (context == NULL)
+    {
+        return;
+    }
+
+    context->hooks.malloc_fn = (hooks != NULL) ? hooks->malloc_fn : NULL;
+    context->hooks.free_fn = (hooks != NULL) ? hooks->free_fn : NULL;
+    context->nesting_limit = CJSON_NESTING_LIMIT;
+    context->max_length = 0;
+    context->pack_threshold = 0;
+    context->intern_keys = false;
+    context->keys = NULL;
+    context->error_json = NULL;
+    context->error_position = 0;
+}
+
+/* The key table of a context, made on first use with the hooks of the context. */
+static cJSON_KeyTable *context_keys(cJSON_Context * const context)
+{
+    cJSON_KeyTable *table = context->keys;
+
+    if (table == NULL)
+    {
+        internal_hooks hooks = context_hooks(context);
+
+        table = (cJSON_KeyTable*)hooks.allocate(sizeof(cJSON_KeyTable));
+        if (table == NULL)
+        {
+            return NULL;
+        }
+
+        table->hooks = hooks;
+        table->capacity = 0;
+        table->count = 0;
+        table->slots = NULL;
+
+        context->keys = table;
+    }
+
+    return table;
+}
+
+CJSON_PUBLIC(void) cJSON_ReleaseContext(cJSON_Context *context)
+{
+    cJSON_KeyTable *table = NULL;
+    size_t i = 0;
+
+    if ((context == NULL) || (context->keys == NULL))
     {
-        /* parse failure. ep is set. */
-        goto fail;
+        return;
     }
 
-    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
-    if (require_null_terminated)
+    table = context->keys;
+    for (i = 0; i < table->capacity; i++)
     {
-        buffer_skip_whitespace(&buffer);
-        if ((buffer.offset >= buffer.length) || buffer_at_offset(&buffer)[0] != '\0')
+        if (table->slots[i].key != NULL)
         {
-            goto fail;
+            table->hooks.deallocate((void*)cast_away_const(table->slots[i].key));
         }
     }
-    if (return_parse_end)
+
+    if (table->slots != NULL)
     {
-        *return_parse_end = (const char*)buffer_at_offset(&buffer);
+        table->hooks.deallocate(table->slots);
     }
+    table->hooks.deallocate(table);
 
-    return item;
+    context->keys = NULL;
+}
 
-fail:
-    if (item != NULL)
+CJSON_PUBLIC(const char *) cJSON_InternKey_ctx(cJSON_Context *context, const char *key)
+{
+    cJSON_KeyTable *table = NULL;
+
+    if ((context == NULL) || (key == NULL) || ((table = context_keys(context)) == NULL))
     {
-        cJSON_Delete(item);
+        return NULL;
     }
 
-    if (value != NULL)
+    return intern_key(table, (const unsigned char*)key, strlen(key));
+}
+
+CJSON_PUBLIC(const char *) cJSON_GetErrorPtr_ctx(const cJSON_Context *context)
+{
+    if ((context == NULL) || (context->error_json == NULL))
     {
-        error local_error;
-        local_error.json = (const unsigned char*)value;
-        local_error.position = 0;
+        return NULL;
+    }
 
-        if (buffer.offset < buffer.length)
-        {
-            local_error.position = buffer.offset;
-        }
-        else if (buffer.length > 0)
-        {
-            local_error.position = buffer.length - 1;
-        }
+    return context->error_json + context->error_position;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts_ctx(cJSON_Context *context, const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    internal_hooks hooks;
+    error parse_error = { NULL, 0 };
+    cJSON *item = NULL;
+
+    if (context == NULL)
+    {
+        return NULL;
+    }
 
+    if ((value != NULL) && (context->max_length != 0) && (buffer_length > context->max_length))
+    {
+        /* the input is refused where it goes over the limit */
+        context->error_json = value;
+        context->error_position = context->max_length;
         if (return_parse_end != NULL)
         {
-            *return_parse_end = (const char*)local_error.json + local_error.position;
+            *return_parse_end = value + context->max_length;
         }
+        return NULL;
+    }
 
-        global_error = local_error;
+    if (context->intern_keys && (context_keys(context) == NULL))
+    {
+        context->error_json = NULL;
+        context->error_position = 0;
+        return NULL;
     }
 
-    return NULL;
+    hooks = context_hooks(context);
+    item = parse_with_hooks(value, buffer_length, return_parse_end, require_null_terminated, &hooks, context, &parse_error);
+
+    context->error_json = (const char*)parse_error.json;
+    context->error_position = parse_error.position;
+
+    return item;
 }
 
-/* Default options for cJSON_Parse */
-CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength_ctx(cJSON_Context *context, const char *value, size_t buffer_length)
 {
-    return cJSON_ParseWithOpts(value, 0, 0);
+    return cJSON_ParseWithLengthOpts_ctx(context, value, buffer_length, 0, 0);
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_length)
+CJSON_PUBLIC(cJSON *) cJSON_Parse_ctx(cJSON_Context *context, const char *value)
 {
-    return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
+    if (value == NULL)
+    {
+        return NULL;
+    }
+
+    /* Adding null character size, as cJSON_ParseWithOpts does. */
+    return cJSON_ParseWithLengthOpts_ctx(context, value, strlen(value) + sizeof(""), 0, 0);
 }
 
 #define cjson_min(a, b) (((a) < (b)) ? (a) : (b))
@@ -1264,9 +3423,35 @@ CJSON_PUBLIC(char *) cJSON_PrintUnformatted(const cJSON *item)
     return (char*)print(item, false, &global_hooks);
 }
 
+CJSON_PUBLIC(char *) cJSON_Print_ctx(const cJSON_Context *context, const cJSON *item)
+{
+    internal_hooks hooks;
+
+    if (context == NULL)
+    {
+        return NULL;
+    }
+
+    hooks = context_hooks(context);
+    return (char*)print(item, true, &hooks);
+}
+
+CJSON_PUBLIC(char *) cJSON_PrintUnformatted_ctx(const cJSON_Context *context, const cJSON *item)
+{
+    internal_hooks hooks;
+
+    if (context == NULL)
+    {
+        return NULL;
+    }
+
+    hooks = context_hooks(context);
+    return (char*)print(item, false, &hooks);
+}
+
 CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON_bool fmt)
 {
-    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, 0 };
 
     if (prebuffer < 0)
     {
@@ -1296,7 +3481,7 @@ CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON
 
 CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, const int length, const cJSON_bool format)
 {
-    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, 0 };
 
     if ((length < 0) || (buffer == NULL))
     {
@@ -1313,6 +3498,97 @@ CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, cons
     return print_value(item, &p);
 }
 
+static cJSON_bool flush_to_stream(const unsigned char *data, size_t length, void *sink)
+{
+    return fwrite(data, 1, length, (FILE*)sink) == length;
+}
+
+static cJSON_bool flush_to_file_descriptor(const unsigned char *data, size_t length, void *sink)
+{
+    int fd = *(const int*)sink;
+
+    while (length > 0)
+    {
+#if defined(_WIN32)
+        int written = _write(fd, data, (unsigned int)cjson_min(length, INT_MAX));
+#else
+        ssize_t written = write(fd, data, length);
+#endif
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+
+    return true;
+}
+
+static cJSON_bool print_to_sink(const cJSON * const item, cJSON_bool format, cJSON_bool (*flush)(const unsigned char*, size_t, void*), void *sink)
+{
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, 0 };
+    cJSON_bool success = false;
+
+    if (item == NULL)
+    {
+        return false;
+    }
+
+    p.buffer = (unsigned char*)global_hooks.allocate(CJSON_STREAM_BUFFER_SIZE);
+    if (p.buffer == NULL)
+    {
+        return false;
+    }
+
+    p.length = CJSON_STREAM_BUFFER_SIZE;
+    p.offset = 0;
+    p.noalloc = false;
+    p.format = format;
+    p.hooks = global_hooks;
+    p.flush = flush;
+    p.sink = sink;
+
+    if (print_value(item, &p))
+    {
+        update_offset(&p);
+        /* write out the rest */
+        success = (p.offset == 0) || flush(p.buffer, p.offset, sink);
+    }
+
+    /* ensure frees the buffer if it fails to grow it */
+    if (p.buffer != NULL)
+    {
+        global_hooks.deallocate(p.buffer);
+    }
+
+    return success;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintToStream(const cJSON *item, FILE *stream, cJSON_bool format)
+{
+    if (stream == NULL)
+    {
+        return false;
+    }
+
+    return print_to_sink(item, format, flush_to_stream, stream);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintToFileDescriptor(const cJSON *item, int fd, cJSON_bool format)
+{
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    return print_to_sink(item, format, flush_to_file_descriptor, &fd);
+}
+
 /* Parser core - when encountering text, process appropriately. */
 static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer)
 {
@@ -1442,13 +3718,144 @@ static cJSON_bool print_value(const cJSON * const item, printbuffer * const outp
     }
 }
 
+/* Reads the elements of an array straight into a packed buffer of the narrowest type that holds them all exactly, starting at the first
+ * element and stopping at the closing bracket. Gives up, leaving the offset where it was, as soon as an element is not a number
+ * (or the array is shorter than the threshold), so parse_array reads it the ordinary way. */
+static cJSON_bool parse_packed_array(cJSON * const item, parse_buffer * const input_buffer)
+{
+    const size_t start = input_buffer->offset;
+    const internal_hooks * const hooks = &input_buffer->hooks;
+    double *values = NULL;
+    size_t count = 0;
+    size_t capacity = 0;
+    size_t index = 0;
+    cJSON_bool integers = true;
+    double minimum = 0;
+    double maximum = 0;
+    packed_array *packed = NULL;
+    int element_type = cJSON_PackedDouble;
+
+    for (;;)
+    {
+        double number = 0;
+        size_t length = 0;
+        unsigned char first = buffer_at_offset(input_buffer)[0];
+
+        if ((first != '-') && ((first < '0') || (first > '9')))
+        {
+            goto fail;
+        }
+
+        length = read_number(buffer_at_offset(input_buffer), input_buffer->length - input_buffer->offset, &number);
+        if (length == 0)
+        {
+            goto fail;
+        }
+
+        if (count == capacity)
+        {
+            double *larger = NULL;
+
+            capacity = (capacity == 0) ? 64 : capacity * 2;
+            larger = (double*)hooks->allocate(capacity * sizeof(double));
+            if (larger == NULL)
+            {
+                goto fail;
+            }
+            if (values != NULL)
+            {
+                memcpy(larger, values, count * sizeof(double));
+                hooks->deallocate(values);
+            }
+            values = larger;
+        }
+        values[count++] = number;
+
+        /* -0 and fractions only fit a double */
+        if (!((number >= -2147483648.0) && (number <= 2147483647.0) && ((double)(int32_t)number == number)) || (double_to_bits(number) == 0x8000000000000000ULL))
+        {
+            integers = false;
+        }
+        minimum = ((count == 1) || (number < minimum)) ? number : minimum;
+        maximum = ((count == 1) || (number > maximum)) ? number : maximum;
+
+        input_buffer->offset += length;
+        buffer_skip_whitespace(input_buffer);
+        if (cannot_access_at_index(input_buffer, 0))
+        {
+            goto fail;
+        }
+        if (buffer_at_offset(input_buffer)[0] == ']')
+        {
+            break;
+        }
+        if (buffer_at_offset(input_buffer)[0] != ',')
+        {
+            goto fail;
+        }
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (cannot_access_at_index(input_buffer, 0))
+        {
+            goto fail;
+        }
+    }
+
+    if (count < input_buffer->pack_threshold)
+    {
+        goto fail;
+    }
+
+    if (integers)
+    {
+        element_type = ((minimum >= 0) && (maximum <= 255)) ? cJSON_PackedUint8 : cJSON_PackedInt32;
+    }
+
+    packed = packed_allocate(element_type, count, hooks);
+    if (packed == NULL)
+    {
+        goto fail;
+    }
+
+    for (index = 0; index < count; index++)
+    {
+        if (element_type == cJSON_PackedDouble)
+        {
+            ((double*)(void*)packed_elements(packed))[index] = values[index];
+        }
+        else if (element_type == cJSON_PackedInt32)
+        {
+            ((int32_t*)(void*)packed_elements(packed))[index] = (int32_t)values[index];
+        }
+        else
+        {
+            packed_elements(packed)[index] = (uint8_t)values[index];
+        }
+    }
+
+    hooks->deallocate(values);
+    item->valuestring = (char*)packed;
+
+    return true;
+
+fail:
+    if (values != NULL)
+    {
+        hooks->deallocate(values);
+    }
+    input_buffer->offset = start;
+
+    return false;
+}
+
 /* Build an array from input text. */
 static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buffer)
 {
     cJSON *head = NULL; /* head of the linked list */
     cJSON *current_item = NULL;
+    cJSON_bool packed = false;
 
-    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
+    if (input_buffer->depth >= input_buffer->nesting_limit)
     {
         return false; /* to deeply nested */
     }
@@ -1475,6 +3882,13 @@ static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buf
         goto fail;
     }
 
+    /* arrays of numbers go into one buffer when the context asks for it */
+    if ((input_buffer->pack_threshold != 0) && parse_packed_array(item, input_buffer))
+    {
+        packed = true;
+        goto success;
+    }
+
     /* step back to character in front of the first element */
     input_buffer->offset--;
     /* loop through the comma separated array elements */
@@ -1524,7 +3938,7 @@ success:
         head->prev = current_item;
     }
 
-    item->type = cJSON_Array;
+    item->type = packed ? (cJSON_Array | cJSON_IsPacked) : cJSON_Array;
     item->child = head;
 
     input_buffer->offset++;
@@ -1534,7 +3948,7 @@ success:
 fail:
     if (head != NULL)
     {
-        cJSON_Delete(head);
+        delete_with_hooks(head, &input_buffer->hooks);
     }
 
     return false;
@@ -1564,6 +3978,11 @@ static cJSON_bool print_array(const cJSON * const item, printbuffer * const outp
     output_buffer->offset++;
     output_buffer->depth++;
 
+    if ((item->type & cJSON_IsPacked) && (item->valuestring != NULL) && !print_packed_array(packed_of(item), output_buffer))
+    {
+        return false;
+    }
+
     while (current_element != NULL)
     {
         if (!print_value(current_element, output_buffer))
@@ -1603,12 +4022,64 @@ static cJSON_bool print_array(const cJSON * const item, printbuffer * const outp
 }
 
 /* Build an object from the text. */
+/* Parses the name of a member into its interned copy. A name without escape sequences or non-ASCII characters is looked up
+ * where it is in the input, so a name seen before costs no allocation; the others are decoded first. */
+static cJSON_bool parse_interned_key(cJSON * const item, parse_buffer * const input_buffer)
+{
+    const unsigned char * const input_pointer = buffer_at_offset(input_buffer) + 1;
+    const unsigned char * const content_end = input_buffer->content + input_buffer->length;
+    const char *key = NULL;
+    size_t length = 0;
+
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '\"'))
+    {
+        return false; /* not a string */
+    }
+
+    length = input_buffer->scan->string(input_pointer, (size_t)(content_end - input_pointer));
+    if ((input_pointer + length < content_end) && (input_pointer[length] == '\"'))
+    {
+        key = intern_key(input_buffer->keys, input_pointer, length);
+        if (key == NULL)
+        {
+            return false; /* allocation failure */
+        }
+
+        input_buffer->offset = (size_t)(input_pointer + length + 1 - input_buffer->content);
+    }
+    else
+    {
+        if (!parse_string(item, input_buffer))
+        {
+            return false;
+        }
+
+        key = intern_key(input_buffer->keys, (const unsigned char*)item->valuestring, strlen(item->valuestring));
+        hooks_deallocate(&input_buffer->hooks, item->valuestring);
+        item->valuestring = NULL;
+        item->type = cJSON_Invalid;
+        if (key == NULL)
+        {
+            return false; /* allocation failure */
+        }
+    }
+
+    item->string = (char*)cast_away_const(key);
+    if (input_buffer->hooks.document == NULL)
+    {
+        /* the key belongs to the context */
+        item->type = cJSON_StringIsConst;
+    }
+
+    return true;
+}
+
 static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer)
 {
     cJSON *head = NULL; /* linked list head */
     cJSON *current_item = NULL;
 
-    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
+    if (input_buffer->depth >= input_buffer->nesting_limit)
     {
         return false; /* to deeply nested */
     }
@@ -1662,16 +4133,26 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
         /* parse the name of the child */
         input_buffer->offset++;
         buffer_skip_whitespace(input_buffer);
-        if (!parse_string(current_item, input_buffer))
+        if (input_buffer->keys != NULL)
+        {
+            if (!parse_interned_key(current_item, input_buffer))
+            {
+                goto fail; /* failed to parse name */
+            }
+        }
+        else
         {
-            goto fail; /* failed to parse name */
+            if (!parse_string(current_item, input_buffer))
+            {
+                goto fail; /* failed to parse name */
+            }
+
+            /* swap valuestring and string, because we parsed the name */
+            current_item->string = current_item->valuestring;
+            current_item->valuestring = NULL;
         }
         buffer_skip_whitespace(input_buffer);
 
-        /* swap valuestring and string, because we parsed the name */
-        current_item->string = current_item->valuestring;
-        current_item->valuestring = NULL;
-
         if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
         {
             goto fail; /* invalid object */
@@ -1684,6 +4165,11 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
         {
             goto fail; /* failed to parse value */
         }
+        /* parse_value sets the type: mark the key interned by a context again, so it is not freed with the item */
+        if ((input_buffer->keys != NULL) && (input_buffer->hooks.document == NULL))
+        {
+            current_item->type |= cJSON_StringIsConst;
+        }
         buffer_skip_whitespace(input_buffer);
     }
     while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
@@ -1709,7 +4195,7 @@ success:
 fail:
     if (head != NULL)
     {
-        cJSON_Delete(head);
+        delete_with_hooks(head, &input_buffer->hooks);
     }
 
     return false;
@@ -1829,10 +4315,43 @@ static cJSON_bool print_object(const cJSON * const item, printbuffer * const out
     return true;
 }
 
+/* Builds the vector of the children of an array and publishes it. Lookups go on without it if memory is short. */
+static void build_vector(const cJSON * const array, const size_t count)
+{
+    array_vector *vector = NULL;
+    array_vector *expected = NULL;
+    cJSON *child = NULL;
+    size_t position = 0;
+
+    vector = (array_vector*)node_allocate(array, sizeof(array_vector) + ((count > 0) ? count - 1 : 0) * sizeof(cJSON*));
+    if (vector == NULL)
+    {
+        return;
+    }
+
+    vector->count = count;
+    for (child = array->child; (child != NULL) && (position < count); child = child->next)
+    {
+        vector->items[position++] = child;
+    }
+
+#ifdef CJSON_ATOMIC_INDEX
+    /* another thread reading the array may have been faster */
+    if (!atomic_compare_exchange_strong_explicit(&node_of(array)->vector, &expected, vector, memory_order_acq_rel, memory_order_acquire) && owns_memory(array))
+    {
+        global_hooks.deallocate(vector);
+    }
+#else
+    (void)expected;
+    node_of(array)->vector = vector;
+#endif
+}
+
 /* Get Array size/item / object item. */
 CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
 {
     cJSON *child = NULL;
+    array_vector *vector = NULL;
     size_t size = 0;
 
     if (array == NULL)
@@ -1840,12 +4359,31 @@ CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
         return 0;
     }
 
-    child = array->child;
+    if ((array->type & cJSON_IsPacked) && (array->valuestring != NULL))
+    {
+        return (int)packed_of(array)->count;
+    }
 
-    while(child != NULL)
+    /* references share the children of another node, whose changes they would not see */
+    if (!(array->type & cJSON_IsReference) && ((vector = load_vector(array)) != NULL))
     {
-        size++;
-        child = child->next;
+        size = vector->count;
+    }
+    else
+    {
+        child = array->child;
+
+        while(child != NULL)
+        {
+            size++;
+            child = child->next;
+        }
+
+        /* the next size queries and lookups by position in a large array go through a vector */
+        if ((size >= CJSON_VECTOR_THRESHOLD) && !(array->type & cJSON_IsReference))
+        {
+            build_vector(array, size);
+        }
     }
 
     /* FIXME: Can overflow here. Cannot be fixed without breaking the API */
@@ -1856,22 +4394,69 @@ CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
 static cJSON* get_array_item(const cJSON *array, size_t index)
 {
     cJSON *current_child = NULL;
+    array_vector *vector = NULL;
+    size_t visited = 0;
 
     if (array == NULL)
     {
         return NULL;
     }
 
+    if (!(array->type & cJSON_IsReference) && ((vector = load_vector(array)) != NULL))
+    {
+        return (index < vector->count) ? vector->items[index] : NULL;
+    }
+
     current_child = array->child;
     while ((current_child != NULL) && (index > 0))
     {
         index--;
+        visited++;
         current_child = current_child->next;
     }
 
+    /* counting the children builds the vector the next lookups go through */
+    if ((visited >= CJSON_VECTOR_THRESHOLD) && !(array->type & cJSON_IsReference))
+    {
+        cJSON_GetArraySize(array);
+    }
+
     return current_child;
 }
 
+CJSON_PUBLIC(void) cJSON_ArrayIteratorInit(cJSON_ArrayIterator *iterator, const cJSON *array, int start)
+{
+    if (iterator == NULL)
+    {
+        return;
+    }
+
+    iterator->item = NULL;
+    iterator->index = 0;
+    iterator->next = (start < 0) ? NULL : get_array_item(array, (size_t)start);
+    iterator->next_index = (start < 0) ? 0 : (size_t)start;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ArrayIteratorNext(cJSON_ArrayIterator *iterator)
+{
+    if (iterator == NULL)
+    {
+        return NULL;
+    }
+
+    iterator->item = iterator->next;
+    if (iterator->item == NULL)
+    {
+        return NULL;
+    }
+
+    /* read now, so the current element can be detached or deleted before the next call */
+    iterator->next = iterator->item->next;
+    iterator->index = iterator->next_index++;
+
+    return iterator->item;
+}
+
 CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index)
 {
     if (index < 0)
@@ -1882,21 +4467,142 @@ CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index)
     return get_array_item(array, (size_t)index);
 }
 
+/* The hash of a key with its case folded, so the index serves both kinds of lookups (FNV-1a). */
+static unsigned int key_hash(const unsigned char *key)
+{
+    unsigned int hash = 2166136261u;
+
+    for (; *key != '\0'; key++)
+    {
+        hash = (hash ^ (unsigned int)tolower(*key)) * 16777619u;
+    }
+
+    return hash;
+}
+
+/* Builds the index of an object and publishes it. Lookups go on without it if memory is short. */
+static void build_index(const cJSON * const object)
+{
+    object_index *index = NULL;
+    object_index *expected = NULL;
+    cJSON *child = NULL;
+    size_t count = 0;
+    size_t capacity = 1;
+    size_t position = 0;
+
+    for (child = object->child; child != NULL; child = child->next)
+    {
+        count++;
+    }
+
+    /* at most half full, so probe sequences stay short */
+    while (capacity < count * 2)
+    {
+        capacity *= 2;
+    }
+
+    index = (object_index*)node_allocate(object, sizeof(object_index) + (capacity - 1) * sizeof(object_index_entry));
+    if (index == NULL)
+    {
+        return;
+    }
+
+    memset(index->entries, '\0', capacity * sizeof(object_index_entry));
+    index->capacity = capacity;
+    index->unnamed = (size_t)-1;
+
+    for (child = object->child; child != NULL; child = child->next, position++)
+    {
+        unsigned int hash = 0;
+        size_t slot = 0;
+
+        if (child->string == NULL)
+        {
+            if (index->unnamed == (size_t)-1)
+            {
+                index->unnamed = position;
+            }
+            continue;
+        }
+
+        hash = key_hash((const unsigned char*)child->string);
+        for (slot = hash & (capacity - 1); index->entries[slot].item != NULL; slot = (slot + 1) & (capacity - 1))
+        {
+        }
+
+        index->entries[slot].item = child;
+        index->entries[slot].position = position;
+        index->entries[slot].hash = hash;
+    }
+
+#ifdef CJSON_ATOMIC_INDEX
+    /* another thread looking the object up may have been faster */
+    if (!atomic_compare_exchange_strong_explicit(&node_of(object)->index, &expected, index, memory_order_acq_rel, memory_order_acquire) && owns_memory(object))
+    {
+        global_hooks.deallocate(index);
+    }
+#else
+    (void)expected;
+    node_of(object)->index = index;
+#endif
+}
+
+/* Finds the first child (in list order) with the key, like the linear search does. */
+static cJSON *find_in_index(const object_index * const index, const char * const name, const cJSON_bool case_sensitive)
+{
+    const object_index_entry *best = NULL;
+    unsigned int hash = key_hash((const unsigned char*)name);
+    size_t slot = 0;
+
+    for (slot = hash & (index->capacity - 1); index->entries[slot].item != NULL; slot = (slot + 1) & (index->capacity - 1))
+    {
+        const object_index_entry *entry = &index->entries[slot];
+
+        if ((entry->hash != hash) || ((best != NULL) && (entry->position > best->position)))
+        {
+            continue;
+        }
+
+        /* an interned key is the very pointer looked up */
+        if ((name == entry->item->string) || (case_sensitive ? (strcmp(name, entry->item->string) == 0) : (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)entry->item->string) == 0)))
+        {
+            best = entry;
+        }
+    }
+
+    /* the case sensitive search stops at the first child without a key */
+    if ((best == NULL) || (case_sensitive && (best->position > index->unnamed)))
+    {
+        return NULL;
+    }
+
+    return best->item;
+}
+
 static cJSON *get_object_item(const cJSON * const object, const char * const name, const cJSON_bool case_sensitive)
 {
     cJSON *current_element = NULL;
+    object_index *index = NULL;
+    size_t visited = 0;
 
     if ((object == NULL) || (name == NULL))
     {
         return NULL;
     }
 
+    /* references share the children of another node, whose changes they would not see */
+    if (!(object->type & cJSON_IsReference) && ((index = load_index(object)) != NULL))
+    {
+        return find_in_index(index, name, case_sensitive);
+    }
+
     current_element = object->child;
     if (case_sensitive)
     {
-        while ((current_element != NULL) && (current_element->string != NULL) && (strcmp(name, current_element->string) != 0))
+        while ((current_element != NULL) && (current_element->string != NULL) && (name != current_element->string) && (strcmp(name, current_element->string) != 0))
         {
             current_element = current_element->next;
+            visited++;
         }
     }
     else
@@ -1904,9 +4610,16 @@ static cJSON *get_object_item(const cJSON * const object, const char * const nam
         while ((current_element != NULL) && (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)(current_element->string)) != 0))
         {
             current_element = current_element->next;
+            visited++;
         }
     }
 
+    /* the next lookups in a large object go through an index */
+    if ((visited >= CJSON_INDEX_THRESHOLD) && !(object->type & cJSON_IsReference))
+    {
+        build_index(object);
+    }
+
     if ((current_element == NULL) || (current_element->string == NULL)) {
         return NULL;
     }
@@ -1962,11 +4675,14 @@ static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
 {
     cJSON *child = NULL;
 
-    if ((item == NULL) || (array == NULL) || (array == item))
+    /* the numbers of a packed array are not nodes, see cJSON_UnpackArray */
+    if ((item == NULL) || (array == NULL) || (array == item) || (array->type & cJSON_IsPacked))
     {
         return false;
     }
 
+    invalidate_index(array);
+
     child = array->child;
     /*
      * To find the last item in array quickly, we use prev in array
@@ -2030,7 +4746,7 @@ static cJSON_bool add_item_to_object(cJSON * const object, const char * const st
     }
     else
     {
-        new_key = (char*)cJSON_strdup((const unsigned char*)string, hooks);
+        new_key = owns_memory(item) ? (char*)cJSON_strdup((const unsigned char*)string, hooks) : node_strdup(item, string);
         if (new_key == NULL)
         {
             return false;
@@ -2039,7 +4755,7 @@ static cJSON_bool add_item_to_object(cJSON * const object, const char * const st
         new_type = item->type & ~cJSON_StringIsConst;
     }
 
-    if (!(item->type & cJSON_StringIsConst) && (item->string != NULL))
+    if (!(item->type & cJSON_StringIsConst) && (item->string != NULL) && owns_memory(item))
     {
         hooks->deallocate(item->string);
     }
@@ -2196,6 +4912,8 @@ CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const it
         return NULL;
     }
 
+    invalidate_index(parent);
+
     if (item != parent->child)
     {
         /* not the first element */
@@ -2285,6 +5003,8 @@ CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemInArray(cJSON *array, int which, cJSON
         return false;
     }
 
+    invalidate_index(array);
+
     newitem->next = after_inserted;
     newitem->prev = after_inserted->prev;
     after_inserted->prev = newitem;
@@ -2311,6 +5031,8 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON
         return true;
     }
 
+    invalidate_index(parent);
+
     replacement->next = item->next;
     replacement->prev = item->prev;
 
@@ -2366,11 +5088,11 @@ static cJSON_bool replace_item_in_object(cJSON *object, const char *string, cJSO
     }
 
     /* replace the name in the replacement */
-    if (!(replacement->type & cJSON_StringIsConst) && (replacement->string != NULL))
+    if (!(replacement->type & cJSON_StringIsConst) && (replacement->string != NULL) && owns_memory(replacement))
     {
         cJSON_free(replacement->string);
     }
-    replacement->string = (char*)cJSON_strdup((const unsigned char*)string, &global_hooks);
+    replacement->string = node_strdup(replacement, string);
     if (replacement->string == NULL)
     {
         return false;
@@ -2672,6 +5394,131 @@ CJSON_PUBLIC(cJSON *) cJSON_CreateDoubleArray(const double *numbers, int count)
     return a;
 }
 
+CJSON_PUBLIC(cJSON *) cJSON_CreatePackedArray(int element_type, const void *values, size_t count)
+{
+    cJSON *a = NULL;
+    packed_array *packed = NULL;
+
+    if ((values == NULL) && (count > 0))
+    {
+        return NULL;
+    }
+
+    packed = packed_allocate(element_type, count, &global_hooks);
+    if (packed == NULL)
+    {
+        return NULL;
+    }
+
+    a = cJSON_CreateArray();
+    if (a == NULL)
+    {
+        global_hooks.deallocate(packed);
+        return NULL;
+    }
+
+    if (count > 0)
+    {
+        memcpy(packed_elements(packed), values, count * packed_element_size(element_type));
+    }
+
+    a->type |= cJSON_IsPacked;
+    a->valuestring = (char*)packed;
+
+    return a;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_IsPackedArray(const cJSON * const item)
+{
+    if (item == NULL)
+    {
+        return false;
+    }
+
+    return ((item->type & 0xFF) == cJSON_Array) && (item->type & cJSON_IsPacked) && (item->valuestring != NULL);
+}
+
+CJSON_PUBLIC(void *) cJSON_GetPackedArray(const cJSON * const item, int *element_type, size_t *count)
+{
+    const packed_array *packed = NULL;
+
+    if (!cJSON_IsPackedArray(item))
+    {
+        return NULL;
+    }
+
+    packed = packed_of(item);
+    if (element_type != NULL)
+    {
+        *element_type = packed->element_type;
+    }
+    if (count != NULL)
+    {
+        *count = packed->count;
+    }
+
+    return packed_elements(packed);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_UnpackArray(cJSON *array)
+{
+    internal_hooks hooks = global_hooks;
+    packed_array *packed = NULL;
+    cJSON *head = NULL;
+    cJSON *current = NULL;
+    size_t index = 0;
+
+    if (!cJSON_IsPackedArray(array) || (array->type & cJSON_IsReference))
+    {
+        return false;
+    }
+
+    /* the children of a node of a document come from its arena */
+    hooks.document = node_of(array)->document;
+    packed = packed_of(array);
+
+    for (index = 0; index < packed->count; index++)
+    {
+        cJSON *n = cJSON_New_Item(&hooks);
+
+        if (n == NULL)
+        {
+            delete_with_hooks(head, &global_hooks);
+            return false;
+        }
+
+        n->type = cJSON_Number;
+        cJSON_SetNumberValue(n, packed_value(packed, index));
+
+        if (head == NULL)
+        {
+            head = n;
+        }
+        else
+        {
+            current->next = n;
+            n->prev = current;
+        }
+        current = n;
+    }
+
+    if (head != NULL)
+    {
+        head->prev = current;
+    }
+
+    array->type &= ~cJSON_IsPacked;
+    array->child = head;
+    array->valuestring = NULL;
+
+    if (owns_memory(array))
+    {
+        global_hooks.deallocate(packed);
+    }
+
+    return true;
+}
+
 CJSON_PUBLIC(cJSON *) cJSON_CreateStringArray(const char *const *strings, int count)
 {
     size_t i = 0;
@@ -2735,7 +5582,18 @@ CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
     newitem->type = item->type & (~cJSON_IsReference);
     newitem->valueint = item->valueint;
     newitem->valuedouble = item->valuedouble;
-    if (item->valuestring)
+    if (item->valuestring && (item->type & cJSON_IsPacked))
+    {
+        const packed_array *packed = packed_of(item);
+
+        newitem->valuestring = (char*)packed_allocate(packed->element_type, packed->count, &global_hooks);
+        if (!newitem->valuestring)
+        {
+            goto fail;
+        }
+        memcpy(newitem->valuestring, packed, CJSON_PACKED_HEADER + packed->count * packed_element_size(packed->element_type));
+    }
+    else if (item->valuestring)
     {
         newitem->valuestring = (char*)cJSON_strdup((unsigned char*)item->valuestring, &global_hooks);
         if (!newitem->valuestring)
@@ -2993,6 +5851,55 @@ CJSON_PUBLIC(cJSON_bool) cJSON_IsRaw(const cJSON * const item)
     return (item->type & 0xFF) == cJSON_Raw;
 }
 
+/* Compares two arrays element by element as numbers, when at least one of them is packed. */
+static cJSON_bool compare_packed(const cJSON * const a, const cJSON * const b)
+{
+    const cJSON *arrays[2];
+    const cJSON *children[2];
+    size_t index = 0;
+    size_t count = (size_t)cJSON_GetArraySize(a);
+    int side = 0;
+
+    if ((size_t)cJSON_GetArraySize(b) != count)
+    {
+        return false;
+    }
+
+    arrays[0] = a;
+    arrays[1] = b;
+    children[0] = a->child;
+    children[1] = b->child;
+
+    for (index = 0; index < count; index++)
+    {
+        double values[2];
+
+        for (side = 0; side < 2; side++)
+        {
+            if (arrays[side]->type & cJSON_IsPacked)
+            {
+                values[side] = packed_value(packed_of(arrays[side]), index);
+            }
+            else if (cJSON_IsNumber(children[side]))
+            {
+                values[side] = children[side]->valuedouble;
+                children[side] = children[side]->next;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        if (!compare_double(values[0], values[1]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 CJSON_PUBLIC(cJSON_bool) cJSON_Compare(const cJSON * const a, const cJSON * const b, const cJSON_bool case_sensitive)
 {
     if ((a == NULL) || (b == NULL) || ((a->type & 0xFF) != (b->type & 0xFF)))
@@ -3056,6 +5963,11 @@ CJSON_PUBLIC(cJSON_bool) cJSON_Compare(const cJSON * const a, const cJSON * cons
             cJSON *a_element = a->child;
             cJSON *b_element = b->child;
 
+            if ((a->type | b->type) & cJSON_IsPacked)
+            {
+                return compare_packed(a, b);
+            }
+
             for (; (a_element != NULL) && (b_element != NULL);)
             {
                 if (!cJSON_Compare(a_element, b_element, case_sensitive))
@@ -3127,3 +6039,29 @@ CJSON_PUBLIC(void) cJSON_free(void *object)
 {
     global_hooks.deallocate(object);
 }
+
+CJSON_PUBLIC(void) cJSON_Delete_ctx(const cJSON_Context *context, cJSON *item)
+{
+    internal_hooks hooks;
+
+    if (context == NULL)
+    {
+        return;
+    }
+
+    hooks = context_hooks(context);
+    delete_with_hooks(item, &hooks);
+}
+
+CJSON_PUBLIC(void) cJSON_free_ctx(const cJSON_Context *context, void *object)
+{
+    internal_hooks hooks;
+
+    if (context == NULL)
+    {
+        return;
+    }
+
+    hooks = context_hooks(context);
+    hooks.deallocate(object);
+}
@@ -1,8 +1,17 @@
 #include "../../sancho-panza.h"
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
 #define DEFAULT_SDL ".config.json"
 
-#define BUFFER_SIZE 256
+/* The size of the first buffer `map_file` reads files that cannot be mapped into */
+#define READ_BUFFER_SIZE 4096
+
+/* The number of characters after the error location `JSON_parse_mapped` prints */
+#define ERROR_CONTEXT 32
 
 /* ================================================================ */
 /* ============= Here are the arrays that map strings ============= */
@@ -14,62 +23,25 @@ struct mapping_entry {
     Uint32 flag;
 };
 
-/* ================================================================ */
-/* ======================== SDL_Init Flags ======================== */
-/* ================================================================ */
+/**
+ * A perfect hash table of SDL flags, generated by `tools/flag_tables.c` into `flag_tables.h`. Every name has its own slot
+ * in `by_name` and every value its own slot in `by_value`, so a lookup hashes the key once and compares it with one entry.
+ * `composites` lists the flags made of several bits, widest first, and ends with an entry whose name is `NULL`.
+ */
+struct flag_table {
+    const struct mapping_entry* by_name;
+    const struct mapping_entry* by_value;
+    const struct mapping_entry* composites;
 
-static const struct mapping_entry SDL_Init_Flags[] = {
-    {"SDL_INIT_TIMER", SDL_INIT_TIMER},
-    {"SDL_INIT_AUDIO", SDL_INIT_AUDIO},
-    {"SDL_INIT_VIDEO", SDL_INIT_VIDEO},
-    {"SDL_INIT_JOYSTICK", SDL_INIT_JOYSTICK},
-    {"SDL_INIT_HAPTIC", SDL_INIT_HAPTIC},
-    {"SDL_INIT_GAMECONTROLLER", SDL_INIT_GAMECONTROLLER},
-    {"SDL_INIT_EVENTS", SDL_INIT_EVENTS},
-    {"SDL_INIT_EVERYTHING", SDL_INIT_EVERYTHING},
-    {"SDL_INIT_NOPARACHUTE", SDL_INIT_NOPARACHUTE}
-};
+    /* The number of slots minus one; the number of slots is a power of two */
+    Uint32 mask;
 
-/* ================================================================ */
-/* ======================= SDL_Window Flags ======================= */
-/* ================================================================ */
-
-static const struct mapping_entry SDL_CreateWindow_Flags[] = {
-    {"SDL_WINDOW_FULLSCREEN", SDL_WINDOW_FULLSCREEN},
-    {"SDL_WINDOW_OPENGL", SDL_WINDOW_OPENGL},
-    {"SDL_WINDOW_SHOWN", SDL_WINDOW_SHOWN},
-    {"SDL_WINDOW_HIDDEN", SDL_WINDOW_HIDDEN},
-    {"SDL_WINDOW_BORDERLESS", SDL_WINDOW_BORDERLESS},
-    {"SDL_WINDOW_RESIZABLE", SDL_WINDOW_RESIZABLE},
-    {"SDL_WINDOW_MINIMIZED", SDL_WINDOW_MAXIMIZED},
-    {"SDL_WINDOW_MOUSE_GRABBED", SDL_WINDOW_MOUSE_GRABBED},
-    {"SDL_WINDOW_INPUT_FOCUS", SDL_WINDOW_INPUT_FOCUS},
-    {"SDL_WINDOW_MOUSE_FOCUS", SDL_WINDOW_MOUSE_FOCUS},
-    {"SDL_WINDOW_FULLSCREEN_DESKTOP", ( SDL_WINDOW_FULLSCREEN | 0x00001000 )},
-    {"SDL_WINDOW_FOREIGN", SDL_WINDOW_FOREIGN},
-    {"SDL_WINDOW_ALLOW_HIGHDPI", SDL_WINDOW_ALLOW_HIGHDPI},
-    {"SDL_WINDOW_MOUSE_CAPTURE", SDL_WINDOW_MOUSE_CAPTURE},
-    {"SDL_WINDOW_ALWAYS_ON_TOP", SDL_WINDOW_ALWAYS_ON_TOP},
-    {"SDL_WINDOW_SKIP_TASKBAR", SDL_WINDOW_SKIP_TASKBAR},
-    {"SDL_WINDOW_UTILITY", SDL_WINDOW_UTILITY},
-    {"SDL_WINDOW_TOOLTIP", SDL_WINDOW_TOOLTIP},
-    {"SDL_WINDOW_POPUP_MENU", SDL_WINDOW_POPUP_MENU},
-    {"SDL_WINDOW_KEYBOARD_GRABBED", SDL_WINDOW_KEYBOARD_GRABBED},
-    {"SDL_WINDOW_VULKAN", SDL_WINDOW_VULKAN},
-    {"SDL_WINDOW_METAL", SDL_WINDOW_METAL},
-    {"SDL_WINDOW_INPUT_GRABBED", SDL_WINDOW_MOUSE_GRABBED}
+    Uint32 name_seed;
+    Uint32 value_seed;
 };
 
-/* ================================================================ */
-/* ====================== SDL_Renderer Flags ====================== */
-/* ================================================================ */
-
-static const struct mapping_entry SDL_CreateRenderer_flags[] = {
-    {"SDL_RENDERER_SOFTWARE", SDL_RENDERER_SOFTWARE},
-    {"SDL_RENDERER_ACCELERATED", SDL_RENDERER_ACCELERATED},
-    {"SDL_RENDERER_PRESENTVSYNC", SDL_RENDERER_PRESENTVSYNC},
-    {"SDL_RENDERER_TARGETTEXTURE", SDL_RENDERER_TARGETTEXTURE}
-};
+/* `SDL_Init_Flags`, `SDL_CreateWindow_Flags` and `SDL_CreateRenderer_Flags` */
+#include "flag_tables.h"
 
 
 
@@ -151,34 +123,33 @@ struct window_options {
     char* title;
 };
 
+/* ================================================================ */
+
+/* The number of threads the job system runs when the configuration file does not specify it. `0` means one per CPU core */
+#define DEFAULT_WORKERS 0
+
 /* ================================================================ */
 /* ================== Static, internal functions ================== */
 /* ================================================================ */
 
 /**
- * The `SDL_lookup_flag` function searches a mapping table for a specific string flag and returns its corresponding flag value.
- * If the string flag is not recognized, it issues a warning and returns a default success value.
+ * The `SDL_lookup_flag` function finds the value of a flag by its name in a generated flag table.
+ * If the string flag is not recognized, it issues a warning and returns `0`.
  * 
- * @param table A pointer to an array of `mapping_entry` structures that defines the mapping between string flags and their corresponding flag values.
- * @param string_flag A pointer to a null-terminated string representing the flag to be looked up in the mapping table.
- * @param table_size The size of the mapping table (i.e., the number of entries in the table).
+ * @param table A pointer to the flag table to search.
+ * @param string_flag A pointer to a null-terminated string representing the flag to be looked up in the table.
  * 
- * @return Returns the corresponding flag value of type `Uint32` if the `string_flag` is found in the mapping table. Returns `EXIT_SUCCESS` if the `string_flag` is not recognized.
+ * @return Returns the corresponding flag value of type `Uint32` if the `string_flag` is found in the table. Returns `0` if the `string_flag` is not recognized.
  */
-static Uint32 SDL_lookup_flag(const struct mapping_entry* table, const char* string_flag, size_t table_size) {
+static Uint32 SDL_lookup_flag(const struct flag_table* table, const char* string_flag) {
 
-    size_t i;
-    
-    /* ======================================== */
-    /* ====== Traversing the given table ====== */
-    /* ==== in order to find the flag value === */
-    /* ======================================== */
+    const struct mapping_entry* entry = &table->by_name[flag_hash_name(string_flag, table->name_seed) & table->mask];
 
-    for (i = 0; i < table_size; i++) {
+    /* ================ */
 
-        if (strcmp(string_flag, (table + i)->name) == 0) {
-            return (table + i)->flag;
-        }
+    /* The only flag that can have this name is the one in its slot */
+    if ((entry->name != NULL) && (strcmp(string_flag, entry->name) == 0)) {
+        return entry->flag;
     }
 
     /* ======== */
@@ -187,131 +158,263 @@ static Uint32 SDL_lookup_flag(const struct mapping_entry* table, const char* str
 
     /* ======== */
 
-    return EXIT_SUCCESS;
+    return 0;
 }
 
 /* ================================================================ */
 
-static int get_window_options(const cJSON* root, struct window_options* options) {
-    
-    /* Corresponds to the `Window` object in the configuration file */
-    cJSON* object;
-    /* A simple container for extracted data */
-    cJSON* data;
+/**
+ * The `SDL_lookup_flag_name` function finds the name of a flag by its value in a generated flag table.
+ *
+ * @return The name of the flag, or `NULL` if the table has no flag with that value.
+ */
+static const char* SDL_lookup_flag_name(const struct flag_table* table, Uint32 flag) {
 
-    size_t array_size;
-    size_t i;
+    const struct mapping_entry* entry = &table->by_value[flag_hash_value(flag, table->value_seed) & table->mask];
 
-    /* ================================================ */
-    /* ======== Extracting the `Window` object ======== */
-    /* =============== from the `root` ================ */
-    /* ================================================ */
+    /* ======== */
 
-    if (extract_JSON_data(root, "Window", OBJECT, &object) != 0) {
-        /* `extract_JSON_data` prints the error message here if STRICT */
-        
-        /* ======== */
-        return -1;
+    return ((entry->name != NULL) && (entry->flag == flag)) ? entry->name : NULL;
+}
+
+/* ================================================================ */
+
+/**
+ * The `flags_from_array` function combines the flags named by the strings of a JSON array. Elements that are not strings are skipped with a warning.
+ *
+ * @return The combined flags.
+ */
+static Uint32 flags_from_array(const struct flag_table* table, const cJSON* array) {
+
+    Uint32 flags = 0;
+    cJSON_ArrayIterator iterator;
+    const cJSON* array_elm;
+
+    /* ================ */
+
+    cJSON_ArrayIteratorInit(&iterator, array, 0);
+
+    while ((array_elm = cJSON_ArrayIteratorNext(&iterator)) != NULL) {
+
+        if (!cJSON_IsString(array_elm)) {
+            warning(stdout, "flags must be strings; element %zu of the array is ignored\n", iterator.index);
+
+            continue ;
+        }
+
+        /* Map a string to its equivalent flag */
+        flags |= SDL_lookup_flag(table, array_elm->valuestring);
     }
 
-    /* ================================================ */
-    /* ========= Extracting the `title` string ======== */
-    /* ============ from the Window object ============ */
-    /* ================================================ */
+    /* ======== */
 
-    if (extract_JSON_data(object, "title", STRING, &data) != 0) {
-        /* `extract_JSON_data` prints the error message here if STRICT */
-        
-        /* ======== */
-        return -1;
+    return flags;
+}
+
+/* ================================================================ */
+
+/**
+ * The `flags_to_array` function creates a JSON array with the names of the flags that are set. Flags made of several bits
+ * (`SDL_INIT_EVERYTHING`, `SDL_WINDOW_FULLSCREEN_DESKTOP`) are used when all their bits are set, then each remaining bit is named on its own.
+ * Bits the table has no name for are left out.
+ *
+ * @return A new array, or `NULL` on failure.
+ */
+static cJSON* flags_to_array(const struct flag_table* table, Uint32 flags) {
+
+    cJSON* array = NULL;
+    const char* name;
+
+    /* ================ */
+
+    if ((array = cJSON_CreateArray()) == NULL) {
+        goto END;
     }
 
-    /* ================================================ */
-    /* =========== Allocating enough memory =========== */
-    /* ============== to store the title ============== */
-    /* ================================================ */
-    
-    if ((options->title = malloc(strlen(data->valuestring) * sizeof(char))) == NULL) {
-        error(stderr, "Sancho-Panza initialization failure (%s%s%s)\n", RED, strerror(errno), WHITE);
+    for (const struct mapping_entry* composite = table->composites; composite->name != NULL; composite++) {
 
-        /* ======== */
-        return -1;
+        if ((flags & composite->flag) == composite->flag) {
+
+            if (!cJSON_AddItemToArray(array, cJSON_CreateString(composite->name))) {
+                goto END;
+            }
+
+            flags &= ~composite->flag;
+        }
     }
 
-    /* Copying the title */
-    strncpy(options->title, data->valuestring, strlen(data->valuestring));
+    for (Uint32 bit = 1; bit != 0; bit <<= 1) {
 
-    /* ================================================ */
-    /* ==== Extracting the window width and height ==== */
-    /* ============ from the Window object ============ */
-    /* ================================================ */
+        if (((flags & bit) == 0) || ((name = SDL_lookup_flag_name(table, bit)) == NULL)) {
+            continue ;
+        }
 
-    if (extract_JSON_data(object, "width", NUMBER, &data) != 0) {
-        /* `extract_JSON_data` prints the error message here if STRICT */
-        
-        /* ======== */
-        return -1;
+        if (!cJSON_AddItemToArray(array, cJSON_CreateString(name))) {
+            goto END;
+        }
     }
 
-    options->width = data->valueint;
+    /* ======== */
+
+    return array;
+
+    { END:
+        cJSON_Delete(array);
+
+        return NULL;
+    }
+}
+
+/* ================================================================ */
+
+/**
+ * The `deserialize_flags` function extracts an array of flag names from `root` and combines the flags it names.
+ */
+static Uint32 deserialize_flags(const struct flag_table* table, const cJSON* root, const char* label, const char* function) {
+
+    cJSON* array = NULL;
 
     /* ================ */
 
-    if (extract_JSON_data(object, "height", NUMBER, &data) != 0) {
-        /* `extract_JSON_data` prints the error message here if STRICT */
+    if (root == NULL) {
+
+        warning(stdout, "[in %s%s%s] no root element", BLUE, function, WHITE);
+
+        return 0;
+    }
+
+    if (extract_JSON_data(root, label, ARRAY, &array) != 0) {
+        return 0;
+    }
+
+    /* ======== */
 
+    return flags_from_array(table, array);
+}
+
+/* ================================================================ */
+
+static int parse_window_flags(const cJSON* item, void* member) {
+
+    if (!cJSON_IsArray(item)) {
         return -1;
     }
 
-    options->height = data->valueint;
+    *(Uint32*) member = flags_from_array(&SDL_CreateWindow_Flags, item);
 
-    /* ================================================ */
-    /* ========= Extracting the window flags ========== */
-    /* ============ from the Window object ============ */
-    /* ================================================ */
+    /* ======== */
 
-    if (extract_JSON_data(object, "SDL_Window__flags", ARRAY, &data) != 0) {
-        /* `extract_JSON_data` prints the error message here if STRICT */
-        
-        /* ======== */
+    return 0;
+}
+
+/* ================================================================ */
+
+static int parse_renderer_flags(const cJSON* item, void* member) {
+
+    if (!cJSON_IsArray(item)) {
         return -1;
     }
 
-    array_size = cJSON_GetArraySize(data);
+    *(Uint32*) member = flags_from_array(&SDL_CreateRenderer_Flags, item);
 
-    for (i = 0; i < array_size; i++) {
+    /* ======== */
 
-        /* Retrieve the next element from the given array */
-        cJSON* array_elm = cJSON_GetArrayItem(data, i);
+    return 0;
+}
 
-        /* Map a string to its equivalent flag */
-        options->wflags |= SDL_lookup_flag(SDL_CreateWindow_Flags, array_elm->valuestring, sizeof(SDL_CreateWindow_Flags) / sizeof(SDL_CreateWindow_Flags[0]));
+/* ================================================================ */
+/* ======== Here are the schemas of the structures read =========== */
+/* ================== from the configuration file ================= */
+/* ================================================================ */
+
+static const Field window_options_fields[] = {
+    FIELD(struct window_options, title, "title", FIELD_STRING),
+    FIELD(struct window_options, width, "width", FIELD_INT),
+    FIELD(struct window_options, height, "height", FIELD_INT),
+    FIELD_PARSED(struct window_options, wflags, "SDL_Window__flags", 1, parse_window_flags),
+    FIELD_PARSED(struct window_options, rflags, "SDL_Renderer__flags", 1, parse_renderer_flags),
+};
+
+static Schema window_options_schema = SCHEMA(window_options_fields);
+
+/* ================================================================ */
+
+static const Field SDL_Color_fields[] = {
+    FIELD(SDL_Color, r, "r", FIELD_UINT8),
+    FIELD(SDL_Color, g, "g", FIELD_UINT8),
+    FIELD(SDL_Color, b, "b", FIELD_UINT8),
+    FIELD(SDL_Color, a, "a", FIELD_UINT8),
+};
+
+static Schema SDL_Color_schema = SCHEMA(SDL_Color_fields);
+
+/* ================================================================ */
+
+static int get_window_options(const cJSON* root, struct window_options* options) {
+    
+    /* Corresponds to the `Window` object in the configuration file */
+    cJSON* object;
+
+    /* ================================================ */
+    /* ======== Extracting the `Window` object ======== */
+    /* =============== from the `root` ================ */
+    /* ================================================ */
+
+    if (extract_JSON_data(root, "Window", OBJECT, &object) != 0) {
+        /* `extract_JSON_data` prints the error message here */
+        
+        /* ======== */
+        return -1;
     }
 
     /* ================================================ */
-    /* ======== Extracting the renderer flags ========= */
-    /* ============ from the Window object ============ */
+    /* ===== Reading the title, the size and the ====== */
+    /* ===== flags in one pass over the object ======== */
     /* ================================================ */
 
-    /* Extracting the renderer flags */
-    if (extract_JSON_data(object, "SDL_Renderer__flags", ARRAY, &data) != 0) {
+    if (JSON_deserialize(object, &window_options_schema, options, NULL) != 0) {
+        /* `JSON_deserialize` prints every error here */
+        
+        /* ======== */
         return -1;
     }
 
-    array_size = cJSON_GetArraySize(data);
+    /* ======== */
+
+    return EXIT_SUCCESS;
+}
 
-    for (i = 0; i < array_size; i++) {
+/* ================================================================ */
 
-        /* Retrieve the next element from the given array */
-        cJSON* array_elm = cJSON_GetArrayItem(data, i);
+/**
+ * The `get_jobs_workers` function reads the number of worker threads from the optional `Jobs` object of the configuration file.
+ * Older configuration files have no such object, so its absence is not an error.
+ *
+ * @param root A pointer to the root `cJSON` object of the configuration file.
+ *
+ * @return The value of `Jobs.workers`, or `DEFAULT_WORKERS` if it is missing or is not a number.
+ */
+static int get_jobs_workers(const cJSON* root) {
 
-        /* Map a string to its equivalent flag */
-        options->rflags |= SDL_lookup_flag(SDL_CreateRenderer_flags, array_elm->valuestring, sizeof(SDL_CreateRenderer_flags) / sizeof(SDL_CreateRenderer_flags[0]));
+    cJSON* object;
+    cJSON* workers;
+
+    /* ================ */
+
+    if ((object = cJSON_GetObjectItemCaseSensitive(root, "Jobs")) == NULL || !cJSON_IsObject(object)) {
+        return DEFAULT_WORKERS;
+    }
+
+    if ((workers = cJSON_GetObjectItemCaseSensitive(object, "workers")) == NULL || !cJSON_IsNumber(workers)) {
+
+        warning(stdout, "[%s%s%s] is missing or is not a number, using the default value\n", PURPLE, "Jobs.workers", WHITE);
+
+        return DEFAULT_WORKERS;
     }
 
     /* ======== */
 
-    return EXIT_SUCCESS;
+    return workers->valueint;
 }
 
 /* ================================================================ */
@@ -359,8 +462,8 @@ static int create_config_file(void) {
     /* Different values of the window object */
     cJSON* flag;
     cJSON* window;
+    cJSON* jobs;
 
-    char* text = NULL;
 
     errno = 0;
     
@@ -493,25 +596,33 @@ static int create_config_file(void) {
     /* ================================================ */
 
     /**
-     * The JSON object is converted to a string format.
+     * Creates a JSON object for the job system. `0` workers means one worker per CPU core.
      */
-    if ((text = cJSON_Print(root)) == NULL) {
+    if ((jobs = cJSON_CreateObject()) == NULL) {
+        /* Most likely it's a memory allocation error */
         goto END;
     }
-    
+
+    cJSON_AddItemToObject(root, "Jobs", jobs);
+
+    if (cJSON_AddNumberToObject(jobs, "workers", DEFAULT_WORKERS) == NULL) {
+        goto END;
+    }
+
+    /* ================================================ */
+
     /**
-     * The string is written to a file named `.config.json`. If the writing process fails, the function will handle the error appropriately.
+     * The JSON object is printed straight into a file named `.config.json`. If the writing process fails, the function will handle the error appropriately.
      */
-    if (write_to_file(".config.json", text) != 0) {
+    if (JSON_write_to_file(".config.json", root, 1) != 0) {
         goto END;
     }
     
     /* ================================================ */
     
     /**
-     * Allocated memory for JSON objects and strings is freed before returning from the function to prevent memory leaks.
+     * Allocated memory for JSON objects is freed before returning from the function to prevent memory leaks.
      */
-    free(text);
     cJSON_Delete(root);
 
     /* ================ */
@@ -523,11 +634,8 @@ static int create_config_file(void) {
      */
     END:
     {
-        #ifdef STRICT
-            error(stderr, "%s (%s%s%s)\n", "unable to create a default configuration file", RED, errno != 0 ? strerror(errno) : "", WHITE);
-        #endif
+        error(stderr, "%s (%s%s%s)\n", "unable to create a default configuration file", RED, errno != 0 ? strerror(errno) : "", WHITE);
 
-        free(text);
         cJSON_Delete(root);
 
         /* ================ */
@@ -551,6 +659,57 @@ static int create_config_file(void) {
 
 
 
+/* ================================================================ */
+
+/**
+ * The `read_stream` function reads everything from a file descriptor that cannot be mapped (a pipe, a character device) into a growing heap buffer.
+ */
+static int read_stream(int fd, Mapped_File* file) {
+
+    char* buffer = NULL;
+    char* larger;
+
+    size_t capacity = 0;
+    size_t size = 0;
+    ssize_t bytes_read;
+
+    /* ================ */
+
+    do {
+
+        if (size == capacity) {
+
+            capacity = (capacity == 0) ? READ_BUFFER_SIZE : capacity * 2;
+
+            if ((larger = realloc(buffer, capacity)) == NULL) {
+                goto END;
+            }
+
+            buffer = larger;
+        }
+
+        if (((bytes_read = read(fd, buffer + size, capacity - size)) < 0) && (errno != EINTR)) {
+            goto END;
+        }
+
+        size += (bytes_read > 0) ? (size_t) bytes_read : 0;
+    } while (bytes_read != 0);
+
+    file->data = buffer;
+    file->size = size;
+    file->mapped = 0;
+
+    /* ======== */
+
+    return 0;
+
+    { END:
+        free(buffer);
+
+        return -1;
+    }
+}
+
 /* ================================================================ */
 /* ============== Definitions of external functions =============== */
 /* ================================================================ */
@@ -568,9 +727,7 @@ int read_file2buffer(const char* name, char** buffer) {
 
     if ((file = fopen(name, "r")) == NULL) {
 
-        #ifdef STRICT
-            error(stderr, "%s (%s%s%s)\n", strerror(errno), CYAN, name, WHITE);
-        #endif
+        error(stderr, "%s (%s%s%s)\n", strerror(errno), CYAN, name, WHITE);
 
         /* ======== */
         return errno;
@@ -594,9 +751,7 @@ int read_file2buffer(const char* name, char** buffer) {
     
     if ((*buffer = (char*) calloc(number_of_bytes, sizeof(char))) == NULL) {
 
-        #ifdef STRICT
-            error(stderr, "%s\n", strerror(errno));
-        #endif
+        error(stderr, "%s\n", strerror(errno));
 
         fclose(file);
 
@@ -621,49 +776,119 @@ int read_file2buffer(const char* name, char** buffer) {
 
 /* ================================================================ */
 
-void print_message(FILE* stream, Message_Type msg_type, const char* format, ...) {
+int map_file(const char* name, Mapped_File* file, Map_Advice advice) {
 
-    char buffer[BUFFER_SIZE];
-    size_t bytes_written;
+    static const int advices[] = {MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED};
 
-    va_list args;
-    va_start(args, format);
+    struct stat info;
+    void* data;
 
-    const char* prefix;
+    int fd;
+    int status;
 
     /* ================ */
 
-    stream = (!stream) ? ((msg_type == ERROR) ? stderr : stdout) : stream;
+    if ((name == NULL) || (file == NULL)) {
+        return EINVAL;
+    }
 
-    switch (msg_type) {
+    file->data = NULL;
+    file->size = 0;
+    file->mapped = 0;
 
-        case ERROR:
-            prefix = RED "Error" WHITE;
-            break ;
+    /* ================================================ */
+    /* =============== Opening the file =============== */
+    /* ================================================ */
+
+    if (((fd = open(name, O_RDONLY)) < 0) || (fstat(fd, &info) != 0)) {
+        goto END;
+    }
+
+    /* ================================================ */
+    /* ====== Reading what cannot be mapped, and ====== */
+    /* ====== empty files, which `mmap` rejects ======= */
+    /* ================================================ */
 
-        case WARNING:
-            prefix = YELLOW "Warning" WHITE;
-            break ;
+    if (!S_ISREG(info.st_mode) || (info.st_size == 0)) {
 
-        case SUCCESS:
-            prefix = GREEN "Success" WHITE;
-            break ;
+        if (read_stream(fd, file) != 0) {
+            goto END;
+        }
+
+        close(fd);
+
+        return 0;
     }
 
-    if (((bytes_written = snprintf(buffer, sizeof(buffer), "%s: ", prefix)) < 0) || (bytes_written >= sizeof(buffer))) {
-        fprintf(stream, "%s%s%s: error formatting error message\n", RED, "Error", WHITE);
+    /* ================================================ */
+    /* =============== Mapping the file =============== */
+    /* ================================================ */
 
-        return ;
+    if ((data = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0)) == MAP_FAILED) {
+        goto END;
+    }
+
+    /* The hint is only an optimization, so its failure is not an error */
+    if ((advice >= MAP_ADVICE_NORMAL) && (advice <= MAP_ADVICE_WILLNEED)) {
+        madvise(data, (size_t) info.st_size, advices[advice]);
+    }
+
+    /* The mapping stays valid after the file is closed */
+    close(fd);
+
+    file->data = data;
+    file->size = (size_t) info.st_size;
+    file->mapped = 1;
+
+    /* ======== */
+
+    return 0;
+
+    { END:
+        status = errno;
+
+        error(stderr, "%s (%s%s%s)\n", strerror(status), CYAN, name, WHITE);
+
+        if (fd >= 0) {
+            close(fd);
+        }
+
+        return status;
     }
+}
+
+/* ================================================================ */
 
-    if ((bytes_written = vsnprintf(buffer + bytes_written, sizeof(buffer) - bytes_written, format, args) < 0) || (bytes_written >= sizeof(buffer) - bytes_written)) {
-        fprintf(stream, "%s%s%s: error formatting error message\n", RED, "Error", WHITE);
+void unmap_file(Mapped_File* file) {
 
+    if ((file == NULL) || (file->data == NULL)) {
         return ;
     }
 
-    fprintf(stream, "%s", buffer);
-    fflush(stream);
+    if (file->mapped) {
+        munmap((void*) file->data, file->size);
+    }
+    else {
+        free((void*) file->data);
+    }
+
+    file->data = NULL;
+    file->size = 0;
+    file->mapped = 0;
+}
+
+/* ================================================================ */
+
+void print_message(FILE* stream, Message_Type msg_type, const char* format, ...) {
+
+    va_list args;
+
+    /* ================ */
+
+    va_start(args, format);
+
+    /* The logger formats the message, and writes it on its own thread when it is running */
+    Log_vprint(stream, msg_type, format, args);
 
     va_end(args);
 }
@@ -672,16 +897,21 @@ void print_message(FILE* stream, Message_Type msg_type, const char* format, ...)
 
 int JSON_parse(const char* buffer, cJSON** root) {
 
+    cJSON_Context context;
     const char* error_ptr;
     
     /* ================================================ */
     /* ================ Just a wrapper ================ */
     /* ============== around `cJSON_Parse` ============ */
+    /* ===== with a context of its own, so threads ==== */
+    /* ===== parsing at once get their own errors ===== */
     /* ================================================ */
 
-    if ((*root = cJSON_Parse(buffer)) == NULL) {
+    cJSON_InitContext(&context, NULL);
+
+    if ((*root = cJSON_Parse_ctx(&context, buffer)) == NULL) {
 
-        if ((error_ptr = cJSON_GetErrorPtr()) != NULL) {
+        if ((error_ptr = cJSON_GetErrorPtr_ctx(&context)) != NULL) {
             
             error(stderr, "before %s%s%s\n", PURPLE, error_ptr, WHITE);
 
@@ -697,6 +927,73 @@ int JSON_parse(const char* buffer, cJSON** root) {
 
 /* ================================================================ */
 
+int JSON_parse_mapped(const Mapped_File* file, cJSON** root) {
+
+    cJSON_Context context;
+    const char* error_ptr;
+    size_t remaining;
+
+    /* ================ */
+
+    if ((file == NULL) || (root == NULL)) {
+        return -1;
+    }
+
+    /* ================================================ */
+    /* ===== The mapping is not null-terminated, ====== */
+    /* ======= so the length must be passed on ======== */
+    /* ================================================ */
+
+    cJSON_InitContext(&context, NULL);
+
+    if ((*root = cJSON_ParseWithLength_ctx(&context, file->data, file->size)) == NULL) {
+
+        if (((error_ptr = cJSON_GetErrorPtr_ctx(&context)) != NULL) && (error_ptr >= file->data) && (error_ptr <= file->data + file->size)) {
+
+            remaining = file->size - (size_t) (error_ptr - file->data);
+
+            error(stderr, "before %s%.*s%s\n", PURPLE, (int) ((remaining < ERROR_CONTEXT) ? remaining : ERROR_CONTEXT), error_ptr, WHITE);
+        }
+
+        /* ======== */
+        return -1;
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+char* JSON_print_frame(const cJSON* item, int format) {
+
+    /* The buffer the printer grows, and the string it returns, come from the frame arena when there is one */
+    cJSON_Hooks hooks = {Frame_temp_alloc, Frame_temp_free};
+    cJSON_Context context;
+
+    char* string;
+
+    /* ================ */
+
+    if (item == NULL) {
+        return NULL;
+    }
+
+    cJSON_InitContext(&context, &hooks);
+
+    if ((string = format ? cJSON_Print_ctx(&context, item) : cJSON_PrintUnformatted_ctx(&context, item)) == NULL) {
+
+        error(stderr, "in %s%s%s (%s%s%s)\n", BLUE, __func__, WHITE, RED, strerror(errno), WHITE);
+    }
+
+    /* ======== */
+
+    return string;
+}
+
+/* ================================================================ */
+
 int write_to_file(const char* name, const char* string) {
 
     FILE* file;
@@ -705,9 +1002,7 @@ int write_to_file(const char* name, const char* string) {
 
     if (name == NULL) {
 
-        #ifdef STRICT
-            error(stderr, "%s [%s%s%s]\n", "filename is not specified", BLUE, __func__, WHITE);
-        #endif
+        error(stderr, "%s [%s%s%s]\n", "filename is not specified", BLUE, __func__, WHITE);
 
         /* ======== */
         return -1;
@@ -719,9 +1014,7 @@ int write_to_file(const char* name, const char* string) {
 
     if ((file = fopen(name, "w+")) == NULL) {
 
-        #ifdef STRICT
-            error(stderr, "%s [%s%s%s]\n", strerror(errno), BLUE, __func__, WHITE);
-        #endif
+        error(stderr, "%s [%s%s%s]\n", strerror(errno), BLUE, __func__, WHITE);
 
         /* ======== */
         return -1;
@@ -740,6 +1033,56 @@ int write_to_file(const char* name, const char* string) {
 
 /* ================================================================ */
 
+int JSON_write_to_file(const char* name, const cJSON* item, int format) {
+
+    FILE* file;
+    int status = 0;
+
+    /* ================ */
+
+    if ((name == NULL) || (item == NULL)) {
+
+        error(stderr, "%s [%s%s%s]\n", "filename or object is not specified", BLUE, __func__, WHITE);
+
+        /* ======== */
+        return -1;
+    }
+
+    /* ================================================ */
+    /* =============== Opening the file =============== */
+    /* ================================================ */
+
+    if ((file = fopen(name, "w+")) == NULL) {
+
+        error(stderr, "%s [%s%s%s]\n", strerror(errno), BLUE, __func__, WHITE);
+
+        /* ======== */
+        return -1;
+    }
+
+    /* ================================================ */
+    /* ======= Printing through a fixed buffer ======== */
+    /* ================================================ */
+
+    if (!cJSON_PrintToStream(item, file, format)) {
+        status = -1;
+    }
+
+    if (fclose(file) != 0) {
+        status = -1;
+    }
+
+    if (status != 0) {
+        error(stderr, "unable to write (%s%s%s) [%s%s%s]\n", CYAN, name, WHITE, BLUE, __func__, WHITE);
+    }
+
+    /* ======== */
+
+    return status;
+}
+
+/* ================================================================ */
+
 int extract_JSON_data(const cJSON* root, const char* name, JSON_Entity type, cJSON** data) {
 
     cJSON_bool (*check)(const cJSON* const);
@@ -749,9 +1092,7 @@ int extract_JSON_data(const cJSON* root, const char* name, JSON_Entity type, cJS
 
     if ((type < 0) || (type > size)) {
 
-        #ifdef STRICT
-            error(stderr, "unsupported type\n", "");
-        #endif
+        error(stderr, "unsupported type\n", "");
 
         return -1;
     }
@@ -770,9 +1111,7 @@ int extract_JSON_data(const cJSON* root, const char* name, JSON_Entity type, cJS
 
     if ((*data = cJSON_GetObjectItemCaseSensitive(root, name)) == NULL) {
 
-        #ifdef STRICT
-            error(stderr, "there is no such element in the document [%s%s%s]\n", PURPLE, name, WHITE);
-        #endif
+        error(stderr, "there is no such element in the document [%s%s%s]\n", PURPLE, name, WHITE);
 
         return -1;
     }
@@ -783,9 +1122,7 @@ int extract_JSON_data(const cJSON* root, const char* name, JSON_Entity type, cJS
 
     if (check(*data) != 1) {
 
-        #ifdef STRICT
-            error(stderr, "the found element doesn't belong to the specified type [%s%s%s != %s]\n", PURPLE, name, WHITE, extract_checker_name(type));
-        #endif
+        error(stderr, "the found element doesn't belong to the specified type [%s%s%s != %s]\n", PURPLE, name, WHITE, extract_checker_name(type));
 
         *data = NULL;
 
@@ -801,8 +1138,8 @@ int extract_JSON_data(const cJSON* root, const char* name, JSON_Entity type, cJS
 
 int SP_init(App** app) {
 
-    char* buffer;
-    cJSON* root;
+    Mapped_File file = {NULL, 0, 0};
+    cJSON* root = NULL;
 
     Uint32 SDL_flags;
     struct window_options opts = {0, 0, 0, 0, 0};
@@ -812,14 +1149,14 @@ int SP_init(App** app) {
     /* ================ */
 
     /**
-     * The function attempts to read the default configuration file specified by `DEFAULT_SDL` into a buffer using the `read_file2buffer` function.
+     * The function attempts to map the default configuration file specified by `DEFAULT_SDL` into memory using the `map_file` function.
      * If the file is missing (indicated by `ENOENT`), a warning message is printed to `stdout`, and the function attempts to create a default configuration file using `create_config_file`.
      */
-    while ((status = read_file2buffer(DEFAULT_SDL, &buffer)) != 0) {
+    while ((status = map_file(DEFAULT_SDL, &file, MAP_ADVICE_SEQUENTIAL)) != 0) {
 
         if (status == ENOENT) {
 
-            /* The error message from `read_file2buffer` is outputed as well (if STRICT) */
+            /* The error message from `map_file` is outputed as well */
             warning(stdout, "[%s%s%s] missing configuration file. Creating a default one...\n", BLUE, __func__, WHITE);
         }
         
@@ -829,7 +1166,7 @@ int SP_init(App** app) {
          */
         if ((status = create_config_file()) != 0) {
 
-            /* The error message from `read_file2buffer` is outputed (if STRICT) */
+            /* The error message from `read_file2buffer` is outputed */
             return -1;
         }
         else {
@@ -840,11 +1177,11 @@ int SP_init(App** app) {
     /* ================================ */
     
     /**
-     * The function attempts to parse the contents of the buffer as JSON using the `JSON_parse` function.
+     * The function attempts to parse the contents of the file as JSON using the `JSON_parse_mapped` function.
      * If parsing fails, the function jumps to the error handling section.
      */
-    if ((status = JSON_parse(buffer, &root)) != 0) {
-        /* `JSON_parse` prints the error location to the console */
+    if ((status = JSON_parse_mapped(&file, &root)) != 0) {
+        /* `JSON_parse_mapped` prints the error location to the console */
         goto END;
     }
 
@@ -875,6 +1212,38 @@ int SP_init(App** app) {
 
     /* ================================ */
 
+    /**
+     * The function starts the logger thread, which writes the messages of the library from now on.
+     * If this fails, messages are simply written on the calling threads.
+     */
+    Log_init();
+
+    /* ================================ */
+
+    /**
+     * The function starts the job system with the number of worker threads given by the optional `Jobs` object.
+     * If this fails, it jumps to the error handling section.
+     */
+    if (Jobs_init(get_jobs_workers(root)) != 0) {
+        error(stderr, "Initialization failed. Unable to start the job system\n", "");
+
+        goto END;
+    }
+
+    /* ================================ */
+
+    /**
+     * The function starts the background thread that writes asynchronous saves.
+     * If this fails, it jumps to the error handling section.
+     */
+    if (Saver_init() != 0) {
+        error(stderr, "Initialization failed. Unable to start the saver\n", "");
+
+        goto END;
+    }
+
+    /* ================================ */
+
     /**
      * The function creates a new application instance using `Application_new`.
      * If this fails, it jumps to the error handling section.
@@ -903,13 +1272,16 @@ int SP_init(App** app) {
         goto END;
     }
 
+    /* Every tick of the timer starts a new frame of the application's frame arena */
+    (*app)->frame->timer = (*app)->timer;
+
     /* ================================ */
 
     /**
-     * If all initializations are successful, the function frees any allocated memory (e.g., the window title, buffer, and JSON root) before returning 0
+     * If all initializations are successful, the function frees any allocated memory (e.g., the window title, file mapping, and JSON root) before returning 0
      */
     free(opts.title);
-    free(buffer);
+    unmap_file(&file);
     cJSON_Delete(root);
 
     /* ======== */
@@ -921,8 +1293,11 @@ int SP_init(App** app) {
      */
     { END:
         Application_destroy(app);
-        free(buffer);
+        unmap_file(&file);
         cJSON_Delete(root);
+        Saver_quit();
+        Jobs_quit();
+        Log_quit();
         SDL_Quit();
 
         return -1;
@@ -933,6 +1308,11 @@ int SP_init(App** app) {
 
 int SP_quit(void) {
 
+    Saver_quit();
+    Jobs_quit();
+    Binlog_close();
+    Pool_release_unused();
+    Log_quit();
     SDL_Quit();
 
     /* ======== */
@@ -993,7 +1373,7 @@ cJSON* serialize__SDL_Color(const SDL_Color* color) {
 int deserialize__SDL_Color(const cJSON* root, SDL_Color* color, const char* label) {
 
     cJSON* _color = NULL;
-    cJSON* component = NULL;
+    SDL_Color components;
 
     /* ================ */
 
@@ -1009,7 +1389,10 @@ int deserialize__SDL_Color(const cJSON* root, SDL_Color* color, const char* labe
     /* ========= Extracting the color object ========== */
     /* ================================================ */
 
-    if (extract_JSON_data(root, label, OBJECT, &_color) != 0) {
+    if (label == NULL) {
+        _color = (cJSON*) root;
+    }
+    else if (extract_JSON_data(root, label, OBJECT, &_color) != 0) {
         return -1;
     }
 
@@ -1017,117 +1400,59 @@ int deserialize__SDL_Color(const cJSON* root, SDL_Color* color, const char* labe
     /* === Extracting the color components ==== */
     /* ======================================== */
 
-    /* RED */
-    if (extract_JSON_data(_color, "r", NUMBER, &component) != 0) {
-        goto END;
-    }
-    color->r = (Uint8) component->valuedouble;
-
-    /* GREEN */
-    if (extract_JSON_data(_color, "g", NUMBER, &component) != 0) {
-        goto END;
-    }
-    color->g = (Uint8) component->valuedouble;
-
-    /* BLUE */
-    if (extract_JSON_data(_color, "b", NUMBER, &component) != 0) {
-        goto END;
+    /* The color is left as it is unless every component is valid */
+    if (JSON_deserialize(_color, &SDL_Color_schema, &components, NULL) != 0) {
+        return -1;
     }
-    color->b = (Uint8) component->valuedouble;
 
-    /* ALPHA */
-    if (extract_JSON_data(_color, "a", NUMBER, &component) != 0) {
-        goto END;
-    }
-    color->a = (Uint8) component->valuedouble;
+    *color = components;
 
     /* ======== */
 
     return 0;
-
-    { END:
-        cJSON_Delete(_color);
-
-        return -1;
-    }
 }
 
 /* ================================================================ */
 
 cJSON* serialize__SDL_Init__flags(void) {
-
-    cJSON* array = NULL;
-    Uint32 subsystem = SDL_WasInit(SDL_INIT_EVERYTHING);
-
-    /* ================ */
-
-    if ((array = cJSON_CreateArray()) == NULL) {
-        goto END;
-    }
-
-    for (size_t i = 0; i < sizeof(SDL_Init_Flags) / sizeof(SDL_Init_Flags[0]); i++) {
-        if (subsystem & SDL_Init_Flags[i].flag) {
-
-            if (!cJSON_AddItemToArray(array, cJSON_CreateString(SDL_Init_Flags[i].name))) {
-                goto END;
-            }
-        }
-    }
-
-    /* ======== */
-
-    return array;
-
-    { END:
-        cJSON_Delete(array);
-        array = NULL;
-
-        return array;
-    }
+    return flags_to_array(&SDL_Init_Flags, SDL_WasInit(SDL_INIT_EVERYTHING));
 }
 
 /* ================================================================ */
 
-Uint32 deserialize__SDL_Init__flags(const cJSON* root, const char* label) {
-
-    Uint32 flags = 0;
-    const char* default_label = "SDL_Init__flags";
-
-    cJSON* array = NULL;
-    size_t array_size;
-
-    /* ================ */
-
-    if (root == NULL) {
+/* ================================================================ */
 
-        #ifdef STRICT
-            warning(stdout, "[in %s%s%s] no root element", BLUE, __func__, WHITE);
-        #endif
+Uint32 deserialize__SDL_Init__flags(const cJSON* root, const char* label) {
+    return deserialize_flags(&SDL_Init_Flags, root, label ? label : "SDL_Init__flags", __func__);
+}
 
-        return flags; // 0
-    }
+/* ================================================================ */
 
-    if (extract_JSON_data(root, label ? label : default_label, ARRAY, &array) != 0) {
-        return flags;
-    }
+cJSON* serialize__SDL_Window__flags(Uint32 flags) {
+    return flags_to_array(&SDL_CreateWindow_Flags, flags);
+}
 
-    array_size = cJSON_GetArraySize(array);
+/* ================================================================ */
 
-    for (size_t i = 0; i < array_size; i++) {
+Uint32 deserialize__SDL_Window__flags(const cJSON* root, const char* label) {
+    return deserialize_flags(&SDL_CreateWindow_Flags, root, label ? label : "SDL_Window__flags", __func__);
+}
 
-        /* Retrieve the next element from the given array */
-        cJSON* array_elm = cJSON_GetArrayItem(array, i);
+/* ================================================================ */
 
-        /* Map a string to its equivalent flag */
-        flags |= SDL_lookup_flag(SDL_Init_Flags, array_elm->valuestring, sizeof(SDL_Init_Flags) / sizeof(SDL_Init_Flags[0]));
-    }
+cJSON* serialize__SDL_Renderer__flags(Uint32 flags) {
+    return flags_to_array(&SDL_CreateRenderer_Flags, flags);
+}
 
-    /* ======== */
+/* ================================================================ */
 
-    return flags;
+Uint32 deserialize__SDL_Renderer__flags(const cJSON* root, const char* label) {
+    return deserialize_flags(&SDL_CreateRenderer_Flags, root, label ? label : "SDL_Renderer__flags", __func__);
 }
 
 /* ================================================================ */
 
 #undef DEFAULT_SDL
-#undef STRICT
+#undef DEFAULT_WORKERS
+#undef READ_BUFFER_SIZE
+#undef ERROR_CONTEXT
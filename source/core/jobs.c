@@ -0,0 +1,614 @@
+#include "../../sancho-panza.h"
+
+#include <stdatomic.h>
+
+/* ================================================================ */
+
+struct job {
+
+    /* The function to execute and its argument */
+    _Alignas(64) Job_Function function;
+    void* data;
+
+    /* The job that waits for this one */
+    Job* parent;
+
+    /* The job itself plus the number of its unfinished children. The job is finished when it drops to 0 */
+    atomic_int unfinished;
+
+    /* The range a `Jobs_parallel_for` chunk covers */
+    size_t first;
+    size_t last;
+};
+
+/* ================================================================ */
+
+/**
+ * Every worker owns a Chase-Lev deque: the owner pushes and pops jobs at the bottom,
+ * while other workers steal from the top. Only stealing needs a CAS.
+ */
+struct worker {
+
+    _Alignas(64) atomic_llong top;
+    _Alignas(64) atomic_llong bottom;
+
+    _Atomic(Job*) buffer[JOBS_PER_WORKER];
+
+    /* The ring from which the worker allocates its jobs */
+    Job* jobs;
+    size_t allocated;
+
+    /* State of the random generator used to choose a victim to steal from */
+    Uint32 seed;
+
+    SDL_Thread* thread;
+};
+
+/* ================================================================ */
+
+/* The data shared by all chunks of one `Jobs_parallel_for` call */
+struct range_data {
+
+    Jobs_Range_Function function;
+    void* data;
+
+    /* Chunks larger than this are split in halves */
+    size_t grain;
+};
+
+/* ================================================================ */
+
+static struct {
+
+    struct worker* workers;
+    int count;
+
+    atomic_int running;
+
+    /* The number of jobs that have been pushed but not taken yet */
+    atomic_int pending;
+    /* The number of workers sleeping on the `wake` semaphore */
+    atomic_int sleepers;
+
+    SDL_sem* wake;
+} jobs;
+
+/* The index of the worker the current thread is. `-1` for threads that do not belong to the job system */
+static _Thread_local int worker_index = -1;
+
+/* ================================================================ */
+/* ================== Static, internal functions ================== */
+/* ================================================================ */
+
+static int deque_push(struct worker* worker, Job* job) {
+
+    long long bottom = atomic_load_explicit(&worker->bottom, memory_order_relaxed);
+    long long top = atomic_load_explicit(&worker->top, memory_order_acquire);
+
+    /* ================ */
+
+    if (bottom - top >= JOBS_PER_WORKER) {
+        return -1;
+    }
+
+    atomic_store_explicit(&worker->buffer[bottom & (JOBS_PER_WORKER - 1)], job, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&worker->bottom, bottom + 1, memory_order_relaxed);
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+static Job* deque_pop(struct worker* worker) {
+
+    long long bottom = atomic_load_explicit(&worker->bottom, memory_order_relaxed) - 1;
+    long long top;
+
+    Job* job = NULL;
+
+    /* ================ */
+
+    atomic_store_explicit(&worker->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    top = atomic_load_explicit(&worker->top, memory_order_relaxed);
+
+    if (top > bottom) {
+        /* The deque is empty */
+        atomic_store_explicit(&worker->bottom, bottom + 1, memory_order_relaxed);
+
+        return NULL;
+    }
+
+    job = atomic_load_explicit(&worker->buffer[bottom & (JOBS_PER_WORKER - 1)], memory_order_relaxed);
+
+    if (top == bottom) {
+
+        /* The last job in the deque. Race against thieves for it */
+        if (!atomic_compare_exchange_strong_explicit(&worker->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed)) {
+            job = NULL;
+        }
+
+        atomic_store_explicit(&worker->bottom, bottom + 1, memory_order_relaxed);
+    }
+
+    /* ======== */
+
+    return job;
+}
+
+/* ================================================================ */
+
+static Job* deque_steal(struct worker* worker) {
+
+    long long top = atomic_load_explicit(&worker->top, memory_order_acquire);
+    long long bottom;
+
+    Job* job;
+
+    /* ================ */
+
+    atomic_thread_fence(memory_order_seq_cst);
+    bottom = atomic_load_explicit(&worker->bottom, memory_order_acquire);
+
+    if (top >= bottom) {
+        return NULL;
+    }
+
+    job = atomic_load_explicit(&worker->buffer[top & (JOBS_PER_WORKER - 1)], memory_order_relaxed);
+
+    if (!atomic_compare_exchange_strong_explicit(&worker->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed)) {
+        /* Another thread has taken the job */
+        return NULL;
+    }
+
+    /* ======== */
+
+    return job;
+}
+
+/* ================================================================ */
+
+/**
+ * The `get_job` function takes a job from the calling worker's own deque,
+ * or steals one from another worker picked at random if the own deque is empty.
+ */
+static Job* get_job(void) {
+
+    Job* job = NULL;
+
+    Uint32 start = 0;
+    int victim;
+
+    /* ================ */
+
+    if ((worker_index >= 0) && ((job = deque_pop(&jobs.workers[worker_index])) != NULL)) {
+        goto FOUND;
+    }
+
+    if (worker_index >= 0) {
+
+        /* xorshift32 */
+        Uint32* seed = &jobs.workers[worker_index].seed;
+
+        *seed ^= *seed << 13;
+        *seed ^= *seed >> 17;
+        *seed ^= *seed << 5;
+
+        start = *seed;
+    }
+
+    for (int i = 0; i < jobs.count; i++) {
+
+        victim = (int) ((start + i) % jobs.count);
+
+        if (victim == worker_index) {
+            continue ;
+        }
+
+        if ((job = deque_steal(&jobs.workers[victim])) != NULL) {
+            goto FOUND;
+        }
+    }
+
+    /* ======== */
+
+    return NULL;
+
+    { FOUND:
+        atomic_fetch_sub(&jobs.pending, 1);
+
+        return job;
+    }
+}
+
+/* ================================================================ */
+
+static void finish_job(Job* job) {
+
+    Job* parent;
+
+    /* ================ */
+
+    while (job != NULL) {
+
+        /* Once finished, the slot of the job can be taken by `Job_new`, so the parent is read before */
+        parent = job->parent;
+
+        if (atomic_fetch_sub_explicit(&job->unfinished, 1, memory_order_acq_rel) != 1) {
+            break;
+        }
+
+        job = parent;
+    }
+}
+
+/* ================================================================ */
+
+static void execute_job(Job* job) {
+
+    job->function(job, job->data);
+
+    finish_job(job);
+}
+
+/* ================================================================ */
+
+static int worker_main(void* data) {
+
+    worker_index = (int) (intptr_t) data;
+
+    /* ================ */
+
+    for (;;) {
+
+        Job* job;
+
+        if ((job = get_job()) != NULL) {
+            execute_job(job);
+
+            continue ;
+        }
+
+        /* A worker only quits once there is nothing left to take, so no queued job is dropped */
+        if (!atomic_load(&jobs.running)) {
+            break ;
+        }
+
+        /* ================================================ */
+        /* ====== No work anywhere, go to sleep until ===== */
+        /* ============ somebody pushes a new job ========= */
+        /* ================================================ */
+
+        atomic_fetch_add(&jobs.sleepers, 1);
+
+        if ((atomic_load(&jobs.pending) <= 0) && atomic_load(&jobs.running)) {
+            SDL_SemWait(jobs.wake);
+        }
+
+        atomic_fetch_sub(&jobs.sleepers, 1);
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+static void range_job(Job* job, void* data) {
+
+    struct range_data* range = data;
+
+    size_t first = job->first;
+    size_t last = job->last;
+
+    /* ================ */
+
+    /* Keep splitting off the right half until the chunk is small enough; the halves are stolen by idle workers */
+    while (last - first > range->grain) {
+
+        size_t middle = first + (last - first) / 2;
+        Job* right;
+
+        if ((right = Job_new(range_job, data, job)) == NULL) {
+            break ;
+        }
+
+        right->first = middle;
+        right->last = last;
+
+        Job_run(right);
+
+        last = middle;
+    }
+
+    range->function(first, last, range->data);
+}
+
+/* ================================================================ */
+/* ============== Definitions of external functions =============== */
+/* ================================================================ */
+
+int Jobs_init(int workers) {
+
+    if (jobs.workers != NULL) {
+
+        error(stderr, "the job system is already running [%s%s%s]\n", BLUE, __func__, WHITE);
+
+        return -1;
+    }
+
+    if (workers <= 0) {
+        workers = SDL_GetCPUCount();
+    }
+
+    workers = (workers < 1) ? 1 : (workers > JOBS_MAX_WORKERS) ? JOBS_MAX_WORKERS : workers;
+
+    /* ================================================ */
+    /* ============== Allocating workers ============== */
+    /* ================================================ */
+
+    if ((jobs.workers = aligned_alloc(_Alignof(struct worker), workers * sizeof(struct worker))) == NULL) {
+
+        error(stderr, "in %s%s%s (%s%s%s)\n", BLUE, __func__, WHITE, RED, strerror(errno), WHITE);
+
+        return -1;
+    }
+
+    memset(jobs.workers, 0, workers * sizeof(struct worker));
+
+    for (int i = 0; i < workers; i++) {
+
+        if ((jobs.workers[i].jobs = aligned_alloc(_Alignof(Job), JOBS_PER_WORKER * sizeof(Job))) == NULL) {
+            goto END;
+        }
+
+        memset(jobs.workers[i].jobs, 0, JOBS_PER_WORKER * sizeof(Job));
+
+        atomic_init(&jobs.workers[i].top, 0);
+        atomic_init(&jobs.workers[i].bottom, 0);
+
+        jobs.workers[i].seed = 2463534242u + i;
+    }
+
+    if ((jobs.wake = SDL_CreateSemaphore(0)) == NULL) {
+        goto END;
+    }
+
+    jobs.count = workers;
+
+    atomic_store(&jobs.pending, 0);
+    atomic_store(&jobs.sleepers, 0);
+    atomic_store(&jobs.running, 1);
+
+    /* The calling thread is the worker `0` */
+    worker_index = 0;
+
+    /* ================================================ */
+    /* ============ Starting worker threads =========== */
+    /* ================================================ */
+
+    for (int i = 1; i < workers; i++) {
+
+        if ((jobs.workers[i].thread = SDL_CreateThread(worker_main, "SP_worker", (void*) (intptr_t) i)) == NULL) {
+
+            error(stderr, "unable to create a worker thread (%s%s%s)\n", RED, SDL_GetError(), WHITE);
+
+            Jobs_quit();
+
+            return -1;
+        }
+    }
+
+    /* ======== */
+
+    return 0;
+
+    { END:
+        error(stderr, "in %s%s%s (%s%s%s)\n", BLUE, __func__, WHITE, RED, strerror(errno), WHITE);
+
+        for (int i = 0; i < workers; i++) {
+            free(jobs.workers[i].jobs);
+        }
+
+        free(jobs.workers);
+        jobs.workers = NULL;
+
+        return -1;
+    }
+}
+
+/* ================================================================ */
+
+void Jobs_quit(void) {
+
+    Job* job;
+
+    /* ================ */
+
+    if (jobs.workers == NULL) {
+        return ;
+    }
+
+    atomic_store(&jobs.running, 0);
+
+    /* Wake up every sleeping worker so it can notice the job system is shutting down */
+    for (int i = 1; i < jobs.count; i++) {
+        SDL_SemPost(jobs.wake);
+    }
+
+    /* The calling thread finishes the queued jobs along with the workers */
+    while ((job = get_job()) != NULL) {
+        execute_job(job);
+    }
+
+    for (int i = 1; i < jobs.count; i++) {
+        SDL_WaitThread(jobs.workers[i].thread, NULL);
+    }
+
+    for (int i = 0; i < jobs.count; i++) {
+        free(jobs.workers[i].jobs);
+    }
+
+    SDL_DestroySemaphore(jobs.wake);
+    free(jobs.workers);
+
+    jobs.workers = NULL;
+    jobs.wake = NULL;
+    jobs.count = 0;
+
+    worker_index = -1;
+}
+
+/* ================================================================ */
+
+int Jobs_count_workers(void) {
+    return (jobs.workers != NULL) ? jobs.count : 1;
+}
+
+/* ================================================================ */
+
+Job* Job_new(Job_Function function, void* data, Job* parent) {
+
+    struct worker* worker;
+    Job* job;
+
+    /* ================ */
+
+    if ((function == NULL) || (jobs.workers == NULL) || (worker_index < 0)) {
+        return NULL;
+    }
+
+    worker = &jobs.workers[worker_index];
+    job = &worker->jobs[worker->allocated & (JOBS_PER_WORKER - 1)];
+
+    if (atomic_load_explicit(&job->unfinished, memory_order_acquire) != 0) {
+
+        error(stderr, "too many unfinished jobs (more than %d) [%s%s%s]\n", JOBS_PER_WORKER, BLUE, __func__, WHITE);
+
+        return NULL;
+    }
+
+    worker->allocated++;
+
+    job->function = function;
+    job->data = data;
+    job->parent = parent;
+    job->first = 0;
+    job->last = 0;
+
+    atomic_store_explicit(&job->unfinished, 1, memory_order_relaxed);
+
+    if (parent != NULL) {
+        atomic_fetch_add_explicit(&parent->unfinished, 1, memory_order_relaxed);
+    }
+
+    /* ======== */
+
+    return job;
+}
+
+/* ================================================================ */
+
+int Job_run(Job* job) {
+
+    if (job == NULL) {
+        return -1;
+    }
+
+    if ((jobs.workers == NULL) || (worker_index < 0)) {
+        execute_job(job);
+
+        return 0;
+    }
+
+    /* Announce the job before pushing it, so a worker about to sleep cannot miss it */
+    atomic_fetch_add(&jobs.pending, 1);
+
+    if (deque_push(&jobs.workers[worker_index], job) != 0) {
+        atomic_fetch_sub(&jobs.pending, 1);
+
+        /* The deque is full */
+        execute_job(job);
+
+        return 0;
+    }
+
+    if (atomic_load(&jobs.sleepers) > 0) {
+        SDL_SemPost(jobs.wake);
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+int Job_is_finished(const Job* job) {
+    return (job != NULL) ? atomic_load_explicit(&((Job*) job)->unfinished, memory_order_acquire) == 0 : 1;
+}
+
+/* ================================================================ */
+
+void Job_wait(const Job* job) {
+
+    while (!Job_is_finished(job)) {
+
+        Job* next;
+
+        if ((jobs.workers != NULL) && ((next = get_job()) != NULL)) {
+            execute_job(next);
+        }
+        else {
+            SDL_Delay(0);
+        }
+    }
+}
+
+/* ================================================================ */
+
+int Jobs_parallel_for(size_t count, size_t min_chunk, Jobs_Range_Function function, void* data) {
+
+    struct range_data range;
+    Job* root;
+
+    /* ================ */
+
+    if (function == NULL) {
+        return -1;
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+
+    range.function = function;
+    range.data = data;
+
+    /* Aim for a few chunks per worker, so faster workers can steal from slower ones */
+    range.grain = count / ((size_t) Jobs_count_workers() * 4);
+    range.grain = (range.grain < min_chunk) ? min_chunk : range.grain;
+    range.grain = (range.grain == 0) ? 1 : range.grain;
+
+    if ((count <= range.grain) || ((root = Job_new(range_job, &range, NULL)) == NULL)) {
+        function(0, count, data);
+
+        return 0;
+    }
+
+    root->first = 0;
+    root->last = count;
+
+    Job_run(root);
+    Job_wait(root);
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
@@ -0,0 +1,454 @@
+#include "../../sancho-panza.h"
+
+#include <stdatomic.h>
+
+/* How long the logger thread sleeps when there is nothing to write, in milliseconds */
+#define IDLE_TIMEOUT 100
+
+/* The number of different streams a batch can write to before they are flushed */
+#define BATCH_STREAMS 4
+
+/* ================================================================ */
+
+/**
+ * A slot of the ring. `sequence` tells producers and the consumer whose turn it is (see `push_record` and `drain`).
+ */
+struct log_record {
+
+    atomic_size_t sequence;
+
+    FILE* stream;
+    Message_Type type;
+
+    /* The message, in `text` if it is shorter than `LOG_INLINE_SIZE`, in `long_text` otherwise */
+    size_t length;
+    char* long_text;
+    char text[LOG_INLINE_SIZE];
+};
+
+/* ================================================================ */
+
+static struct logger {
+
+    struct log_record* ring;
+
+    /* The next slot producers claim, and the next slot the thread reads */
+    _Alignas(64) atomic_size_t tail;
+    _Alignas(64) size_t head;
+
+    /* The number of records written and flushed so far */
+    atomic_size_t written;
+
+    /* Set by the thread before it goes to sleep, cleared by the producer that wakes it up */
+    atomic_int sleeping;
+    atomic_int running;
+
+    SDL_sem* wake;
+    SDL_Thread* thread;
+} logger;
+
+/* Messages written on the calling thread must not interleave */
+static SDL_SpinLock direct_lock = 0;
+
+/* ================================================================ */
+/* ================== Static, internal functions ================== */
+/* ================================================================ */
+
+static const char* message_prefix(Message_Type msg_type) {
+
+    switch (msg_type) {
+
+        case ERROR:
+            return RED "Error" WHITE;
+
+        case WARNING:
+            return YELLOW "Warning" WHITE;
+
+        case SUCCESS:
+            return GREEN "Success" WHITE;
+    }
+
+    /* ======== */
+
+    return "";
+}
+
+/* ================================================================ */
+
+static FILE* message_stream(FILE* stream, Message_Type msg_type) {
+    return (stream != NULL) ? stream : ((msg_type == ERROR) ? stderr : stdout);
+}
+
+/* ================================================================ */
+
+static void write_record(const struct log_record* record) {
+
+    fprintf(record->stream, "%s: ", message_prefix(record->type));
+    fwrite((record->long_text != NULL) ? record->long_text : record->text, 1, record->length, record->stream);
+}
+
+/* ================================================================ */
+
+/**
+ * The `format_record` function formats a message into a record, on the heap if it does not fit into the record.
+ */
+static int format_record(struct log_record* record, const char* format, va_list args) {
+
+    va_list copy;
+    int length;
+
+    /* ================ */
+
+    va_copy(copy, args);
+
+    record->long_text = NULL;
+
+    if ((length = vsnprintf(record->text, sizeof(record->text), format, args)) < 0) {
+        va_end(copy);
+
+        return -1;
+    }
+
+    if ((size_t) length >= sizeof(record->text)) {
+
+        if ((record->long_text = malloc((size_t) length + 1)) == NULL) {
+            va_end(copy);
+
+            return -1;
+        }
+
+        vsnprintf(record->long_text, (size_t) length + 1, format, copy);
+    }
+
+    va_end(copy);
+
+    record->length = (size_t) length;
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+/**
+ * The `push_record` function claims a slot of the ring for a producer (a bounded MPSC queue: a slot is free for the producer
+ * that claimed position `p` when its sequence equals `p`, and ready for the consumer when it equals `p + 1`).
+ *
+ * @return The slot, or `NULL` if the ring is full.
+ */
+static struct log_record* push_record(size_t* position) {
+
+    struct log_record* record;
+
+    size_t tail = atomic_load_explicit(&logger.tail, memory_order_relaxed);
+    size_t sequence;
+
+    /* ================ */
+
+    for (;;) {
+
+        record = &logger.ring[tail & (LOG_RING_SIZE - 1)];
+        sequence = atomic_load_explicit(&record->sequence, memory_order_acquire);
+
+        if (sequence == tail) {
+
+            if (atomic_compare_exchange_weak_explicit(&logger.tail, &tail, tail + 1, memory_order_relaxed, memory_order_relaxed)) {
+                break ;
+            }
+        }
+        else if ((intptr_t) (sequence - tail) < 0) {
+            return NULL;
+        }
+        else {
+            tail = atomic_load_explicit(&logger.tail, memory_order_relaxed);
+        }
+    }
+
+    *position = tail;
+
+    /* ======== */
+
+    return record;
+}
+
+/* ================================================================ */
+
+/**
+ * The `wake_logger` function wakes the thread up if it sleeps. Unless the message is urgent, the thread is left asleep
+ * until the ring is half full or its idle timeout expires, so messages are written in batches.
+ */
+static void wake_logger(int urgent) {
+
+    if (!urgent && (atomic_load(&logger.tail) - atomic_load(&logger.written) < LOG_RING_SIZE / 2)) {
+        return ;
+    }
+
+    /* Pairs with the store to `sleeping` in `logger_main` */
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if (atomic_load(&logger.sleeping) && atomic_exchange(&logger.sleeping, 0)) {
+        SDL_SemPost(logger.wake);
+    }
+}
+
+/* ================================================================ */
+
+/**
+ * The `drain` function writes every ready record, then flushes the streams it wrote to.
+ *
+ * @return The number of records written.
+ */
+static size_t drain(void) {
+
+    FILE* streams[BATCH_STREAMS];
+    int count = 0;
+
+    struct log_record* record;
+    size_t written = 0;
+
+    /* ================ */
+
+    for (;;) {
+
+        record = &logger.ring[logger.head & (LOG_RING_SIZE - 1)];
+
+        if (atomic_load_explicit(&record->sequence, memory_order_acquire) != logger.head + 1) {
+            break ;
+        }
+
+        write_record(record);
+
+        /* Remember the stream so it is flushed once, at the end of the batch */
+        for (int i = 0; i <= count; i++) {
+
+            if (i == count) {
+
+                if (count == BATCH_STREAMS) {
+                    fflush(streams[--count]);
+                }
+
+                streams[count++] = record->stream;
+
+                break ;
+            }
+
+            if (streams[i] == record->stream) {
+                break ;
+            }
+        }
+
+        free(record->long_text);
+        record->long_text = NULL;
+
+        /* Hand the slot back to the producers, one lap later */
+        atomic_store_explicit(&record->sequence, logger.head + LOG_RING_SIZE, memory_order_release);
+
+        logger.head++;
+        written++;
+    }
+
+    for (int i = 0; i < count; i++) {
+        fflush(streams[i]);
+    }
+
+    atomic_fetch_add(&logger.written, written);
+
+    /* ======== */
+
+    return written;
+}
+
+/* ================================================================ */
+
+static int logger_main(void* data) {
+
+    (void) data;
+
+    while (atomic_load(&logger.running)) {
+
+        if (drain() != 0) {
+            continue ;
+        }
+
+        /* Announce the sleep, then check once more, so a record pushed in between is not left waiting */
+        atomic_store(&logger.sleeping, 1);
+
+        if (drain() != 0) {
+            atomic_store(&logger.sleeping, 0);
+
+            continue ;
+        }
+
+        SDL_SemWaitTimeout(logger.wake, IDLE_TIMEOUT);
+
+        atomic_store(&logger.sleeping, 0);
+    }
+
+    /* Producers may still be filling claimed slots; wait for them */
+    while (logger.head != atomic_load(&logger.tail)) {
+
+        if (drain() == 0) {
+            SDL_Delay(0);
+        }
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+/* ============== Definitions of external functions =============== */
+/* ================================================================ */
+
+int Log_init(void) {
+
+    if (logger.ring != NULL) {
+        return -1;
+    }
+
+    if ((logger.ring = calloc(LOG_RING_SIZE, sizeof(struct log_record))) == NULL) {
+        goto END;
+    }
+
+    for (size_t i = 0; i < LOG_RING_SIZE; i++) {
+        atomic_init(&logger.ring[i].sequence, i);
+    }
+
+    atomic_init(&logger.tail, 0);
+    atomic_init(&logger.written, 0);
+    atomic_init(&logger.sleeping, 0);
+    atomic_init(&logger.running, 1);
+
+    logger.head = 0;
+
+    if ((logger.wake = SDL_CreateSemaphore(0)) == NULL) {
+        goto END;
+    }
+
+    if ((logger.thread = SDL_CreateThread(logger_main, "SP_logger", NULL)) == NULL) {
+        goto END;
+    }
+
+    /* ======== */
+
+    return 0;
+
+    { END:
+        /* The logger is not running, so the message is written directly */
+        #if LOG_LEVEL <= LOG_LEVEL_ERROR
+            fprintf(stderr, "%s: unable to start the logger\n", message_prefix(ERROR));
+        #endif
+
+        if (logger.wake != NULL) {
+            SDL_DestroySemaphore(logger.wake);
+        }
+
+        free(logger.ring);
+
+        logger.ring = NULL;
+        logger.wake = NULL;
+
+        return -1;
+    }
+}
+
+/* ================================================================ */
+
+void Log_quit(void) {
+
+    if (logger.ring == NULL) {
+        return ;
+    }
+
+    atomic_store(&logger.running, 0);
+
+    SDL_SemPost(logger.wake);
+    SDL_WaitThread(logger.thread, NULL);
+
+    SDL_DestroySemaphore(logger.wake);
+    free(logger.ring);
+
+    logger.ring = NULL;
+    logger.wake = NULL;
+    logger.thread = NULL;
+}
+
+/* ================================================================ */
+
+void Log_flush(void) {
+
+    size_t target;
+
+    /* ================ */
+
+    if (logger.ring == NULL) {
+        return ;
+    }
+
+    target = atomic_load(&logger.tail);
+
+    while (atomic_load(&logger.written) < target) {
+        wake_logger(1);
+        SDL_Delay(1);
+    }
+}
+
+/* ================================================================ */
+
+void Log_vprint(FILE* stream, Message_Type msg_type, const char* format, va_list args) {
+
+    struct log_record* record;
+    size_t position;
+
+    /* ================ */
+
+    stream = message_stream(stream, msg_type);
+
+    /* ================================================ */
+    /* ======== Without the logger thread, the ======== */
+    /* ======== message is written right away ========= */
+    /* ================================================ */
+
+    if (logger.ring == NULL) {
+
+        SDL_AtomicLock(&direct_lock);
+
+        fprintf(stream, "%s: ", message_prefix(msg_type));
+        vfprintf(stream, format, args);
+        fflush(stream);
+
+        SDL_AtomicUnlock(&direct_lock);
+
+        return ;
+    }
+
+    /* ================================================ */
+    /* ========== Claiming a slot of the ring ========= */
+    /* ================================================ */
+
+    while ((record = push_record(&position)) == NULL) {
+
+        /* The ring is full: let the thread catch up */
+        wake_logger(1);
+        SDL_Delay(0);
+    }
+
+    record->stream = stream;
+    record->type = msg_type;
+
+    if (format_record(record, format, args) != 0) {
+        record->length = 0;
+    }
+
+    atomic_store_explicit(&record->sequence, position + 1, memory_order_release);
+
+    /* Errors are written as soon as possible */
+    wake_logger(msg_type == ERROR);
+}
+
+/* ================================================================ */
+
+#undef IDLE_TIMEOUT
+#undef BATCH_STREAMS
@@ -0,0 +1,1127 @@
+#include "../../sancho-panza.h"
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/* The size of the first buffer of the pointers `JSON_Patch_diff` builds */
+#define POINTER_SIZE 256
+
+/* The size of the first line of a journal, which identifies its base file */
+#define HEADER_SIZE 128
+
+/* ================================================================ */
+
+/**
+ * A JSON Pointer built one key at a time while the values are walked, and cut back after each of them.
+ */
+struct pointer {
+
+    char* data;
+    size_t length;
+    size_t capacity;
+};
+
+/* ================================================================ */
+/* ================== Static, internal functions ================== */
+/* ================================================================ */
+
+static int pointer_reserve(struct pointer* pointer, size_t size) {
+
+    char* larger;
+    size_t capacity = (pointer->capacity != 0) ? pointer->capacity : POINTER_SIZE;
+
+    /* ================ */
+
+    while (capacity < pointer->length + size + 1) {
+        capacity *= 2;
+    }
+
+    if (capacity == pointer->capacity) {
+        return 0;
+    }
+
+    if ((larger = realloc(pointer->data, capacity)) == NULL) {
+        return -1;
+    }
+
+    pointer->data = larger;
+    pointer->capacity = capacity;
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+/**
+ * The `pointer_push` function appends a key to a pointer, escaping `~` as `~0` and `/` as `~1`.
+ */
+static int pointer_push(struct pointer* pointer, const char* key) {
+
+    const char* c;
+
+    /* ================ */
+
+    /* Every character takes two at most, with the `/` */
+    if (pointer_reserve(pointer, 2 * strlen(key) + 1) != 0) {
+        return -1;
+    }
+
+    pointer->data[pointer->length++] = '/';
+
+    for (c = key; *c != '\0'; c++) {
+
+        if (*c == '~') {
+            pointer->data[pointer->length++] = '~';
+            pointer->data[pointer->length++] = '0';
+        }
+        else if (*c == '/') {
+            pointer->data[pointer->length++] = '~';
+            pointer->data[pointer->length++] = '1';
+        }
+        else {
+            pointer->data[pointer->length++] = *c;
+        }
+    }
+
+    pointer->data[pointer->length] = '\0';
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+static int pointer_push_index(struct pointer* pointer, size_t index) {
+
+    char digits[32];
+
+    /* ================ */
+
+    snprintf(digits, sizeof(digits), "%zu", index);
+
+    /* ======== */
+
+    return pointer_push(pointer, digits);
+}
+
+/* ================================================================ */
+
+static void pointer_pop(struct pointer* pointer, size_t length) {
+
+    pointer->length = length;
+    pointer->data[length] = '\0';
+}
+
+/* ================================================================ */
+
+/**
+ * The `push_operation` function appends an operation to a patch. The value, if any, is copied.
+ */
+static int push_operation(cJSON* patch, const char* op, const char* path, const cJSON* value) {
+
+    cJSON* operation;
+    cJSON* copy;
+
+    /* ================ */
+
+    if ((operation = cJSON_CreateObject()) == NULL) {
+        return -1;
+    }
+
+    /* The patch is not packed, so adding cannot fail */
+    cJSON_AddItemToArray(patch, operation);
+
+    if ((cJSON_AddStringToObject(operation, "op", op) == NULL) || (cJSON_AddStringToObject(operation, "path", path) == NULL)) {
+        return -1;
+    }
+
+    if (value == NULL) {
+        return 0;
+    }
+
+    if ((copy = cJSON_Duplicate(value, 1)) == NULL) {
+        return -1;
+    }
+
+    if (!cJSON_AddItemToObject(operation, "value", copy)) {
+        cJSON_Delete(copy);
+
+        return -1;
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+static double packed_number(const void* values, int type, size_t index) {
+
+    switch (type) {
+
+        case cJSON_PackedDouble:
+            return ((const double*) values)[index];
+
+        case cJSON_PackedInt32:
+            return ((const int32_t*) values)[index];
+
+        case cJSON_PackedUint8:
+            return ((const uint8_t*) values)[index];
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+static int diff(cJSON* patch, struct pointer* path, const cJSON* from, const cJSON* to);
+
+/* ================================================================ */
+
+/**
+ * The `diff_objects` function compares the members of two objects by key: members missing from `to` are removed,
+ * members missing from `from` are added, and the others are compared.
+ */
+static int diff_objects(cJSON* patch, struct pointer* path, const cJSON* from, const cJSON* to) {
+
+    size_t length = path->length;
+    const cJSON* member;
+    const cJSON* counterpart;
+    int status;
+
+    /* ================ */
+
+    cJSON_ArrayForEach(member, from) {
+
+        if (member->string == NULL) {
+            continue ;
+        }
+
+        if (pointer_push(path, member->string) != 0) {
+            return -1;
+        }
+
+        if ((counterpart = cJSON_GetObjectItemCaseSensitive(to, member->string)) == NULL) {
+            status = push_operation(patch, "remove", path->data, NULL);
+        }
+        else {
+            status = diff(patch, path, member, counterpart);
+        }
+
+        pointer_pop(path, length);
+
+        if (status != 0) {
+            return -1;
+        }
+    }
+
+    /* ================================================ */
+    /* =========== The members `to` adds ============== */
+    /* ================================================ */
+
+    cJSON_ArrayForEach(member, to) {
+
+        if ((member->string == NULL) || (cJSON_GetObjectItemCaseSensitive(from, member->string) != NULL)) {
+            continue ;
+        }
+
+        if (pointer_push(path, member->string) != 0) {
+            return -1;
+        }
+
+        status = push_operation(patch, "add", path->data, member);
+
+        pointer_pop(path, length);
+
+        if (status != 0) {
+            return -1;
+        }
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+/**
+ * The `diff_arrays` function skips the elements two arrays begin and end with, compares the elements in between pairwise,
+ * and adds or removes the rest. An element inserted or removed in the middle then costs one operation, not one per element after it.
+ */
+static int diff_arrays(cJSON* patch, struct pointer* path, const cJSON* from, const cJSON* to) {
+
+    size_t length = path->length;
+    size_t from_size = (size_t) cJSON_GetArraySize(from);
+    size_t to_size = (size_t) cJSON_GetArraySize(to);
+    size_t prefix = 0;
+    size_t suffix = 0;
+    size_t i;
+
+    const cJSON* a = from->child;
+    const cJSON* b = to->child;
+    const cJSON* a_last;
+    const cJSON* b_last;
+
+    int status = 0;
+
+    /* ================ */
+
+    while ((a != NULL) && (b != NULL) && cJSON_Compare(a, b, 1)) {
+        a = a->next;
+        b = b->next;
+        prefix++;
+    }
+
+    /* The `prev` of the first element is the last one */
+    a_last = (from->child != NULL) ? from->child->prev : NULL;
+    b_last = (to->child != NULL) ? to->child->prev : NULL;
+
+    while ((suffix < from_size - prefix) && (suffix < to_size - prefix) && cJSON_Compare(a_last, b_last, 1)) {
+        a_last = a_last->prev;
+        b_last = b_last->prev;
+        suffix++;
+    }
+
+    from_size -= prefix + suffix;
+    to_size -= prefix + suffix;
+
+    /* ================================================ */
+    /* ======== The elements both arrays have ========= */
+    /* ================================================ */
+
+    for (i = 0; (i < from_size) && (i < to_size) && (status == 0); i++, a = a->next, b = b->next) {
+
+        if (pointer_push_index(path, prefix + i) != 0) {
+            return -1;
+        }
+
+        status = diff(patch, path, a, b);
+
+        pointer_pop(path, length);
+    }
+
+    /* ================================================ */
+    /* ========== The elements added or removed ======= */
+    /* ================================================ */
+
+    for (; (i < to_size) && (status == 0); i++, b = b->next) {
+
+        if (pointer_push_index(path, prefix + i) != 0) {
+            return -1;
+        }
+
+        status = push_operation(patch, "add", path->data, b);
+
+        pointer_pop(path, length);
+    }
+
+    /* Every removal shifts the next element into the same index */
+    for (; (i < from_size) && (status == 0); i++) {
+
+        if (pointer_push_index(path, prefix + to_size) != 0) {
+            return -1;
+        }
+
+        status = push_operation(patch, "remove", path->data, NULL);
+
+        pointer_pop(path, length);
+    }
+
+    /* ======== */
+
+    return status;
+}
+
+/* ================================================================ */
+
+/**
+ * The `diff_packed` function compares two packed arrays of the same element type and size element by element,
+ * so a change of a few numbers of a large array (a grid, for instance) replaces those numbers only.
+ */
+static int diff_packed(cJSON* patch, struct pointer* path, const cJSON* from, const cJSON* to, int type, size_t count) {
+
+    size_t length = path->length;
+    const void* a = cJSON_GetPackedArray(from, NULL, NULL);
+    const void* b = cJSON_GetPackedArray(to, NULL, NULL);
+    cJSON* number;
+    size_t i;
+    int status;
+
+    /* ================ */
+
+    for (i = 0; i < count; i++) {
+
+        double value = packed_number(b, type, i);
+
+        if (!(packed_number(a, type, i) != value)) {
+            continue ;
+        }
+
+        if ((pointer_push_index(path, i) != 0) || ((number = cJSON_CreateNumber(value)) == NULL)) {
+            return -1;
+        }
+
+        status = push_operation(patch, "replace", path->data, number);
+
+        cJSON_Delete(number);
+        pointer_pop(path, length);
+
+        if (status != 0) {
+            return -1;
+        }
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+static int diff(cJSON* patch, struct pointer* path, const cJSON* from, const cJSON* to) {
+
+    int from_type;
+    int to_type;
+    size_t from_count;
+    size_t to_count;
+
+    /* ================ */
+
+    if (cJSON_IsObject(from) && cJSON_IsObject(to)) {
+        return diff_objects(patch, path, from, to);
+    }
+
+    if (cJSON_IsPackedArray(from) && cJSON_IsPackedArray(to)) {
+
+        cJSON_GetPackedArray(from, &from_type, &from_count);
+        cJSON_GetPackedArray(to, &to_type, &to_count);
+
+        if ((from_type == to_type) && (from_count == to_count)) {
+            return diff_packed(patch, path, from, to, from_type, from_count);
+        }
+    }
+    else if (cJSON_IsArray(from) && cJSON_IsArray(to) && !cJSON_IsPackedArray(from) && !cJSON_IsPackedArray(to)) {
+        return diff_arrays(patch, path, from, to);
+    }
+
+    /* ======== */
+
+    return cJSON_Compare(from, to, 1) ? 0 : push_operation(patch, "replace", path->data, to);
+}
+
+/* ================================================================ */
+
+/**
+ * The `unpack` function turns a packed array into an ordinary one before elements are added to it or removed from it.
+ */
+static int unpack(cJSON* array) {
+
+    return (!cJSON_IsPackedArray(array) || cJSON_UnpackArray(array)) ? 0 : -1;
+}
+
+/* ================================================================ */
+
+/**
+ * The `store_packed` function stores a number into a packed array in place, if the element type of the array can hold it exactly.
+ */
+static int store_packed(cJSON* array, int index, const cJSON* value) {
+
+    void* values;
+    int type;
+    size_t count;
+    double number;
+
+    /* ================ */
+
+    if (((values = cJSON_GetPackedArray(array, &type, &count)) == NULL) || !cJSON_IsNumber(value) || ((size_t) index >= count)) {
+        return -1;
+    }
+
+    number = value->valuedouble;
+
+    switch (type) {
+
+        case cJSON_PackedDouble:
+            ((double*) values)[index] = number;
+            return 0;
+
+        case cJSON_PackedInt32:
+            if ((number >= INT32_MIN) && (number <= INT32_MAX) && (number == (double) (int32_t) number)) {
+                ((int32_t*) values)[index] = (int32_t) number;
+                return 0;
+            }
+            break;
+
+        case cJSON_PackedUint8:
+            if ((number >= 0) && (number <= UINT8_MAX) && (number == (double) (uint8_t) number)) {
+                ((uint8_t*) values)[index] = (uint8_t) number;
+                return 0;
+            }
+            break;
+    }
+
+    /* ======== */
+
+    return -1;
+}
+
+/* ================================================================ */
+
+/**
+ * The `add_value` function carries out an `add`: it sets a member of an object (replacing it if it exists),
+ * or inserts an element into an array. The path `""` replaces the whole document. It takes ownership of `value`, even on failure.
+ */
+static int add_value(cJSON** root, JSON_Path* path, cJSON* value) {
+
+    cJSON* parent;
+    const char* key;
+    int index;
+    int size;
+    cJSON_bool added = 0;
+
+    /* ================ */
+
+    if (JSON_Path_get_pointer(path)[0] == '\0') {
+
+        cJSON_Delete(*root);
+        *root = value;
+
+        return 0;
+    }
+
+    if ((parent = JSON_Path_find_parent(path, *root, &key, &index)) == NULL) {
+        goto END;
+    }
+
+    if (cJSON_IsObject(parent)) {
+
+        if (cJSON_GetObjectItemCaseSensitive(parent, key) != NULL) {
+            added = cJSON_ReplaceItemInObjectCaseSensitive(parent, key, value);
+        }
+        else {
+            added = cJSON_AddItemToObject(parent, key, value);
+        }
+    }
+    else if (unpack(parent) == 0) {
+
+        size = cJSON_GetArraySize(parent);
+
+        if ((index == JSON_PATH_END) || (index == size)) {
+            added = cJSON_AddItemToArray(parent, value);
+        }
+        else if ((index >= 0) && (index < size)) {
+            added = cJSON_InsertItemInArray(parent, index, value);
+        }
+    }
+
+    if (!added) {
+        goto END;
+    }
+
+    /* ======== */
+
+    return 0;
+
+    { END:
+        cJSON_Delete(value);
+
+        return -1;
+    }
+}
+
+/* ================================================================ */
+
+/**
+ * The `replace_value` function carries out a `replace`: the value at the path must exist. It takes ownership of `value`, even on failure.
+ */
+static int replace_value(cJSON** root, JSON_Path* path, cJSON* value) {
+
+    cJSON* parent;
+    cJSON* existing = NULL;
+    const char* key;
+    int index;
+
+    /* ================ */
+
+    if (JSON_Path_get_pointer(path)[0] == '\0') {
+
+        cJSON_Delete(*root);
+        *root = value;
+
+        return 0;
+    }
+
+    if ((parent = JSON_Path_find_parent(path, *root, &key, &index)) == NULL) {
+        goto END;
+    }
+
+    /* Replacing through the key gives the new member the key */
+    if (cJSON_IsObject(parent)) {
+
+        if ((cJSON_GetObjectItemCaseSensitive(parent, key) == NULL) || !cJSON_ReplaceItemInObjectCaseSensitive(parent, key, value)) {
+            goto END;
+        }
+
+        return 0;
+    }
+
+    if (index >= 0) {
+
+        /* A number stays in its packed array */
+        if (cJSON_IsPackedArray(parent) && (store_packed(parent, index, value) == 0)) {
+            cJSON_Delete(value);
+
+            return 0;
+        }
+
+        if (unpack(parent) == 0) {
+            existing = cJSON_GetArrayItem(parent, index);
+        }
+    }
+
+    if ((existing == NULL) || !cJSON_ReplaceItemViaPointer(parent, existing, value)) {
+        goto END;
+    }
+
+    /* ======== */
+
+    return 0;
+
+    { END:
+        cJSON_Delete(value);
+
+        return -1;
+    }
+}
+
+/* ================================================================ */
+
+/**
+ * The `detach_value` function takes the value at a path out of the document, for a `remove` or a `move`.
+ *
+ * @return The value, or `NULL` if there is none (the whole document cannot be detached).
+ */
+static cJSON* detach_value(cJSON* root, JSON_Path* path) {
+
+    cJSON* parent;
+    const char* key;
+    int index;
+
+    /* ================ */
+
+    if ((parent = JSON_Path_find_parent(path, root, &key, &index)) == NULL) {
+        return NULL;
+    }
+
+    if (cJSON_IsObject(parent)) {
+        return cJSON_DetachItemFromObjectCaseSensitive(parent, key);
+    }
+
+    if ((index < 0) || (unpack(parent) != 0)) {
+        return NULL;
+    }
+
+    /* ======== */
+
+    return cJSON_DetachItemFromArray(parent, index);
+}
+
+/* ================================================================ */
+
+static int apply_operation(cJSON** root, const cJSON* operation) {
+
+    const cJSON* op = cJSON_GetObjectItemCaseSensitive(operation, "op");
+    const cJSON* pointer = cJSON_GetObjectItemCaseSensitive(operation, "path");
+    const cJSON* value = cJSON_GetObjectItemCaseSensitive(operation, "value");
+    const cJSON* from = cJSON_GetObjectItemCaseSensitive(operation, "from");
+
+    JSON_Path* path = NULL;
+    JSON_Path* source = NULL;
+    cJSON* item;
+    size_t length;
+    int status = -1;
+
+    /* ================ */
+
+    if (!cJSON_IsString(op) || !cJSON_IsString(pointer) || (JSON_Path_compile(pointer->valuestring, &path) != 0)) {
+        return -1;
+    }
+
+    /* ================================================ */
+    /* ======= The operations with a `value` ========== */
+    /* ================================================ */
+
+    if ((strcmp(op->valuestring, "add") == 0) || (strcmp(op->valuestring, "replace") == 0)) {
+
+        if ((value == NULL) || ((item = cJSON_Duplicate(value, 1)) == NULL)) {
+            goto END;
+        }
+
+        status = (op->valuestring[0] == 'a') ? add_value(root, path, item) : replace_value(root, path, item);
+    }
+    else if (strcmp(op->valuestring, "test") == 0) {
+        status = ((value != NULL) && cJSON_Compare(JSON_Path_find(path, *root), value, 1)) ? 0 : -1;
+    }
+    else if (strcmp(op->valuestring, "remove") == 0) {
+
+        if ((item = detach_value(*root, path)) != NULL) {
+            cJSON_Delete(item);
+            status = 0;
+        }
+    }
+
+    /* ================================================ */
+    /* ======= The operations with a `from` =========== */
+    /* ================================================ */
+
+    else if ((strcmp(op->valuestring, "move") == 0) || (strcmp(op->valuestring, "copy") == 0)) {
+
+        if (!cJSON_IsString(from) || (JSON_Path_compile(from->valuestring, &source) != 0)) {
+            goto END;
+        }
+
+        if (op->valuestring[0] == 'c') {
+
+            if ((item = cJSON_Duplicate(JSON_Path_find(source, *root), 1)) != NULL) {
+                status = add_value(root, path, item);
+            }
+        }
+        else if (strcmp(from->valuestring, pointer->valuestring) == 0) {
+            status = (JSON_Path_find(source, *root) != NULL) ? 0 : -1;
+        }
+        else {
+
+            length = strlen(from->valuestring);
+
+            /* A value cannot be moved into itself */
+            if ((strncmp(from->valuestring, pointer->valuestring, length) == 0) && (pointer->valuestring[length] == '/')) {
+                goto END;
+            }
+
+            if ((item = detach_value(*root, source)) != NULL) {
+                status = add_value(root, path, item);
+            }
+        }
+    }
+
+    /* ======== */
+
+    { END:
+        JSON_Path_destroy(&path);
+        JSON_Path_destroy(&source);
+
+        return status;
+    }
+}
+
+/* ================================================================ */
+
+static int write_all(int fd, const char* data, size_t size) {
+
+    ssize_t written;
+
+    /* ================ */
+
+    while (size > 0) {
+
+        if ((written = write(fd, data, size)) < 0) {
+
+            if (errno == EINTR) {
+                continue ;
+            }
+
+            return -1;
+        }
+
+        data += written;
+        size -= (size_t) written;
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+/**
+ * The `describe_base` function writes the first line of a journal: the device, the inode, the size and the modification time of its base file.
+ * The saver renames a new file over the base, so every version of the base gets another line.
+ */
+static int describe_base(const char* base, char* header) {
+
+    struct stat info;
+
+    /* ================ */
+
+    if (stat(base, &info) != 0) {
+
+        error(stderr, "%s (%s%s%s)\n", strerror(errno), CYAN, base, WHITE);
+
+        return -1;
+    }
+
+    snprintf(header, HEADER_SIZE, "{\"base\":\"%llu:%llu:%lld:%lld\"}\n",
+             (unsigned long long) info.st_dev, (unsigned long long) info.st_ino, (long long) info.st_size, (long long) info.st_mtime);
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+/* ================ Definitions of external functions ============= */
+/* ================================================================ */
+
+cJSON* JSON_Patch_diff(const cJSON* from, const cJSON* to) {
+
+    struct pointer path = {NULL, 0, 0};
+    cJSON* patch;
+
+    /* ================ */
+
+    if ((from == NULL) || (to == NULL)) {
+        return NULL;
+    }
+
+    if (((patch = cJSON_CreateArray()) == NULL) || (pointer_reserve(&path, 0) != 0)) {
+        goto END;
+    }
+
+    /* The whole document is `""` */
+    path.data[0] = '\0';
+
+    if (diff(patch, &path, from, to) != 0) {
+        goto END;
+    }
+
+    free(path.data);
+
+    /* ======== */
+
+    return patch;
+
+    { END:
+        cJSON_Delete(patch);
+        free(path.data);
+
+        return NULL;
+    }
+}
+
+/* ================================================================ */
+
+int JSON_Patch_apply(cJSON** root, const cJSON* patch) {
+
+    cJSON_ArrayIterator iterator;
+    const cJSON* operation;
+
+    /* ================ */
+
+    if ((root == NULL) || (*root == NULL) || !cJSON_IsArray(patch)) {
+        return -1;
+    }
+
+    cJSON_ArrayIteratorInit(&iterator, patch, 0);
+
+    while ((operation = cJSON_ArrayIteratorNext(&iterator)) != NULL) {
+
+        if (apply_operation(root, operation) != 0) {
+
+            error(stderr, "the operation %zu of the patch cannot be applied\n", iterator.index);
+
+            return -1;
+        }
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+int JSON_Journal_append(const char* base, const char* journal, const cJSON* patch) {
+
+    char header[HEADER_SIZE];
+    char current[HEADER_SIZE];
+    size_t header_length;
+    struct stat info;
+
+    char* printed = NULL;
+    char* line = NULL;
+    size_t length;
+
+    int fd;
+    int status = -1;
+
+    /* ================ */
+
+    if ((base == NULL) || (journal == NULL) || !cJSON_IsArray(patch)) {
+        return -1;
+    }
+
+    if (cJSON_GetArraySize(patch) == 0) {
+        return 0;
+    }
+
+    if (describe_base(base, header) != 0) {
+        return -1;
+    }
+
+    header_length = strlen(header);
+
+    if ((fd = open(journal, O_RDWR | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH)) < 0) {
+
+        error(stderr, "%s (%s%s%s)\n", strerror(errno), CYAN, journal, WHITE);
+
+        return -1;
+    }
+
+    if (fstat(fd, &info) != 0) {
+        goto END;
+    }
+
+    /* ================================================ */
+    /* ===== A new journal, or one that extends ======= */
+    /* ===== another version of the base, starts ====== */
+    /* ===== again with the line of this version ====== */
+    /* ================================================ */
+
+    if (((size_t) info.st_size < header_length) || (pread(fd, current, header_length, 0) != (ssize_t) header_length) || (memcmp(current, header, header_length) != 0)) {
+
+        if ((ftruncate(fd, 0) != 0) || (write_all(fd, header, header_length) != 0)) {
+            goto END;
+        }
+    }
+
+    /* A patch cut short by a crash is ended, so the next one is not glued to it */
+    else if ((pread(fd, current, 1, info.st_size - 1) != 1) || (current[0] != '\n')) {
+
+        if (write_all(fd, "\n", 1) != 0) {
+            goto END;
+        }
+    }
+
+    /* ================================================ */
+    /* ========= Appending the patch as a line ======== */
+    /* ================================================ */
+
+    if ((printed = cJSON_PrintUnformatted(patch)) == NULL) {
+        goto END;
+    }
+
+    length = strlen(printed);
+
+    if ((line = malloc(length + 1)) == NULL) {
+        goto END;
+    }
+
+    memcpy(line, printed, length);
+    line[length] = '\n';
+
+    status = write_all(fd, line, length + 1);
+
+    /* ======== */
+
+    { END:
+        if (status != 0) {
+
+            error(stderr, "unable to append to the journal (%s%s%s)\n", CYAN, journal, WHITE);
+        }
+
+        cJSON_free(printed);
+        free(line);
+
+        if (close(fd) != 0) {
+            status = -1;
+        }
+
+        return status;
+    }
+}
+
+/* ================================================================ */
+
+int JSON_Journal_load(const char* base, const char* journal, cJSON** root) {
+
+    Mapped_File file = {NULL, 0, 0};
+    char header[HEADER_SIZE];
+    size_t header_length;
+    struct stat info;
+
+    const char* newline;
+    size_t position;
+    cJSON* patch;
+    int status;
+
+    /* ================ */
+
+    if ((base == NULL) || (journal == NULL) || (root == NULL)) {
+        return -1;
+    }
+
+    *root = NULL;
+
+    if (map_file(base, &file, MAP_ADVICE_SEQUENTIAL) != 0) {
+        /* `map_file` prints the error message here */
+
+        return -1;
+    }
+
+    status = JSON_parse_mapped(&file, root);
+
+    unmap_file(&file);
+
+    if ((status != 0) || (describe_base(base, header) != 0)) {
+        goto END;
+    }
+
+    header_length = strlen(header);
+
+    /* ================================================ */
+    /* ============== Opening the journal ============= */
+    /* ================================================ */
+
+    /* No journal, no changes since the base was saved */
+    if ((stat(journal, &info) != 0) && (errno == ENOENT)) {
+        return 0;
+    }
+
+    if (map_file(journal, &file, MAP_ADVICE_SEQUENTIAL) != 0) {
+        goto END;
+    }
+
+    if ((file.size < header_length) || (memcmp(file.data, header, header_length) != 0)) {
+
+        warning(stdout, "the journal extends another version of the base file, it is ignored (%s%s%s)\n", CYAN, journal, WHITE);
+
+        unmap_file(&file);
+
+        return 0;
+    }
+
+    /* ================================================ */
+    /* ======= Applying the patches in order ========== */
+    /* ================================================ */
+
+    for (position = header_length; position < file.size; position = (size_t) (newline - file.data) + 1) {
+
+        if ((newline = memchr(file.data + position, '\n', file.size - position)) == NULL) {
+
+            warning(stdout, "the last patch of the journal is incomplete, it is skipped (%s%s%s)\n", CYAN, journal, WHITE);
+
+            break ;
+        }
+
+        if (newline == file.data + position) {
+            continue ;
+        }
+
+        if ((patch = cJSON_ParseWithLength(file.data + position, (size_t) (newline - file.data) - position)) == NULL) {
+
+            warning(stdout, "a patch of the journal was cut short, it is skipped (byte %zu of %s%s%s)\n", position, CYAN, journal, WHITE);
+
+            continue ;
+        }
+
+        status = JSON_Patch_apply(root, patch);
+
+        cJSON_Delete(patch);
+
+        if (status != 0) {
+
+            unmap_file(&file);
+
+            goto END;
+        }
+    }
+
+    unmap_file(&file);
+
+    /* ======== */
+
+    return 0;
+
+    { END:
+        cJSON_Delete(*root);
+        *root = NULL;
+
+        return -1;
+    }
+}
+
+/* ================================================================ */
+
+int JSON_Journal_compact(const char* base, const char* journal, const cJSON* root, int format) {
+
+    Save_Handle* handle = NULL;
+    Save_Status status;
+    char header[HEADER_SIZE];
+    cJSON* copy;
+    char* data;
+    size_t length;
+
+    /* ================ */
+
+    if ((base == NULL) || (journal == NULL) || (root == NULL)) {
+        return -1;
+    }
+
+    /* ================================================ */
+    /* ============ Replacing the base file =========== */
+    /* ================================================ */
+
+    if ((copy = cJSON_Duplicate(root, 1)) == NULL) {
+        return -1;
+    }
+
+    /* The saver deletes the copy */
+    if (Save_JSON_async(base, copy, format, &handle) != 0) {
+        return -1;
+    }
+
+    status = Save_wait(handle);
+    Save_release(&handle);
+
+    if ((status != SAVE_DONE) || (describe_base(base, header) != 0)) {
+        return -1;
+    }
+
+    /* ================================================ */
+    /* ====== Starting the journal of the new base ==== */
+    /* ================================================ */
+
+    length = strlen(header);
+
+    if ((data = malloc(length)) == NULL) {
+        return -1;
+    }
+
+    memcpy(data, header, length);
+
+    /* The saver frees the buffer */
+    if (Save_buffer_async(journal, data, length, &handle) != 0) {
+        return -1;
+    }
+
+    status = Save_wait(handle);
+    Save_release(&handle);
+
+    /* ======== */
+
+    return (status == SAVE_DONE) ? 0 : -1;
+}
+
+/* ================================================================ */
+
+#undef POINTER_SIZE
+#undef HEADER_SIZE
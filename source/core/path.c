@@ -0,0 +1,310 @@
+#include "../../sancho-panza.h"
+
+/**
+ * A step of a path: the unescaped key, and the same key read as an index.
+ */
+struct path_step {
+
+    const char* key;
+    int index;
+};
+
+/* ================================================================ */
+
+struct json_path {
+
+    /* The pointer the path was compiled from */
+    const char* pointer;
+
+    struct path_step* steps;
+    size_t count;
+};
+
+/* ================================================================ */
+/* ================== Static, internal functions ================== */
+/* ================================================================ */
+
+/**
+ * The `read_index` function reads a key as an index: a number without leading zeros, at most `INT_MAX`.
+ *
+ * @return The index, `JSON_PATH_END` for `-`, or `JSON_PATH_NO_INDEX` for anything else.
+ */
+static int read_index(const char* key) {
+
+    long index = 0;
+    const char* c;
+
+    /* ================ */
+
+    if (strcmp(key, "-") == 0) {
+        return JSON_PATH_END;
+    }
+
+    if ((key[0] == '\0') || ((key[0] == '0') && (key[1] != '\0'))) {
+        return JSON_PATH_NO_INDEX;
+    }
+
+    for (c = key; *c != '\0'; c++) {
+
+        if ((*c < '0') || (*c > '9') || ((index = index * 10 + (*c - '0')) > INT_MAX)) {
+            return JSON_PATH_NO_INDEX;
+        }
+    }
+
+    /* ======== */
+
+    return (int) index;
+}
+
+/* ================================================================ */
+
+/**
+ * The `follow` function takes the first `count` steps of a path from a value.
+ *
+ * @return The value reached, or `NULL` if a step finds nothing.
+ */
+static cJSON* follow(const JSON_Path* path, const cJSON* item, size_t count) {
+
+    size_t i;
+
+    /* ================ */
+
+    for (i = 0; (i < count) && (item != NULL); i++) {
+
+        const struct path_step* step = &path->steps[i];
+
+        /* Large objects are searched through their key index */
+        if (cJSON_IsObject(item)) {
+            item = cJSON_GetObjectItemCaseSensitive(item, step->key);
+        }
+        else if (cJSON_IsArray(item) && (step->index >= 0)) {
+            item = cJSON_GetArrayItem(item, step->index);
+        }
+        else {
+            item = NULL;
+        }
+    }
+
+    /* ======== */
+
+    return (cJSON*) item;
+}
+
+/* ================================================================ */
+
+static int is_entity(const cJSON* item, JSON_Entity type) {
+
+    switch (type) {
+
+        case ARRAY:
+            return cJSON_IsArray(item);
+
+        case BOOLEAN:
+            return cJSON_IsBool(item);
+
+        case OBJECT:
+            return cJSON_IsObject(item);
+
+        case NUMBER:
+            return cJSON_IsNumber(item);
+
+        case STRING:
+            return cJSON_IsString(item);
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+/* ================ Definitions of external functions ============= */
+/* ================================================================ */
+
+int JSON_Path_compile(const char* pointer, JSON_Path** path) {
+
+    size_t length;
+    size_t count = 0;
+    size_t i;
+    char* copy;
+    char* key;
+    const char* c;
+
+    /* ================ */
+
+    if ((pointer == NULL) || (path == NULL)) {
+        return -1;
+    }
+
+    if ((pointer[0] != '\0') && (pointer[0] != '/')) {
+
+        error(stderr, "a JSON pointer starts with '/' [%s%s%s]\n", PURPLE, pointer, WHITE);
+
+        return -1;
+    }
+
+    length = strlen(pointer);
+
+    for (c = pointer; *c != '\0'; c++) {
+        count += (*c == '/');
+    }
+
+    /* ================================================ */
+    /* ===== One block holds the path, its steps, ===== */
+    /* ========= the pointer and the keys ============= */
+    /* ================================================ */
+
+    if ((*path = malloc(sizeof(JSON_Path) + count * sizeof(struct path_step) + 2 * (length + 1))) == NULL) {
+        return -1;
+    }
+
+    (*path)->steps = (struct path_step*) (*path + 1);
+    (*path)->count = count;
+
+    copy = (char*) ((*path)->steps + count);
+    memcpy(copy, pointer, length + 1);
+    (*path)->pointer = copy;
+
+    key = copy + length + 1;
+
+    /* ================================================ */
+    /* ======= Unescaping the keys one by one ========= */
+    /* ================================================ */
+
+    for (i = 0, c = pointer; i < count; i++) {
+
+        struct path_step* step = &(*path)->steps[i];
+
+        step->key = key;
+
+        /* Skipping the `/` */
+        for (c++; (*c != '\0') && (*c != '/'); c++) {
+
+            if (*c != '~') {
+                *key++ = *c;
+            }
+            else if ((c[1] == '0') || (c[1] == '1')) {
+                *key++ = (c[1] == '0') ? '~' : '/';
+                c++;
+            }
+            else {
+
+                error(stderr, "'~' is followed by '0' or '1' in a JSON pointer [%s%s%s]\n", PURPLE, pointer, WHITE);
+
+                goto END;
+            }
+        }
+
+        *key++ = '\0';
+
+        step->index = read_index(step->key);
+    }
+
+    /* ======== */
+
+    return 0;
+
+    { END:
+        JSON_Path_destroy(path);
+
+        return -1;
+    }
+}
+
+/* ================================================================ */
+
+void JSON_Path_destroy(JSON_Path** path) {
+
+    if ((path == NULL) || (*path == NULL)) {
+        return ;
+    }
+
+    free(*path);
+
+    *path = NULL;
+}
+
+/* ================================================================ */
+
+cJSON* JSON_Path_find(const JSON_Path* path, const cJSON* root) {
+
+    if ((path == NULL) || (root == NULL)) {
+        return NULL;
+    }
+
+    /* ======== */
+
+    return follow(path, root, path->count);
+}
+
+/* ================================================================ */
+
+cJSON* JSON_Path_find_parent(const JSON_Path* path, const cJSON* root, const char** key, int* index) {
+
+    cJSON* parent;
+
+    /* ================ */
+
+    if ((path == NULL) || (root == NULL) || (key == NULL) || (index == NULL) || (path->count == 0)) {
+        return NULL;
+    }
+
+    parent = follow(path, root, path->count - 1);
+
+    if (!cJSON_IsObject(parent) && !cJSON_IsArray(parent)) {
+        return NULL;
+    }
+
+    *key = path->steps[path->count - 1].key;
+    *index = path->steps[path->count - 1].index;
+
+    /* ======== */
+
+    return parent;
+}
+
+/* ================================================================ */
+
+int JSON_Path_extract(const JSON_Path* path, const cJSON* root, JSON_Entity type, cJSON** data) {
+
+    if ((path == NULL) || (data == NULL)) {
+        return -1;
+    }
+
+    /* ================================================ */
+    /* ============ Extracting the element ============ */
+    /* ================================================ */
+
+    if ((*data = JSON_Path_find(path, root)) == NULL) {
+
+        error(stderr, "there is no such element in the document [%s%s%s]\n", PURPLE, path->pointer, WHITE);
+
+        return -1;
+    }
+
+    /* ================================================ */
+    /* ============== Data type mismatch ============== */
+    /* ================================================ */
+
+    if (!is_entity(*data, type)) {
+
+        error(stderr, "the found element doesn't belong to the specified type [%s%s%s]\n", PURPLE, path->pointer, WHITE);
+
+        *data = NULL;
+
+        return -1;
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+const char* JSON_Path_get_pointer(const JSON_Path* path) {
+
+    return (path != NULL) ? path->pointer : NULL;
+}
+
+/* ================================================================ */
@@ -0,0 +1,319 @@
+#include "../../sancho-panza.h"
+
+/* ================================================================ */
+
+struct pool_page {
+
+    Pool_Page* next;
+
+    /* The slots follow the header, at the alignment of the objects */
+    unsigned char* slots;
+};
+
+/* ================================================================ */
+
+/* Pools that own pages, so their statistics can be printed and their memory released */
+static Pool* pools = NULL;
+static SDL_SpinLock pools_lock = 0;
+
+/* ================================================================ */
+/* ================== Static, internal functions ================== */
+/* ================================================================ */
+
+static size_t slot_alignment(const Pool* pool) {
+    return (pool->alignment < sizeof(void*)) ? sizeof(void*) : pool->alignment;
+}
+
+/* ================================================================ */
+
+/**
+ * Every slot must be able to hold the pointer to the next free slot, and slots must keep the alignment of the objects.
+ */
+static size_t slot_size(const Pool* pool) {
+
+    size_t alignment = slot_alignment(pool);
+    size_t size = (pool->size < sizeof(void*)) ? sizeof(void*) : pool->size;
+
+    /* ======== */
+
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+/* ================================================================ */
+
+/**
+ * The `add_page` function allocates a page and puts all of its slots on the free list. The pool must be locked.
+ * It returns `1` for the first page of the pool, which must then be registered with `register_pool` once the pool is unlocked.
+ */
+static int add_page(Pool* pool) {
+
+    size_t alignment = slot_alignment(pool);
+    size_t size = slot_size(pool);
+    size_t header = (sizeof(struct pool_page) + alignment - 1) & ~(alignment - 1);
+    size_t bytes = (header + size * POOL_PAGE_SLOTS + alignment - 1) & ~(alignment - 1);
+
+    Pool_Page* page;
+
+    /* ================ */
+
+    if ((page = aligned_alloc(alignment, bytes)) == NULL) {
+
+        error(stderr, "in %s%s%s (%s%s%s)\n", BLUE, __func__, WHITE, RED, strerror(errno), WHITE);
+
+        return -1;
+    }
+
+    page->slots = (unsigned char*) page + header;
+
+    /* Chaining the slots in address order */
+    for (size_t i = 0; i < POOL_PAGE_SLOTS; i++) {
+
+        void* slot = page->slots + i * size;
+
+        #ifdef POOL_DEBUG
+            memset(slot, POOL_POISON, size);
+        #endif
+
+        *(void**) slot = (i + 1 < POOL_PAGE_SLOTS) ? page->slots + (i + 1) * size : pool->free_list;
+    }
+
+    pool->free_list = page->slots;
+
+    page->next = pool->pages;
+    pool->pages = page;
+
+    pool->stats.pages++;
+
+    /* ======== */
+
+    return (page->next == NULL) ? 1 : 0;
+}
+
+/* ================================================================ */
+
+/**
+ * The `register_pool` function adds a pool to the list used by `Pool_print_stats` and `Pool_release_unused`.
+ * The pool must not be locked: those functions lock the list first and the pools second.
+ */
+static void register_pool(Pool* pool) {
+
+    SDL_AtomicLock(&pools_lock);
+
+    pool->next = pools;
+    pools = pool;
+
+    SDL_AtomicUnlock(&pools_lock);
+}
+
+/* ================================================================ */
+
+#ifdef POOL_DEBUG
+
+/**
+ * The `check_slot` function verifies that an object being freed belongs to the pool and is not free already. The pool must be locked.
+ */
+static int check_slot(const Pool* pool, const void* object) {
+
+    size_t size = slot_size(pool);
+
+    const Pool_Page* page;
+    const unsigned char* bytes = object;
+
+    /* ================ */
+
+    for (page = pool->pages; page != NULL; page = page->next) {
+
+        if ((bytes >= page->slots) && (bytes < page->slots + size * POOL_PAGE_SLOTS)) {
+            break ;
+        }
+    }
+
+    if ((page == NULL) || ((size_t) (bytes - page->slots) % size != 0)) {
+
+        error(stderr, "the object does not belong to the pool [%s%s%s]\n", PURPLE, pool->name, WHITE);
+
+        return -1;
+    }
+
+    /* A free slot is poisoned everywhere but in the link to the next free slot */
+    for (size_t i = sizeof(void*); i < size; i++) {
+
+        if (bytes[i] != POOL_POISON) {
+            return 0;
+        }
+    }
+
+    if (size > sizeof(void*)) {
+
+        error(stderr, "the object has already been returned to the pool [%s%s%s]\n", PURPLE, pool->name, WHITE);
+
+        return -1;
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+#endif
+
+/* ================================================================ */
+/* ============== Definitions of external functions =============== */
+/* ================================================================ */
+
+void* Pool_calloc(Pool* pool) {
+
+    void* object;
+    int first_page = 0;
+
+    /* ================ */
+
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    SDL_AtomicLock(&pool->lock);
+
+    if ((pool->free_list == NULL) && ((first_page = add_page(pool)) == -1)) {
+        SDL_AtomicUnlock(&pool->lock);
+
+        return NULL;
+    }
+
+    object = pool->free_list;
+    pool->free_list = *(void**) object;
+
+    pool->stats.allocations++;
+    pool->stats.live++;
+    pool->stats.peak = (pool->stats.live > pool->stats.peak) ? pool->stats.live : pool->stats.peak;
+
+    SDL_AtomicUnlock(&pool->lock);
+
+    if (first_page) {
+        register_pool(pool);
+    }
+
+    memset(object, 0, pool->size);
+
+    /* ======== */
+
+    return object;
+}
+
+/* ================================================================ */
+
+void Pool_free(Pool* pool, void* object) {
+
+    if ((pool == NULL) || (object == NULL)) {
+        return ;
+    }
+
+    SDL_AtomicLock(&pool->lock);
+
+    #ifdef POOL_DEBUG
+        if (check_slot(pool, object) != 0) {
+            SDL_AtomicUnlock(&pool->lock);
+
+            return ;
+        }
+
+        memset(object, POOL_POISON, slot_size(pool));
+    #endif
+
+    *(void**) object = pool->free_list;
+    pool->free_list = object;
+
+    pool->stats.frees++;
+    pool->stats.live--;
+
+    SDL_AtomicUnlock(&pool->lock);
+}
+
+/* ================================================================ */
+
+int Pool_get_stats(Pool* pool, Pool_Stats* stats) {
+
+    if ((pool == NULL) || (stats == NULL)) {
+        return -1;
+    }
+
+    SDL_AtomicLock(&pool->lock);
+
+    *stats = pool->stats;
+
+    SDL_AtomicUnlock(&pool->lock);
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+void Pool_print_stats(FILE* stream) {
+
+    stream = (stream == NULL) ? stdout : stream;
+
+    /* ================ */
+
+    SDL_AtomicLock(&pools_lock);
+
+    for (Pool* pool = pools; pool != NULL; pool = pool->next) {
+
+        Pool_Stats stats;
+
+        Pool_get_stats(pool, &stats);
+
+        fprintf(stream, "%s%-12s%s live: %zu, peak: %zu, allocations: %zu, frees: %zu, pages: %zu (%zu bytes)\n",
+            CYAN, pool->name, WHITE, stats.live, stats.peak, stats.allocations, stats.frees, stats.pages, stats.pages * POOL_PAGE_SLOTS * slot_size(pool));
+    }
+
+    SDL_AtomicUnlock(&pools_lock);
+}
+
+/* ================================================================ */
+
+void Pool_release_unused(void) {
+
+    Pool** link;
+
+    /* ================ */
+
+    SDL_AtomicLock(&pools_lock);
+
+    for (link = &pools; *link != NULL;) {
+
+        Pool* pool = *link;
+
+        SDL_AtomicLock(&pool->lock);
+
+        if (pool->stats.live != 0) {
+            SDL_AtomicUnlock(&pool->lock);
+
+            link = &pool->next;
+
+            continue ;
+        }
+
+        while (pool->pages != NULL) {
+
+            Pool_Page* next = pool->pages->next;
+
+            free(pool->pages);
+            pool->pages = next;
+        }
+
+        pool->free_list = NULL;
+        pool->stats.pages = 0;
+
+        /* Unlink the pool; it registers again when it allocates a new page */
+        *link = pool->next;
+        pool->next = NULL;
+
+        SDL_AtomicUnlock(&pool->lock);
+    }
+
+    SDL_AtomicUnlock(&pools_lock);
+}
+
+/* ================================================================ */
@@ -0,0 +1,575 @@
+#include "../../sancho-panza.h"
+
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* The room for the suffix that makes the name of a temporary file unique: `.`, the process ID, `.`, a counter and `.tmp` */
+#define TEMPORARY_SUFFIX_LENGTH 48
+
+/* The number of names tried before giving up on creating a temporary file */
+#define TEMPORARY_ATTEMPTS 100
+
+/* ================================================================ */
+
+struct save_request {
+
+    char* name;
+
+    /* Either a `cJSON` object to print, or serialized data to write */
+    cJSON* item;
+    int format;
+
+    void* data;
+    size_t size;
+
+    atomic_int status;
+
+    /* The queue and the handle each hold a reference; the last one to let go frees the request */
+    atomic_int references;
+
+    Save_Handle* next;
+};
+
+/* ================================================================ */
+
+static struct saver {
+
+    SDL_Thread* thread;
+
+    /* Guards the queue and `running` */
+    SDL_mutex* lock;
+
+    /* Signaled when a save is queued, and when one is finished */
+    SDL_cond* queued;
+    SDL_cond* finished;
+
+    Save_Handle* first;
+    Save_Handle* last;
+
+    int running;
+} saver = {NULL, NULL, NULL, NULL, NULL, NULL, 0};
+
+/* ================================================================ */
+/* ================== Static, internal functions ================== */
+/* ================================================================ */
+
+static int write_all(int fd, const unsigned char* data, size_t size) {
+
+    ssize_t written;
+
+    /* ================ */
+
+    while (size > 0) {
+
+        if ((written = write(fd, data, size)) < 0) {
+
+            if (errno == EINTR) {
+                continue ;
+            }
+
+            return -1;
+        }
+
+        data += written;
+        size -= (size_t) written;
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+/**
+ * The `create_temporary` function creates a new file next to the destination, with the mode the destination has,
+ * or with the mode a new file gets from the umask if there is no destination yet.
+ *
+ * @return The descriptor of the file, opened for writing. `-1` on failure.
+ */
+static int create_temporary(const char* name, char* temporary) {
+
+    /* Shared by the saving threads, so two saves of the same file never pick the same name */
+    static atomic_uint counter = 0;
+
+    struct stat destination;
+    size_t length = strlen(name);
+
+    int fd = -1;
+
+    /* ================ */
+
+    memcpy(temporary, name, length);
+
+    for (int i = 0; (i < TEMPORARY_ATTEMPTS) && (fd < 0); i++) {
+
+        snprintf(temporary + length, TEMPORARY_SUFFIX_LENGTH, ".%ld.%u.tmp", (long) getpid(), atomic_fetch_add(&counter, 1));
+
+        /* The kernel applies the umask to the mode of a new file */
+        if (((fd = open(temporary, O_WRONLY | O_CREAT | O_EXCL, 0666)) < 0) && (errno != EEXIST)) {
+            return -1;
+        }
+    }
+
+    if ((fd >= 0) && (stat(name, &destination) == 0)) {
+        fchmod(fd, destination.st_mode & 07777);
+    }
+
+    /* ======== */
+
+    return fd;
+}
+
+/* ================================================================ */
+
+/**
+ * The `sync_directory` function flushes the directory of a file, so a rename into it survives a crash.
+ *
+ * @return `0` on success, or if the file system cannot sync directories. `-1` on failure.
+ */
+static int sync_directory(const char* name) {
+
+    const char* slash = strrchr(name, '/');
+    char* directory;
+
+    int fd;
+    int status = 0;
+
+    /* ================ */
+
+    if (slash == NULL) {
+        directory = strdup(".");
+    }
+    else if ((directory = malloc((size_t) (slash - name) + 2)) != NULL) {
+
+        /* The root directory keeps its slash */
+        size_t length = (slash == name) ? 1 : (size_t) (slash - name);
+
+        memcpy(directory, name, length);
+        directory[length] = '\0';
+    }
+
+    if (directory == NULL) {
+        return -1;
+    }
+
+    if ((fd = open(directory, O_RDONLY)) < 0) {
+        free(directory);
+
+        return -1;
+    }
+
+    if ((fsync(fd) != 0) && (errno != EINVAL)) {
+        status = -1;
+    }
+
+    close(fd);
+    free(directory);
+
+    /* ======== */
+
+    return status;
+}
+
+/* ================================================================ */
+
+/**
+ * The `write_request` function writes a save into a temporary file in the directory of the destination and renames it into place.
+ */
+static int write_request(const Save_Handle* request) {
+
+    char* temporary;
+
+    int fd;
+    int status = 0;
+
+    /* ================ */
+
+    if ((temporary = malloc(strlen(request->name) + TEMPORARY_SUFFIX_LENGTH)) == NULL) {
+        return -1;
+    }
+
+    if ((fd = create_temporary(request->name, temporary)) < 0) {
+
+        error(stderr, "unable to save (%s%s%s) [%s%s%s]\n", CYAN, request->name, WHITE, RED, strerror(errno), WHITE);
+
+        free(temporary);
+
+        return -1;
+    }
+
+    /* ================================================ */
+    /* ============== Writing the contents ============ */
+    /* ================================================ */
+
+    if (request->item != NULL) {
+        status = cJSON_PrintToFileDescriptor(request->item, fd, request->format) ? 0 : -1;
+    }
+    else {
+        status = write_all(fd, request->data, request->size);
+    }
+
+    /* The data must be on the disk before the rename makes it visible */
+    if ((status != 0) || (fsync(fd) != 0)) {
+        status = -1;
+    }
+
+    if (close(fd) != 0) {
+        status = -1;
+    }
+
+    /* ================================================ */
+    /* ======== Replacing the destination file ======== */
+    /* ================================================ */
+
+    if ((status != 0) || (rename(temporary, request->name) != 0)) {
+
+        error(stderr, "unable to save (%s%s%s) [%s%s%s]\n", CYAN, request->name, WHITE, RED, strerror(errno), WHITE);
+
+        unlink(temporary);
+        status = -1;
+    }
+
+    /* The rename itself is only durable once the directory is on the disk */
+    else if (sync_directory(request->name) != 0) {
+
+        error(stderr, "unable to sync the directory of (%s%s%s) [%s%s%s]\n", CYAN, request->name, WHITE, RED, strerror(errno), WHITE);
+
+        status = -1;
+    }
+
+    free(temporary);
+
+    /* ======== */
+
+    return status;
+}
+
+/* ================================================================ */
+
+static void release_request(Save_Handle* request) {
+
+    if (atomic_fetch_sub(&request->references, 1) != 1) {
+        return ;
+    }
+
+    cJSON_Delete(request->item);
+    free(request->data);
+    free(request->name);
+    free(request);
+}
+
+/* ================================================================ */
+
+/**
+ * The `complete_request` function writes a save, frees its contents and publishes the result.
+ */
+static void complete_request(Save_Handle* request) {
+
+    Save_Status status = (write_request(request) == 0) ? SAVE_DONE : SAVE_FAILED;
+
+    /* ================ */
+
+    /* The contents are not needed anymore, even if the handle is kept for a long time */
+    cJSON_Delete(request->item);
+    free(request->data);
+
+    request->item = NULL;
+    request->data = NULL;
+
+    if (saver.lock != NULL) {
+        SDL_LockMutex(saver.lock);
+    }
+
+    atomic_store(&request->status, status);
+
+    if (saver.lock != NULL) {
+        SDL_CondBroadcast(saver.finished);
+        SDL_UnlockMutex(saver.lock);
+    }
+
+    release_request(request);
+}
+
+/* ================================================================ */
+
+static int saver_main(void* data) {
+
+    Save_Handle* request;
+
+    /* ================ */
+
+    (void) data;
+
+    SDL_LockMutex(saver.lock);
+
+    for (;;) {
+
+        while ((saver.first == NULL) && saver.running) {
+            SDL_CondWait(saver.queued, saver.lock);
+        }
+
+        /* The queue is drained before the thread stops */
+        if ((request = saver.first) == NULL) {
+            break ;
+        }
+
+        if ((saver.first = request->next) == NULL) {
+            saver.last = NULL;
+        }
+
+        SDL_UnlockMutex(saver.lock);
+
+        complete_request(request);
+
+        SDL_LockMutex(saver.lock);
+    }
+
+    SDL_UnlockMutex(saver.lock);
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+/**
+ * The `submit` function hands a save over to the background thread, or writes it right away if the saver is not running.
+ */
+static int submit(const char* name, cJSON* item, int format, void* data, size_t size, Save_Handle** handle) {
+
+    Save_Handle* request = NULL;
+    size_t length;
+
+    /* ================ */
+
+    if (handle != NULL) {
+        *handle = NULL;
+    }
+
+    if ((name == NULL) || ((item == NULL) && (data == NULL))) {
+        goto END;
+    }
+
+    if ((request = calloc(1, sizeof(Save_Handle))) == NULL) {
+        goto END;
+    }
+
+    length = strlen(name) + 1;
+
+    if ((request->name = malloc(length)) == NULL) {
+        goto END;
+    }
+
+    memcpy(request->name, name, length);
+
+    request->item = item;
+    request->format = format;
+    request->data = data;
+    request->size = size;
+
+    atomic_init(&request->status, SAVE_PENDING);
+    atomic_init(&request->references, (handle != NULL) ? 2 : 1);
+
+    if (handle != NULL) {
+        *handle = request;
+    }
+
+    /* ================================================ */
+    /* ============== Queuing the request ============= */
+    /* ================================================ */
+
+    if (saver.lock != NULL) {
+
+        SDL_LockMutex(saver.lock);
+
+        if (saver.running) {
+
+            if (saver.last != NULL) {
+                saver.last->next = request;
+            }
+            else {
+                saver.first = request;
+            }
+
+            saver.last = request;
+
+            SDL_CondSignal(saver.queued);
+            SDL_UnlockMutex(saver.lock);
+
+            return 0;
+        }
+
+        SDL_UnlockMutex(saver.lock);
+    }
+
+    complete_request(request);
+
+    /* ======== */
+
+    return 0;
+
+    { END:
+        error(stderr, "in %s%s%s (%s%s%s)\n", BLUE, __func__, WHITE, RED, strerror(errno), WHITE);
+
+        if (request != NULL) {
+            free(request->name);
+            free(request);
+        }
+
+        cJSON_Delete(item);
+        free(data);
+
+        return -1;
+    }
+}
+
+/* ================================================================ */
+/* ============== Definitions of external functions =============== */
+/* ================================================================ */
+
+int Saver_init(void) {
+
+    if (saver.lock != NULL) {
+        return -1;
+    }
+
+    if (((saver.lock = SDL_CreateMutex()) == NULL) || ((saver.queued = SDL_CreateCond()) == NULL) || ((saver.finished = SDL_CreateCond()) == NULL)) {
+        goto END;
+    }
+
+    saver.running = 1;
+
+    if ((saver.thread = SDL_CreateThread(saver_main, "SP_saver", NULL)) == NULL) {
+        goto END;
+    }
+
+    /* ======== */
+
+    return 0;
+
+    { END:
+        error(stderr, "unable to start the saver (%s%s%s)\n", RED, SDL_GetError(), WHITE);
+
+        SDL_DestroyCond(saver.finished);
+        SDL_DestroyCond(saver.queued);
+        SDL_DestroyMutex(saver.lock);
+
+        memset(&saver, 0, sizeof(saver));
+
+        return -1;
+    }
+}
+
+/* ================================================================ */
+
+void Saver_quit(void) {
+
+    if (saver.lock == NULL) {
+        return ;
+    }
+
+    SDL_LockMutex(saver.lock);
+
+    saver.running = 0;
+
+    SDL_CondSignal(saver.queued);
+    SDL_UnlockMutex(saver.lock);
+
+    SDL_WaitThread(saver.thread, NULL);
+
+    SDL_DestroyCond(saver.finished);
+    SDL_DestroyCond(saver.queued);
+    SDL_DestroyMutex(saver.lock);
+
+    memset(&saver, 0, sizeof(saver));
+}
+
+/* ================================================================ */
+
+int Save_JSON_async(const char* name, cJSON* item, int format, Save_Handle** handle) {
+
+    if (item == NULL) {
+
+        if (handle != NULL) {
+            *handle = NULL;
+        }
+
+        return -1;
+    }
+
+    /* ======== */
+
+    return submit(name, item, format, NULL, 0, handle);
+}
+
+/* ================================================================ */
+
+int Save_buffer_async(const char* name, void* data, size_t size, Save_Handle** handle) {
+
+    if (data == NULL) {
+
+        if (handle != NULL) {
+            *handle = NULL;
+        }
+
+        return -1;
+    }
+
+    /* ======== */
+
+    return submit(name, NULL, 0, data, size, handle);
+}
+
+/* ================================================================ */
+
+Save_Status Save_poll(const Save_Handle* handle) {
+    return (handle == NULL) ? SAVE_FAILED : (Save_Status) atomic_load(&((Save_Handle*) handle)->status);
+}
+
+/* ================================================================ */
+
+Save_Status Save_wait(Save_Handle* handle) {
+
+    Save_Status status;
+
+    /* ================ */
+
+    if ((status = Save_poll(handle)) != SAVE_PENDING) {
+        return status;
+    }
+
+    /* A pending save is queued, so the saver is running */
+    SDL_LockMutex(saver.lock);
+
+    while ((status = Save_poll(handle)) == SAVE_PENDING) {
+        SDL_CondWait(saver.finished, saver.lock);
+    }
+
+    SDL_UnlockMutex(saver.lock);
+
+    /* ======== */
+
+    return status;
+}
+
+/* ================================================================ */
+
+void Save_release(Save_Handle** handle) {
+
+    if ((handle == NULL) || (*handle == NULL)) {
+        return ;
+    }
+
+    release_request(*handle);
+
+    *handle = NULL;
+}
+
+/* ================================================================ */
+
+#undef TEMPORARY_SUFFIX_LENGTH
+#undef TEMPORARY_ATTEMPTS
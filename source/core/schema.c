@@ -0,0 +1,463 @@
+#include "../../sancho-panza.h"
+
+#include <math.h>
+
+/* ================================================================ */
+/* ================== Static, internal functions ================== */
+/* ================================================================ */
+
+static int deserialize(const cJSON* object, Schema* schema, void* destination, Schema_Report* report);
+
+/* ================================================================ */
+
+/* FNV-1a */
+static Uint32 hash_name(const char* name) {
+
+    Uint32 hash = 2166136261u;
+
+    /* ================ */
+
+    while (*name != '\0') {
+        hash = (hash ^ (unsigned char) *name++) * 16777619u;
+    }
+
+    /* ======== */
+
+    return hash;
+}
+
+/* ================================================================ */
+
+/**
+ * The `build_index` function puts every field of the schema into the slot its name hashes to, or the next free one (linear probing).
+ * It runs once per schema; the threads that use the schema at the same time wait for the first one to finish.
+ *
+ * @return `0` on success. `-1` if the schema has too many fields or two fields with the same name.
+ */
+static int build_index(Schema* schema) {
+
+    int status = 0;
+
+    /* ================ */
+
+    if (SDL_AtomicGet(&schema->ready)) {
+        return 0;
+    }
+
+    SDL_AtomicLock(&schema->lock);
+
+    if (!SDL_AtomicGet(&schema->ready)) {
+
+        if (schema->count > SCHEMA_MAX_FIELDS) {
+            status = -1;
+        }
+
+        for (size_t i = 0; (status == 0) && (i < schema->count); i++) {
+
+            Uint32 hash = hash_name(schema->fields[i].name);
+            Uint32 slot = hash & (SCHEMA_SLOTS - 1);
+
+            while (schema->slots[slot] != 0) {
+
+                if ((schema->hashes[slot] == hash) && (strcmp(schema->fields[schema->slots[slot] - 1].name, schema->fields[i].name) == 0)) {
+                    status = -1;
+
+                    break ;
+                }
+
+                slot = (slot + 1) & (SCHEMA_SLOTS - 1);
+            }
+
+            schema->hashes[slot] = hash;
+            schema->slots[slot] = (Uint8) (i + 1);
+        }
+
+        if (status == 0) {
+            SDL_AtomicSet(&schema->ready, 1);
+        }
+        else {
+            memset(schema->slots, 0, sizeof(schema->slots));
+        }
+    }
+
+    SDL_AtomicUnlock(&schema->lock);
+
+    /* ======== */
+
+    return status;
+}
+
+/* ================================================================ */
+
+/**
+ * The `find_field` function looks a key up in the index of a schema.
+ *
+ * @return The index of the field, or `-1` if the schema does not describe the key.
+ */
+static int find_field(const Schema* schema, const char* name) {
+
+    Uint32 hash = hash_name(name);
+    Uint32 slot = hash & (SCHEMA_SLOTS - 1);
+
+    /* ================ */
+
+    for (; schema->slots[slot] != 0; slot = (slot + 1) & (SCHEMA_SLOTS - 1)) {
+
+        if ((schema->hashes[slot] == hash) && (strcmp(schema->fields[schema->slots[slot] - 1].name, name) == 0)) {
+            return schema->slots[slot] - 1;
+        }
+    }
+
+    /* ======== */
+
+    return -1;
+}
+
+/* ================================================================ */
+
+static void add_error(Schema_Report* report, const char* name, Field_Error problem) {
+
+    if (report->count < SCHEMA_REPORT_SIZE) {
+        report->errors[report->count].name = name;
+        report->errors[report->count].error = problem;
+    }
+
+    report->count++;
+}
+
+/* ================================================================ */
+
+static int set_default(const Field* field, void* member) {
+
+    switch (field->type) {
+
+        case FIELD_INT:
+        case FIELD_BOOL:
+            *(int*) member = (int) field->number;
+            break ;
+
+        case FIELD_UINT8:
+            *(Uint8*) member = (Uint8) field->number;
+            break ;
+
+        case FIELD_UINT32:
+            *(Uint32*) member = (Uint32) field->number;
+            break ;
+
+        case FIELD_FLOAT:
+            *(float*) member = (float) field->number;
+            break ;
+
+        case FIELD_DOUBLE:
+            *(double*) member = field->number;
+            break ;
+
+        case FIELD_STRING:
+            *(char**) member = NULL;
+
+            if ((field->string != NULL) && ((*(char**) member = strdup(field->string)) == NULL)) {
+                return -1;
+            }
+
+            break ;
+
+        case FIELD_OBJECT:
+            return JSON_deserialize_defaults(field->schema, member);
+
+        case FIELD_CUSTOM:
+            /* The member keeps the value it has */
+            break ;
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+/**
+ * The `read_number` function checks that a value is a number in `[minimum, maximum]`.
+ */
+static int read_number(const cJSON* item, double minimum, double maximum, double* number, Field_Error* problem) {
+
+    if (!cJSON_IsNumber(item)) {
+        *problem = FIELD_MISMATCH;
+
+        return -1;
+    }
+
+    if (isnan(item->valuedouble) || (item->valuedouble < minimum) || (item->valuedouble > maximum)) {
+        *problem = FIELD_INVALID;
+
+        return -1;
+    }
+
+    *number = item->valuedouble;
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+/**
+ * The `set_value` function converts a value into a member. Errors found inside a nested object are added to the report directly.
+ *
+ * @return `0` on success, `-1` with `problem` set otherwise.
+ */
+static int set_value(const Field* field, const cJSON* item, void* member, Schema_Report* report, Field_Error* problem) {
+
+    double number;
+
+    /* ================ */
+
+    switch (field->type) {
+
+        case FIELD_INT:
+            if (read_number(item, INT_MIN, INT_MAX, &number, problem) != 0) {
+                return -1;
+            }
+
+            *(int*) member = (int) number;
+            break ;
+
+        case FIELD_UINT8:
+            if (read_number(item, 0, 255, &number, problem) != 0) {
+                return -1;
+            }
+
+            *(Uint8*) member = (Uint8) number;
+            break ;
+
+        case FIELD_UINT32:
+            if (read_number(item, 0, 4294967295.0, &number, problem) != 0) {
+                return -1;
+            }
+
+            *(Uint32*) member = (Uint32) number;
+            break ;
+
+        case FIELD_FLOAT:
+        case FIELD_DOUBLE:
+            if (read_number(item, -HUGE_VAL, HUGE_VAL, &number, problem) != 0) {
+                return -1;
+            }
+
+            if (field->type == FIELD_FLOAT) {
+                *(float*) member = (float) number;
+            }
+            else {
+                *(double*) member = number;
+            }
+
+            break ;
+
+        case FIELD_BOOL:
+            if (!cJSON_IsBool(item)) {
+                *problem = FIELD_MISMATCH;
+
+                return -1;
+            }
+
+            *(int*) member = cJSON_IsTrue(item);
+            break ;
+
+        case FIELD_STRING:
+            if (!cJSON_IsString(item)) {
+                *problem = FIELD_MISMATCH;
+
+                return -1;
+            }
+
+            if ((*(char**) member = strdup(item->valuestring)) == NULL) {
+                *problem = FIELD_INVALID;
+
+                return -1;
+            }
+
+            break ;
+
+        case FIELD_OBJECT:
+            if (!cJSON_IsObject(item)) {
+                *problem = FIELD_MISMATCH;
+
+                return -1;
+            }
+
+            /* The nested fields report their own errors; the object itself is fine */
+            deserialize(item, field->schema, member, report);
+            break ;
+
+        case FIELD_CUSTOM:
+            if (field->parse(item, member) != 0) {
+                *problem = FIELD_INVALID;
+
+                return -1;
+            }
+
+            break ;
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+static const char* error_name(Field_Error problem) {
+
+    switch (problem) {
+
+        case FIELD_MISSING:
+            return "missing";
+
+        case FIELD_MISMATCH:
+            return "wrong type";
+
+        case FIELD_INVALID:
+            return "invalid value";
+    }
+
+    /* ======== */
+
+    return "";
+}
+
+/**
+ * The `deserialize` function does the work of `JSON_deserialize`, for the object and for the objects nested in it. Errors are only added to the report.
+ */
+static int deserialize(const cJSON* object, Schema* schema, void* destination, Schema_Report* report) {
+
+    /* One bit per field that has been read */
+    Uint32 seen = 0;
+
+    const cJSON* child;
+    Field_Error problem;
+
+    size_t first_error = report->count;
+    int index;
+
+    /* ================ */
+
+    if (build_index(schema) != 0) {
+
+        error(stderr, "in %s%s%s (a schema has more than %d fields, or two fields with the same name)\n", BLUE, __func__, WHITE, SCHEMA_MAX_FIELDS);
+
+        return -1;
+    }
+
+    /* ================================================ */
+    /* ========= Reading the children, once =========== */
+    /* ================================================ */
+
+    cJSON_ArrayForEach(child, object) {
+
+        const Field* field;
+
+        if ((child->string == NULL) || ((index = find_field(schema, child->string)) < 0) || (seen & (1u << index))) {
+            continue ;
+        }
+
+        seen |= 1u << index;
+        field = &schema->fields[index];
+
+        if (set_value(field, child, (char*) destination + field->offset, report, &problem) != 0) {
+            add_error(report, field->name, problem);
+
+            set_default(field, (char*) destination + field->offset);
+        }
+    }
+
+    /* ================================================ */
+    /* ============ The fields not found ============== */
+    /* ================================================ */
+
+    for (size_t i = 0; i < schema->count; i++) {
+
+        if (seen & (1u << i)) {
+            continue ;
+        }
+
+        if (schema->fields[i].required) {
+            add_error(report, schema->fields[i].name, FIELD_MISSING);
+        }
+
+        if (set_default(&schema->fields[i], (char*) destination + schema->fields[i].offset) != 0) {
+            add_error(report, schema->fields[i].name, FIELD_INVALID);
+        }
+    }
+
+    /* ======== */
+
+    return (report->count == first_error) ? 0 : -1;
+}
+
+/* ================================================================ */
+/* ============== Definitions of external functions =============== */
+/* ================================================================ */
+
+int JSON_deserialize(const cJSON* object, Schema* schema, void* destination, Schema_Report* report) {
+
+    Schema_Report local_report;
+
+    size_t first_error;
+    int status;
+
+    /* ================ */
+
+    if ((schema == NULL) || (destination == NULL) || !cJSON_IsObject(object)) {
+        return -1;
+    }
+
+    if (report == NULL) {
+        report = &local_report;
+        report->count = 0;
+    }
+
+    first_error = report->count;
+
+    status = deserialize(object, schema, destination, report);
+
+    /* ================================================ */
+    /* ======== Every error is printed at once ======== */
+    /* ================================================ */
+
+    for (size_t i = first_error; (i < report->count) && (i < SCHEMA_REPORT_SIZE); i++) {
+        error(stderr, "the element [%s%s%s] of the document: %s\n", PURPLE, report->errors[i].name, WHITE, error_name(report->errors[i].error));
+    }
+
+    if (report->count > SCHEMA_REPORT_SIZE) {
+        error(stderr, "and %zu more errors\n", report->count - SCHEMA_REPORT_SIZE);
+    }
+
+    /* ======== */
+
+    return status;
+}
+
+/* ================================================================ */
+
+int JSON_deserialize_defaults(const Schema* schema, void* destination) {
+
+    int status = 0;
+
+    /* ================ */
+
+    if ((schema == NULL) || (destination == NULL)) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < schema->count; i++) {
+
+        if (set_default(&schema->fields[i], (char*) destination + schema->fields[i].offset) != 0) {
+            status = -1;
+        }
+    }
+
+    /* ======== */
+
+    return status;
+}
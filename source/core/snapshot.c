@@ -0,0 +1,507 @@
+#include "../../sancho-panza.h"
+
+/* The sizes of the header and of an entry of the section table, in the file */
+#define HEADER_SIZE 24
+#define SECTION_SIZE 32
+
+/* ================================================================ */
+
+/**
+ * A section added to a writer. The payloads are kept one after another in `payload`, each aligned to `SNAPSHOT_ALIGNMENT`.
+ */
+struct snapshot_section {
+
+    Uint32 tag;
+    Uint32 id;
+    Uint32 flags;
+
+    /* The position of the payload in the payload buffer of the writer */
+    size_t offset;
+    size_t size;
+};
+
+/* ================================================================ */
+
+struct snapshot_writer {
+
+    struct snapshot_section* sections;
+    size_t count;
+    size_t capacity;
+
+    Uint8* payload;
+    size_t used;
+    size_t allocated;
+};
+
+/* ================================================================ */
+
+/* The table of the CRC-32 (the one of zlib and PNG), built the first time it is needed */
+static Uint32 crc_table[256];
+static SDL_atomic_t crc_ready;
+static SDL_SpinLock crc_lock;
+
+/* ================================================================ */
+/* ================== Static, internal functions ================== */
+/* ================================================================ */
+
+static Uint32 checksum(const void* data, size_t size) {
+
+    const Uint8* bytes = data;
+    Uint32 crc = 0xFFFFFFFFu;
+
+    /* ================ */
+
+    if (!SDL_AtomicGet(&crc_ready)) {
+
+        SDL_AtomicLock(&crc_lock);
+
+        if (!SDL_AtomicGet(&crc_ready)) {
+
+            for (Uint32 i = 0; i < 256; i++) {
+
+                Uint32 value = i;
+
+                for (int bit = 0; bit < 8; bit++) {
+                    value = (value & 1) ? (value >> 1) ^ 0xEDB88320u : value >> 1;
+                }
+
+                crc_table[i] = value;
+            }
+
+            SDL_AtomicSet(&crc_ready, 1);
+        }
+
+        SDL_AtomicUnlock(&crc_lock);
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        crc = crc_table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+
+    /* ======== */
+
+    return crc ^ 0xFFFFFFFFu;
+}
+
+/* ================================================================ */
+
+static size_t align_up(size_t value) {
+    return (value + SNAPSHOT_ALIGNMENT - 1) & ~(size_t) (SNAPSHOT_ALIGNMENT - 1);
+}
+
+/* ================================================================ */
+
+/* Little-endian numbers at any address */
+static void put_Uint16(Uint8* destination, Uint16 value) {
+    value = SDL_SwapLE16(value);
+    memcpy(destination, &value, sizeof(value));
+}
+
+static void put_Uint32(Uint8* destination, Uint32 value) {
+    value = SDL_SwapLE32(value);
+    memcpy(destination, &value, sizeof(value));
+}
+
+static void put_Uint64(Uint8* destination, Uint64 value) {
+    value = SDL_SwapLE64(value);
+    memcpy(destination, &value, sizeof(value));
+}
+
+static Uint16 get_Uint16(const Uint8* source) {
+
+    Uint16 value;
+
+    memcpy(&value, source, sizeof(value));
+
+    return SDL_SwapLE16(value);
+}
+
+static Uint32 get_Uint32(const Uint8* source) {
+
+    Uint32 value;
+
+    memcpy(&value, source, sizeof(value));
+
+    return SDL_SwapLE32(value);
+}
+
+static Uint64 get_Uint64(const Uint8* source) {
+
+    Uint64 value;
+
+    memcpy(&value, source, sizeof(value));
+
+    return SDL_SwapLE64(value);
+}
+
+/* ================================================================ */
+
+/**
+ * The `reserve_section` function makes room for a new section and its payload.
+ *
+ * @return A pointer to where the payload goes, or `NULL` with `errno` set if the section exists already (`EEXIST`), is too large or memory allocation fails.
+ */
+static Uint8* reserve_section(Snapshot_Writer* writer, Uint32 tag, Uint32 id, size_t size, Uint32 flags) {
+
+    struct snapshot_section* section;
+    size_t offset = align_up(writer->used);
+
+    /* ================ */
+
+    for (size_t i = 0; i < writer->count; i++) {
+
+        if ((writer->sections[i].tag == tag) && (writer->sections[i].id == id)) {
+            errno = EEXIST;
+
+            return NULL;
+        }
+    }
+
+    if ((writer->count >= 0xFFFFFFFFu) || (size > SIZE_MAX / 2 - offset)) {
+        errno = EOVERFLOW;
+
+        return NULL;
+    }
+
+    if (writer->count == writer->capacity) {
+
+        size_t capacity = (writer->capacity == 0) ? 8 : writer->capacity * 2;
+        struct snapshot_section* sections;
+
+        if ((sections = realloc(writer->sections, capacity * sizeof(struct snapshot_section))) == NULL) {
+            return NULL;
+        }
+
+        writer->sections = sections;
+        writer->capacity = capacity;
+    }
+
+    if (offset + size > writer->allocated) {
+
+        size_t allocated = (writer->allocated == 0) ? 4096 : writer->allocated;
+        Uint8* payload;
+
+        while (allocated < offset + size) {
+            allocated *= 2;
+        }
+
+        if ((payload = realloc(writer->payload, allocated)) == NULL) {
+            return NULL;
+        }
+
+        writer->payload = payload;
+        writer->allocated = allocated;
+    }
+
+    /* The padding is zeroed, so the same snapshot always gives the same file */
+    if (offset > writer->used) {
+        memset(writer->payload + writer->used, 0, offset - writer->used);
+    }
+
+    section = &writer->sections[writer->count++];
+
+    section->tag = tag;
+    section->id = id;
+    section->flags = flags & SNAPSHOT_CHECKSUM;
+    section->offset = offset;
+    section->size = size;
+
+    writer->used = offset + size;
+
+    /* ======== */
+
+    return writer->payload + offset;
+}
+
+/* ================================================================ */
+
+static int is_valid_section(const Snapshot* snapshot, Uint64 offset, Uint64 size) {
+
+    return (offset % SNAPSHOT_ALIGNMENT == 0) && (offset <= snapshot->file.size) && (size <= snapshot->file.size - offset);
+}
+
+/* ================================================================ */
+/* ============== Definitions of external functions =============== */
+/* ================================================================ */
+
+Snapshot_Writer* Snapshot_Writer_new(void) {
+    return calloc(1, sizeof(Snapshot_Writer));
+}
+
+/* ================================================================ */
+
+void Snapshot_Writer_destroy(Snapshot_Writer** writer) {
+
+    if ((writer == NULL) || (*writer == NULL)) {
+        return ;
+    }
+
+    free((*writer)->sections);
+    free((*writer)->payload);
+    free(*writer);
+
+    *writer = NULL;
+}
+
+/* ================================================================ */
+
+int Snapshot_add(Snapshot_Writer* writer, Uint32 tag, Uint32 id, const void* data, size_t size, Uint32 flags) {
+
+    Uint8* payload;
+
+    /* ================ */
+
+    if ((writer == NULL) || ((data == NULL) && (size != 0))) {
+        return -1;
+    }
+
+    if ((payload = reserve_section(writer, tag, id, size, flags)) == NULL) {
+
+        error(stderr, "in %s%s%s (%s%s%s)\n", BLUE, __func__, WHITE, RED, strerror(errno), WHITE);
+
+        return -1;
+    }
+
+    if (size != 0) {
+        memcpy(payload, data, size);
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+int Snapshot_add_Uint32(Snapshot_Writer* writer, Uint32 tag, Uint32 id, const Uint32* values, size_t count, Uint32 flags) {
+
+    Uint8* payload;
+
+    /* ================ */
+
+    if ((writer == NULL) || ((values == NULL) && (count != 0)) || (count > SIZE_MAX / sizeof(Uint32))) {
+        return -1;
+    }
+
+    if ((payload = reserve_section(writer, tag, id, count * sizeof(Uint32), flags)) == NULL) {
+
+        error(stderr, "in %s%s%s (%s%s%s)\n", BLUE, __func__, WHITE, RED, strerror(errno), WHITE);
+
+        return -1;
+    }
+
+    #if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        if (count != 0) {
+            memcpy(payload, values, count * sizeof(Uint32));
+        }
+    #else
+        for (size_t i = 0; i < count; i++) {
+            put_Uint32(payload + i * sizeof(Uint32), values[i]);
+        }
+    #endif
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+int Snapshot_save(Snapshot_Writer* writer, const char* name, Save_Handle** handle) {
+
+    Uint8* file;
+    Uint8* entry;
+
+    size_t payload_start;
+    size_t size;
+
+    /* ================ */
+
+    if ((writer == NULL) || (name == NULL)) {
+        return -1;
+    }
+
+    payload_start = align_up(HEADER_SIZE + writer->count * SECTION_SIZE);
+    size = payload_start + writer->used;
+
+    /* ================================================ */
+    /* ===== Making room for the header and the ======= */
+    /* ===== table in front of the payloads, in the === */
+    /* ===== buffer of the writer, not in a copy ====== */
+    /* ================================================ */
+
+    if ((file = realloc(writer->payload, size)) == NULL) {
+
+        error(stderr, "in %s%s%s (%s%s%s)\n", BLUE, __func__, WHITE, RED, strerror(errno), WHITE);
+
+        return -1;
+    }
+
+    if (writer->used != 0) {
+        memmove(file + payload_start, file, writer->used);
+    }
+
+    memset(file, 0, payload_start);
+
+    /* ================================================ */
+    /* =================== The table ================== */
+    /* ================================================ */
+
+    for (size_t i = 0; i < writer->count; i++) {
+
+        const struct snapshot_section* section = &writer->sections[i];
+
+        entry = file + HEADER_SIZE + i * SECTION_SIZE;
+
+        put_Uint32(entry, section->tag);
+        put_Uint32(entry + 4, section->id);
+        put_Uint32(entry + 8, section->flags);
+        put_Uint32(entry + 12, (section->flags & SNAPSHOT_CHECKSUM) ? checksum(file + payload_start + section->offset, section->size) : 0);
+        put_Uint64(entry + 16, payload_start + section->offset);
+        put_Uint64(entry + 24, section->size);
+    }
+
+    /* ================================================ */
+    /* ================== The header ================== */
+    /* ================================================ */
+
+    memcpy(file, SNAPSHOT_MAGIC, 4);
+    put_Uint16(file + 4, SNAPSHOT_VERSION);
+    put_Uint16(file + 6, 0);
+    put_Uint32(file + 8, (Uint32) writer->count);
+    put_Uint32(file + 12, checksum(file + HEADER_SIZE, writer->count * SECTION_SIZE));
+    put_Uint64(file + 16, size);
+
+    /* The buffer now belongs to the saver, so the writer starts again empty */
+    writer->payload = NULL;
+    writer->used = 0;
+    writer->allocated = 0;
+    writer->count = 0;
+
+    /* ======== */
+
+    /* The saver frees the buffer */
+    return Save_buffer_async(name, file, size, handle);
+}
+
+/* ================================================================ */
+
+int Snapshot_open(const char* name, Snapshot* snapshot, int verify) {
+
+    const Uint8* data;
+    int status;
+
+    /* ================ */
+
+    if ((name == NULL) || (snapshot == NULL)) {
+        return -1;
+    }
+
+    memset(snapshot, 0, sizeof(Snapshot));
+
+    if ((status = map_file(name, &snapshot->file, MAP_ADVICE_RANDOM)) != 0) {
+        /* `map_file` prints the error message here */
+        return -1;
+    }
+
+    data = (const Uint8*) snapshot->file.data;
+
+    /* ================================================ */
+    /* ============= Checking the header ============== */
+    /* ================================================ */
+
+    if ((snapshot->file.size < HEADER_SIZE) || (memcmp(data, SNAPSHOT_MAGIC, 4) != 0)) {
+        goto END;
+    }
+
+    if ((get_Uint16(data + 4) != SNAPSHOT_VERSION) || (get_Uint64(data + 16) != snapshot->file.size)) {
+        goto END;
+    }
+
+    snapshot->count = get_Uint32(data + 8);
+    snapshot->sections = data + HEADER_SIZE;
+
+    if ((snapshot->count > (snapshot->file.size - HEADER_SIZE) / SECTION_SIZE) ||
+        (checksum(snapshot->sections, (size_t) snapshot->count * SECTION_SIZE) != get_Uint32(data + 12))) {
+
+        goto END;
+    }
+
+    /* ================================================ */
+    /* ============ Checking every section ============ */
+    /* ================================================ */
+
+    for (Uint32 i = 0; i < snapshot->count; i++) {
+
+        const Uint8* entry = snapshot->sections + (size_t) i * SECTION_SIZE;
+
+        Uint64 offset = get_Uint64(entry + 16);
+        Uint64 size = get_Uint64(entry + 24);
+
+        if (!is_valid_section(snapshot, offset, size)) {
+            goto END;
+        }
+
+        if (verify && (get_Uint32(entry + 8) & SNAPSHOT_CHECKSUM) && (checksum(data + offset, (size_t) size) != get_Uint32(entry + 12))) {
+            goto END;
+        }
+    }
+
+    /* ======== */
+
+    return 0;
+
+    { END:
+        error(stderr, "in %s%s%s ([%s%s%s] is not a valid snapshot of version %d)\n", BLUE, __func__, WHITE, CYAN, name, WHITE, SNAPSHOT_VERSION);
+
+        Snapshot_close(snapshot);
+
+        return -1;
+    }
+}
+
+/* ================================================================ */
+
+void Snapshot_close(Snapshot* snapshot) {
+
+    if (snapshot == NULL) {
+        return ;
+    }
+
+    unmap_file(&snapshot->file);
+
+    snapshot->sections = NULL;
+    snapshot->count = 0;
+}
+
+/* ================================================================ */
+
+const void* Snapshot_find(const Snapshot* snapshot, Uint32 tag, Uint32 id, size_t* size) {
+
+    if ((snapshot == NULL) || (snapshot->sections == NULL)) {
+        return NULL;
+    }
+
+    for (Uint32 i = 0; i < snapshot->count; i++) {
+
+        const Uint8* entry = snapshot->sections + (size_t) i * SECTION_SIZE;
+
+        if ((get_Uint32(entry) == tag) && (get_Uint32(entry + 4) == id)) {
+
+            if (size != NULL) {
+                *size = (size_t) get_Uint64(entry + 24);
+            }
+
+            return (const Uint8*) snapshot->file.data + get_Uint64(entry + 16);
+        }
+    }
+
+    /* ======== */
+
+    return NULL;
+}
+
+/* ================================================================ */
+
+#undef HEADER_SIZE
+#undef SECTION_SIZE
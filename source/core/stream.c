@@ -0,0 +1,807 @@
+#include "../../sancho-panza.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+/* The size of the chunks `JSON_Stream_file` reads */
+#define CHUNK_SIZE 16384
+
+/* ================================================================ */
+
+/**
+ * What the stream expects next.
+ */
+enum {
+    EXPECT_VALUE,               /* any value */
+    EXPECT_VALUE_OR_END,        /* the first value of an array, or `]` */
+    EXPECT_KEY,                 /* a key, after `,` in an object */
+    EXPECT_KEY_OR_END,          /* the first key of an object, or `}` */
+    EXPECT_COLON,
+    EXPECT_COMMA_OR_END,        /* after a value in a container */
+    EXPECT_NOTHING,             /* after the top-level value, only whitespace */
+    IN_STRING,
+    IN_ESCAPE,                  /* after `\` */
+    IN_UNICODE,                 /* the hex digits of `\u` */
+    IN_SURROGATE_BACKSLASH,     /* the `\` of the low surrogate that must follow a high one */
+    IN_SURROGATE_U,             /* and its `u` */
+    IN_NUMBER,
+    IN_LITERAL,
+    FAILED,
+};
+
+/* Set on the state while reading a key rather than a string */
+#define KEY_FLAG 0x100
+
+#define is_whitespace(c) ((c) <= ' ')
+
+/* ================================================================ */
+/* ================== Static, internal functions ================== */
+/* ================================================================ */
+
+static int fail(JSON_Stream* stream, int code) {
+
+    stream->state = FAILED;
+    errno = code;
+
+    error(stderr, "%s at byte %s%zu%s [%s%s%s]\n", strerror(code), PURPLE, stream->offset, WHITE, BLUE, "JSON_Stream_feed", WHITE);
+
+    return -1;
+}
+
+/* ================================================================ */
+
+/**
+ * The `called` function turns the result of a callback into the result of the stream.
+ */
+static int called(JSON_Stream* stream, int result) {
+
+    return (result == 0) ? 0 : fail(stream, ECANCELED);
+}
+
+/* ================================================================ */
+
+static int is_object(const JSON_Stream* stream) {
+
+    return (stream->containers[(stream->depth - 1) / 8] >> ((stream->depth - 1) % 8)) & 1;
+}
+
+/* ================================================================ */
+
+/**
+ * The `value_done` function moves on once a value is complete.
+ */
+static void value_done(JSON_Stream* stream) {
+
+    stream->state = (stream->depth > 0) ? EXPECT_COMMA_OR_END : EXPECT_NOTHING;
+}
+
+/* ================================================================ */
+
+static int open_container(JSON_Stream* stream, int object) {
+
+    const JSON_Stream_Callbacks* callbacks = stream->callbacks;
+
+    /* ================ */
+
+    if (stream->depth >= JSON_STREAM_MAX_DEPTH) {
+        return fail(stream, EOVERFLOW);
+    }
+
+    if (object) {
+        stream->containers[stream->depth / 8] |= (Uint8) (1u << (stream->depth % 8));
+    }
+    else {
+        stream->containers[stream->depth / 8] &= (Uint8) ~(1u << (stream->depth % 8));
+    }
+
+    stream->depth++;
+    stream->state = object ? EXPECT_KEY_OR_END : EXPECT_VALUE_OR_END;
+
+    /* ======== */
+
+    if (object) {
+        return (callbacks->begin_object != NULL) ? called(stream, callbacks->begin_object(stream->user)) : 0;
+    }
+
+    return (callbacks->begin_array != NULL) ? called(stream, callbacks->begin_array(stream->user)) : 0;
+}
+
+/* ================================================================ */
+
+static int close_container(JSON_Stream* stream, int object) {
+
+    const JSON_Stream_Callbacks* callbacks = stream->callbacks;
+
+    /* ================ */
+
+    if ((stream->depth == 0) || (is_object(stream) != object)) {
+        return fail(stream, EILSEQ);
+    }
+
+    stream->depth--;
+    value_done(stream);
+
+    /* ======== */
+
+    if (object) {
+        return (callbacks->end_object != NULL) ? called(stream, callbacks->end_object(stream->user)) : 0;
+    }
+
+    return (callbacks->end_array != NULL) ? called(stream, callbacks->end_array(stream->user)) : 0;
+}
+
+/* ================================================================ */
+
+static int append(JSON_Stream* stream, const void* bytes, size_t count) {
+
+    /* One byte is kept for the terminator */
+    if (count >= JSON_STREAM_TOKEN_SIZE - stream->length) {
+        return fail(stream, EOVERFLOW);
+    }
+
+    memcpy(stream->token + stream->length, bytes, count);
+    stream->length += count;
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+/**
+ * The `append_code_point` function appends the UTF-8 encoding of a code point from a `\u` escape.
+ */
+static int append_code_point(JSON_Stream* stream, Uint32 code) {
+
+    Uint8 bytes[4];
+    size_t count;
+
+    /* ================ */
+
+    if (code < 0x80) {
+        bytes[0] = (Uint8) code;
+        count = 1;
+    }
+    else if (code < 0x800) {
+        bytes[0] = (Uint8) (0xC0 | (code >> 6));
+        bytes[1] = (Uint8) (0x80 | (code & 0x3F));
+        count = 2;
+    }
+    else if (code < 0x10000) {
+        bytes[0] = (Uint8) (0xE0 | (code >> 12));
+        bytes[1] = (Uint8) (0x80 | ((code >> 6) & 0x3F));
+        bytes[2] = (Uint8) (0x80 | (code & 0x3F));
+        count = 3;
+    }
+    else {
+        bytes[0] = (Uint8) (0xF0 | (code >> 18));
+        bytes[1] = (Uint8) (0x80 | ((code >> 12) & 0x3F));
+        bytes[2] = (Uint8) (0x80 | ((code >> 6) & 0x3F));
+        bytes[3] = (Uint8) (0x80 | (code & 0x3F));
+        count = 4;
+    }
+
+    /* ======== */
+
+    return append(stream, bytes, count);
+}
+
+/* ================================================================ */
+
+/**
+ * The `check_utf8` function checks a byte of a string against the UTF-8 sequence it starts or continues
+ * (RFC 3629: no overlong forms, surrogates or code points past U+10FFFF).
+ */
+static int check_utf8(JSON_Stream* stream, Uint8 c) {
+
+    if (stream->utf8_remaining > 0) {
+
+        if ((c < stream->utf8_low) || (c > stream->utf8_high)) {
+            return fail(stream, EILSEQ);
+        }
+
+        stream->utf8_remaining--;
+        stream->utf8_low = 0x80;
+        stream->utf8_high = 0xBF;
+    }
+    else if ((c >= 0xC2) && (c <= 0xDF)) {
+        stream->utf8_remaining = 1;
+    }
+    else if ((c & 0xF0) == 0xE0) {
+        stream->utf8_remaining = 2;
+        stream->utf8_low = (c == 0xE0) ? 0xA0 : 0x80;
+        stream->utf8_high = (c == 0xED) ? 0x9F : 0xBF;
+    }
+    else if ((c >= 0xF0) && (c <= 0xF4)) {
+        stream->utf8_remaining = 3;
+        stream->utf8_low = (c == 0xF0) ? 0x90 : 0x80;
+        stream->utf8_high = (c == 0xF4) ? 0x8F : 0xBF;
+    }
+    else {
+        return fail(stream, EILSEQ);
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+/**
+ * The `end_string` function hands a complete key or string to its callback.
+ */
+static int end_string(JSON_Stream* stream) {
+
+    const JSON_Stream_Callbacks* callbacks = stream->callbacks;
+    int key = stream->state & KEY_FLAG;
+
+    /* ================ */
+
+    stream->token[stream->length] = '\0';
+
+    if (key) {
+        stream->state = EXPECT_COLON;
+
+        return (callbacks->key != NULL) ? called(stream, callbacks->key(stream->user, stream->token, stream->length)) : 0;
+    }
+
+    value_done(stream);
+
+    /* ======== */
+
+    return (callbacks->string != NULL) ? called(stream, callbacks->string(stream->user, stream->token, stream->length)) : 0;
+}
+
+/* ================================================================ */
+
+/**
+ * The `end_number` function converts the number read so far, which ends at the byte that is not part of it.
+ */
+static int end_number(JSON_Stream* stream) {
+
+    double number;
+
+    /* ================ */
+
+    if (cJSON_ReadNumber(stream->token, stream->length, &number) != stream->length) {
+        return fail(stream, EILSEQ);
+    }
+
+    value_done(stream);
+
+    /* ======== */
+
+    return (stream->callbacks->number != NULL) ? called(stream, stream->callbacks->number(stream->user, number)) : 0;
+}
+
+/* ================================================================ */
+
+static int end_literal(JSON_Stream* stream) {
+
+    const JSON_Stream_Callbacks* callbacks = stream->callbacks;
+
+    /* ================ */
+
+    value_done(stream);
+
+    if (stream->literal[0] == 'n') {
+        return (callbacks->null != NULL) ? called(stream, callbacks->null(stream->user)) : 0;
+    }
+
+    /* ======== */
+
+    return (callbacks->boolean != NULL) ? called(stream, callbacks->boolean(stream->user, stream->literal[0] == 't')) : 0;
+}
+
+/* ================================================================ */
+
+/**
+ * The `begin_value` function starts the value whose first byte is `c`.
+ */
+static int begin_value(JSON_Stream* stream, Uint8 c) {
+
+    stream->length = 0;
+
+    /* ================ */
+
+    switch (c) {
+
+        case '{':
+            return open_container(stream, 1);
+
+        case '[':
+            return open_container(stream, 0);
+
+        case '"':
+            stream->state = IN_STRING;
+            stream->surrogate = 0;
+            stream->utf8_remaining = 0;
+
+            return 0;
+
+        case 't':
+            stream->literal = "true";
+            break ;
+
+        case 'f':
+            stream->literal = "false";
+            break ;
+
+        case 'n':
+            stream->literal = "null";
+            break ;
+
+        default:
+            if ((c == '-') || ((c >= '0') && (c <= '9'))) {
+                stream->state = IN_NUMBER;
+                stream->token[stream->length++] = (char) c;
+
+                return 0;
+            }
+
+            return fail(stream, EILSEQ);
+    }
+
+    stream->state = IN_LITERAL;
+    stream->literal_length = 1;
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+/**
+ * The `read_string` function reads the bytes of a string from `data[*i]` on, copying the runs of plain characters at once.
+ */
+static int read_string(JSON_Stream* stream, const Uint8* data, size_t size, size_t* i) {
+
+    size_t start = *i;
+    size_t end = *i;
+
+    Uint8 c;
+    int status = 0;
+
+    /* ================ */
+
+    while ((end < size) && (stream->utf8_remaining == 0)) {
+
+        c = data[end];
+
+        if ((c < 0x20) || (c == '"') || (c == '\\') || (c >= 0x80)) {
+            break ;
+        }
+
+        end++;
+    }
+
+    if ((end > start) && (append(stream, data + start, end - start) != 0)) {
+        return -1;
+    }
+
+    stream->offset += end - start;
+    *i = end;
+
+    if (end == size) {
+        return 0;
+    }
+
+    c = data[end];
+
+    /* ================================================ */
+    /* ======== The byte that ends the run ============ */
+    /* ================================================ */
+
+    if ((stream->utf8_remaining == 0) && (c == '"')) {
+        status = end_string(stream);
+    }
+    else if ((stream->utf8_remaining == 0) && (c == '\\')) {
+        stream->state = IN_ESCAPE | (stream->state & KEY_FLAG);
+    }
+    else if ((stream->utf8_remaining == 0) && (c < 0x20)) {
+        status = fail(stream, EILSEQ);
+    }
+    else if ((status = check_utf8(stream, c)) == 0) {
+        status = append(stream, &c, 1);
+    }
+
+    if (status == 0) {
+        (*i)++;
+        stream->offset++;
+    }
+
+    /* ======== */
+
+    return status;
+}
+
+/* ================================================================ */
+
+static int read_escape(JSON_Stream* stream, Uint8 c) {
+
+    static const char escapes[] = "\"\"\\\\//b\bf\fn\nr\rt\t";
+
+    int key = stream->state & KEY_FLAG;
+
+    /* ================ */
+
+    if (c == 'u') {
+        stream->state = IN_UNICODE | key;
+        stream->code = 0;
+        stream->hex_digits = 0;
+
+        return 0;
+    }
+
+    for (size_t i = 0; escapes[i] != '\0'; i += 2) {
+
+        if (escapes[i] == (char) c) {
+            stream->state = IN_STRING | key;
+
+            return append(stream, &escapes[i + 1], 1);
+        }
+    }
+
+    /* ======== */
+
+    return fail(stream, EILSEQ);
+}
+
+/* ================================================================ */
+
+static int read_unicode(JSON_Stream* stream, Uint8 c) {
+
+    int key = stream->state & KEY_FLAG;
+    Uint32 code;
+
+    /* ================ */
+
+    if ((c >= '0') && (c <= '9')) {
+        stream->code = (stream->code << 4) | (Uint32) (c - '0');
+    }
+    else if (((c | 0x20) >= 'a') && ((c | 0x20) <= 'f')) {
+        stream->code = (stream->code << 4) | (Uint32) ((c | 0x20) - 'a' + 10);
+    }
+    else {
+        return fail(stream, EILSEQ);
+    }
+
+    if (++stream->hex_digits < 4) {
+        return 0;
+    }
+
+    code = stream->code;
+
+    /* ================================================ */
+    /* ============== UTF-16 surrogates =============== */
+    /* ================================================ */
+
+    if ((code >= 0xD800) && (code <= 0xDBFF)) {
+
+        if (stream->surrogate != 0) {
+            return fail(stream, EILSEQ);
+        }
+
+        stream->surrogate = code;
+        stream->state = IN_SURROGATE_BACKSLASH | key;
+
+        return 0;
+    }
+
+    if ((code >= 0xDC00) && (code <= 0xDFFF)) {
+
+        if (stream->surrogate == 0) {
+            return fail(stream, EILSEQ);
+        }
+
+        code = 0x10000 + (((stream->surrogate & 0x3FF) << 10) | (code & 0x3FF));
+        stream->surrogate = 0;
+    }
+    else if (stream->surrogate != 0) {
+        return fail(stream, EILSEQ);
+    }
+
+    stream->state = IN_STRING | key;
+
+    /* ======== */
+
+    return append_code_point(stream, code);
+}
+
+/* ================================================================ */
+
+/**
+ * The `read_byte` function handles one byte outside of the runs of plain string characters.
+ *
+ * @return `0` if the byte was used, `1` if it ended a number and must be read again in the new state, `-1` on error.
+ */
+static int read_byte(JSON_Stream* stream, Uint8 c) {
+
+    int state = stream->state & ~KEY_FLAG;
+
+    /* ================ */
+
+    switch (state) {
+
+        case EXPECT_VALUE:
+        case EXPECT_VALUE_OR_END:
+            if (is_whitespace(c)) {
+                return 0;
+            }
+
+            if ((c == ']') && (state == EXPECT_VALUE_OR_END)) {
+                return close_container(stream, 0);
+            }
+
+            return begin_value(stream, c);
+
+        case EXPECT_KEY:
+        case EXPECT_KEY_OR_END:
+            if (is_whitespace(c)) {
+                return 0;
+            }
+
+            if ((c == '}') && (state == EXPECT_KEY_OR_END)) {
+                return close_container(stream, 1);
+            }
+
+            if (c != '"') {
+                return fail(stream, EILSEQ);
+            }
+
+            stream->state = IN_STRING | KEY_FLAG;
+            stream->length = 0;
+            stream->surrogate = 0;
+            stream->utf8_remaining = 0;
+
+            return 0;
+
+        case EXPECT_COLON:
+            if (is_whitespace(c)) {
+                return 0;
+            }
+
+            if (c != ':') {
+                return fail(stream, EILSEQ);
+            }
+
+            stream->state = EXPECT_VALUE;
+
+            return 0;
+
+        case EXPECT_COMMA_OR_END:
+            if (is_whitespace(c)) {
+                return 0;
+            }
+
+            if (c == ',') {
+                stream->state = is_object(stream) ? EXPECT_KEY : EXPECT_VALUE;
+
+                return 0;
+            }
+
+            if ((c == '}') || (c == ']')) {
+                return close_container(stream, c == '}');
+            }
+
+            return fail(stream, EILSEQ);
+
+        case EXPECT_NOTHING:
+            if (is_whitespace(c)) {
+                return 0;
+            }
+
+            if (stream->flags & JSON_STREAM_SEQUENCE) {
+                return begin_value(stream, c);
+            }
+
+            return fail(stream, EILSEQ);
+
+        case IN_ESCAPE:
+            return read_escape(stream, c);
+
+        case IN_UNICODE:
+            return read_unicode(stream, c);
+
+        case IN_SURROGATE_BACKSLASH:
+            if (c != '\\') {
+                return fail(stream, EILSEQ);
+            }
+
+            stream->state = IN_SURROGATE_U | (stream->state & KEY_FLAG);
+
+            return 0;
+
+        case IN_SURROGATE_U:
+            if (c != 'u') {
+                return fail(stream, EILSEQ);
+            }
+
+            stream->state = IN_UNICODE | (stream->state & KEY_FLAG);
+            stream->code = 0;
+            stream->hex_digits = 0;
+
+            return 0;
+
+        case IN_NUMBER:
+            if (((c >= '0') && (c <= '9')) || (c == '.') || (c == 'e') || (c == 'E') || (c == '+') || (c == '-')) {
+                return append(stream, &c, 1);
+            }
+
+            return (end_number(stream) == 0) ? 1 : -1;
+
+        case IN_LITERAL:
+            if ((char) c != stream->literal[stream->literal_length]) {
+                return fail(stream, EILSEQ);
+            }
+
+            if (stream->literal[++stream->literal_length] == '\0') {
+                return end_literal(stream);
+            }
+
+            return 0;
+    }
+
+    /* ======== */
+
+    return -1;
+}
+
+/* ================================================================ */
+/* ============== Definitions of external functions =============== */
+/* ================================================================ */
+
+void JSON_Stream_init(JSON_Stream* stream, const JSON_Stream_Callbacks* callbacks, void* user, int flags) {
+
+    static const JSON_Stream_Callbacks none;
+
+    /* ================ */
+
+    stream->callbacks = (callbacks != NULL) ? callbacks : &none;
+    stream->user = user;
+    stream->flags = flags;
+
+    stream->offset = 0;
+    stream->state = EXPECT_VALUE;
+    stream->depth = 0;
+    stream->length = 0;
+
+    stream->surrogate = 0;
+    stream->utf8_remaining = 0;
+    stream->utf8_low = 0x80;
+    stream->utf8_high = 0xBF;
+    stream->literal = NULL;
+}
+
+/* ================================================================ */
+
+int JSON_Stream_feed(JSON_Stream* stream, const void* data, size_t size) {
+
+    const Uint8* bytes = data;
+    size_t i = 0;
+
+    int status;
+
+    /* ================ */
+
+    if ((stream == NULL) || ((data == NULL) && (size > 0))) {
+        return -1;
+    }
+
+    while (i < size) {
+
+        if (stream->state == FAILED) {
+            return -1;
+        }
+
+        if ((stream->state & ~KEY_FLAG) == IN_STRING) {
+
+            if (read_string(stream, bytes, size, &i) != 0) {
+                return -1;
+            }
+
+            continue ;
+        }
+
+        if ((status = read_byte(stream, bytes[i])) < 0) {
+            return -1;
+        }
+
+        /* The byte that ended a number belongs to what follows it */
+        if (status == 0) {
+            i++;
+            stream->offset++;
+        }
+    }
+
+    /* ======== */
+
+    return (stream->state == FAILED) ? -1 : 0;
+}
+
+/* ================================================================ */
+
+int JSON_Stream_finish(JSON_Stream* stream) {
+
+    if ((stream == NULL) || (stream->state == FAILED)) {
+        return -1;
+    }
+
+    if ((stream->state == IN_NUMBER) && (end_number(stream) != 0)) {
+        return -1;
+    }
+
+    /* An empty sequence is still a sequence */
+    if ((stream->state == EXPECT_NOTHING) || ((stream->flags & JSON_STREAM_SEQUENCE) && (stream->state == EXPECT_VALUE) && (stream->depth == 0))) {
+        return 0;
+    }
+
+    /* ======== */
+
+    return fail(stream, EILSEQ);
+}
+
+/* ================================================================ */
+
+int JSON_Stream_file(const char* name, const JSON_Stream_Callbacks* callbacks, void* user, int flags) {
+
+    JSON_Stream stream;
+    Uint8 chunk[CHUNK_SIZE];
+
+    ssize_t bytes_read;
+    int fd;
+
+    /* ================ */
+
+    if (name == NULL) {
+        return -1;
+    }
+
+    if ((fd = open(name, O_RDONLY)) < 0) {
+
+        error(stderr, "%s (%s%s%s)\n", strerror(errno), CYAN, name, WHITE);
+
+        return -1;
+    }
+
+    JSON_Stream_init(&stream, callbacks, user, flags);
+
+    while ((bytes_read = read(fd, chunk, sizeof(chunk))) != 0) {
+
+        if (bytes_read < 0) {
+
+            if (errno == EINTR) {
+                continue ;
+            }
+
+            error(stderr, "%s (%s%s%s)\n", strerror(errno), CYAN, name, WHITE);
+
+            goto END;
+        }
+
+        if (JSON_Stream_feed(&stream, chunk, (size_t) bytes_read) != 0) {
+            goto END;
+        }
+    }
+
+    close(fd);
+
+    /* ======== */
+
+    return JSON_Stream_finish(&stream);
+
+    { END:
+        close(fd);
+
+        return -1;
+    }
+}
+
+/* ================================================================ */
+
+#undef CHUNK_SIZE
+#undef KEY_FLAG
+#undef is_whitespace
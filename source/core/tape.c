@@ -0,0 +1,1023 @@
+#include "../../sancho-panza.h"
+
+#include <math.h>
+
+/* The number of characters after the error location `JSON_Tape_parse` prints */
+#define ERROR_CONTEXT 32
+
+/* The block size of the arena of decoded strings */
+#define STRING_BLOCK_SIZE 4096
+
+/**
+ * The layout of a tape word: the type in the top 8 bits, and
+ *
+ *     `{` `[`  the index of the word after the matching end (32 bits), and the number of elements (24 bits, saturated) above it
+ *     `}` `]`  the index of the matching start
+ *     `:` `"`  a key or a string: the position of its first character in the input, then a second word with its raw length
+ *              (48 bits) and `ESCAPED` if it has escape sequences
+ *     `d`      a number: the position in the input, then a second word with the bits of the double
+ *     `t` `f` `n`
+ *
+ * The first word of a tape is the root, which holds the index of the word after the last one.
+ */
+#define TYPE(word) ((char) ((word) >> 56))
+#define PAYLOAD(word) ((word) & 0x00FFFFFFFFFFFFFFULL)
+#define WORD(type, payload) (((Uint64) (Uint8) (type) << 56) | (Uint64) (payload))
+
+#define SKIP(word) ((size_t) ((word) & 0xFFFFFFFFULL))
+#define COUNT(word) ((size_t) (((word) >> 32) & 0xFFFFFF))
+#define MAX_COUNT 0xFFFFFFu
+
+#define ESCAPED 0x8000000000000000ULL
+#define LENGTH(word) ((size_t) ((word) & 0xFFFFFFFFFFFFULL))
+
+#define is_whitespace(c) ((unsigned char) (c) <= ' ')
+
+/* ================================================================ */
+
+/**
+ * A decoded string, in the table the tape looks them up by the index of their word.
+ */
+struct decoded_string {
+
+    size_t index;
+    const char* string;
+};
+
+/* ================================================================ */
+
+struct json_tape {
+
+    const char* data;
+    size_t size;
+
+    Uint64* words;
+    size_t count;
+    size_t capacity;
+
+    /* Set by `JSON_Tape_parse_file` */
+    Mapped_File file;
+    int owns_file;
+
+    /* The strings decoded so far, and their index (open addressing, at most half full) */
+    Arena strings;
+    struct decoded_string* decoded;
+    size_t decoded_count;
+    size_t decoded_capacity;
+    SDL_SpinLock lock;
+};
+
+/* ================================================================ */
+/* ================== Static, internal functions ================== */
+/* ================================================================ */
+
+static int push(JSON_Tape* tape, Uint64 word) {
+
+    Uint64* larger;
+    size_t capacity;
+
+    /* ================ */
+
+    if (tape->count == tape->capacity) {
+
+        capacity = tape->capacity * 2;
+
+        if ((capacity > 0xFFFFFFFFu) || ((larger = realloc(tape->words, capacity * sizeof(Uint64))) == NULL)) {
+            return -1;
+        }
+
+        tape->words = larger;
+        tape->capacity = capacity;
+    }
+
+    tape->words[tape->count++] = word;
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+/**
+ * The `find_quote` function finds the quote that ends a string starting at `position`, and tells whether the string has escape sequences.
+ *
+ * @return The position of the quote, or `size` if the string does not end.
+ */
+static size_t find_quote(const char* data, size_t size, size_t position, int* escaped) {
+
+    const char* begin = data + position;
+    const char* quote;
+    size_t backslashes;
+
+    /* ================ */
+
+    while ((quote = memchr(data + position, '"', size - position)) != NULL) {
+
+        /* A quote is escaped by an odd number of backslashes before it */
+        for (backslashes = 0; (quote - backslashes > begin) && (quote[-(ptrdiff_t) backslashes - 1] == '\\'); backslashes++) {
+        }
+
+        if (backslashes % 2 == 0) {
+            *escaped = (memchr(begin, '\\', (size_t) (quote - begin)) != NULL);
+
+            return (size_t) (quote - data);
+        }
+
+        position = (size_t) (quote - data) + 1;
+    }
+
+    /* ======== */
+
+    return size;
+}
+
+/* ================================================================ */
+
+/**
+ * The `parse` function fills the tape in a single pass over the text, keeping the open containers on a stack.
+ *
+ * @return `0` on success. `-1` with the position of the error on failure.
+ */
+static int parse(JSON_Tape* tape, size_t* position) {
+
+    const char* data = tape->data;
+    size_t size = tape->size;
+
+    size_t stack[CJSON_NESTING_LIMIT];
+    size_t counts[CJSON_NESTING_LIMIT];
+    size_t depth = 0;
+
+    size_t i = *position;
+    size_t end;
+    double number;
+    int escaped;
+    int key;
+
+    /* ================ */
+
+    if (push(tape, WORD('r', 0)) != 0) {
+        return -1;
+    }
+
+    /* ================================================ */
+    /* ================= A value ====================== */
+    /* ================================================ */
+
+    VALUE:
+        while ((i < size) && is_whitespace(data[i])) {
+            i++;
+        }
+
+        if (i >= size) {
+            goto END;
+        }
+
+        if (depth > 0) {
+            counts[depth - 1]++;
+        }
+
+        switch (data[i]) {
+
+            case '{':
+            case '[':
+                if (depth == CJSON_NESTING_LIMIT) {
+                    goto END;
+                }
+
+                stack[depth] = tape->count;
+                counts[depth] = 0;
+                depth++;
+
+                if (push(tape, WORD(data[i], 0)) != 0) {
+                    goto END;
+                }
+
+                i++;
+
+                while ((i < size) && is_whitespace(data[i])) {
+                    i++;
+                }
+
+                /* An empty container */
+                if ((i < size) && (data[i] == ((TYPE(tape->words[stack[depth - 1]]) == '{') ? '}' : ']'))) {
+                    goto CLOSE;
+                }
+
+                if (TYPE(tape->words[stack[depth - 1]]) == '{') {
+                    goto KEY;
+                }
+
+                goto VALUE;
+
+            case '"':
+                key = 0;
+
+                goto STRING;
+
+            case 't':
+            case 'f':
+            case 'n': {
+
+                const char* literal = (data[i] == 't') ? "true" : ((data[i] == 'f') ? "false" : "null");
+                size_t length = strlen(literal);
+
+                if ((size - i < length) || (memcmp(data + i, literal, length) != 0)) {
+                    goto END;
+                }
+
+                if (push(tape, WORD(data[i], 0)) != 0) {
+                    goto END;
+                }
+
+                i += length;
+
+                goto AFTER_VALUE;
+            }
+
+            default:
+                if ((data[i] != '-') && ((data[i] < '0') || (data[i] > '9'))) {
+                    goto END;
+                }
+
+                if ((end = cJSON_ReadNumber(data + i, size - i, &number)) == 0) {
+                    goto END;
+                }
+
+                if ((push(tape, WORD('d', i)) != 0) || (push(tape, 0) != 0)) {
+                    goto END;
+                }
+
+                memcpy(&tape->words[tape->count - 1], &number, sizeof(number));
+                i += end;
+
+                goto AFTER_VALUE;
+        }
+
+    /* ================================================ */
+    /* ========== A key, its colon, its value ========= */
+    /* ================================================ */
+
+    KEY:
+        while ((i < size) && is_whitespace(data[i])) {
+            i++;
+        }
+
+        if ((i >= size) || (data[i] != '"')) {
+            goto END;
+        }
+
+        key = 1;
+
+    STRING:
+        end = find_quote(data, size, i + 1, &escaped);
+
+        if (end >= size) {
+            goto END;
+        }
+
+        if ((push(tape, WORD(key ? ':' : '"', i + 1)) != 0) || (push(tape, (Uint64) (end - i - 1) | (escaped ? ESCAPED : 0)) != 0)) {
+            goto END;
+        }
+
+        i = end + 1;
+
+        if (!key) {
+            goto AFTER_VALUE;
+        }
+
+        while ((i < size) && is_whitespace(data[i])) {
+            i++;
+        }
+
+        if ((i >= size) || (data[i] != ':')) {
+            goto END;
+        }
+
+        i++;
+
+        goto VALUE;
+
+    /* ================================================ */
+    /* ====== A comma, or the end of a container ====== */
+    /* ================================================ */
+
+    AFTER_VALUE:
+        while ((i < size) && is_whitespace(data[i])) {
+            i++;
+        }
+
+        if (depth == 0) {
+            goto DONE;
+        }
+
+        if (i >= size) {
+            goto END;
+        }
+
+        if (data[i] == ',') {
+            i++;
+
+            if (TYPE(tape->words[stack[depth - 1]]) == '{') {
+                goto KEY;
+            }
+
+            goto VALUE;
+        }
+
+    CLOSE:
+        if (data[i] != ((TYPE(tape->words[stack[depth - 1]]) == '{') ? '}' : ']')) {
+            goto END;
+        }
+
+        depth--;
+
+        if (push(tape, WORD(data[i], stack[depth])) != 0) {
+            goto END;
+        }
+
+        tape->words[stack[depth]] |= (Uint64) tape->count | ((Uint64) ((counts[depth] < MAX_COUNT) ? counts[depth] : MAX_COUNT) << 32);
+        i++;
+
+        goto AFTER_VALUE;
+
+    DONE:
+        tape->words[0] |= (Uint64) tape->count;
+        *position = i;
+
+    /* ======== */
+
+    return (i == size) ? 0 : -1;
+
+    { END:
+        *position = i;
+
+        return -1;
+    }
+}
+
+/* ================================================================ */
+
+/**
+ * The `skip` function returns the index of the word after a value.
+ */
+static size_t skip(const JSON_Tape* tape, size_t index) {
+
+    Uint64 word = tape->words[index];
+
+    /* ================ */
+
+    switch (TYPE(word)) {
+
+        case '{':
+        case '[':
+            return SKIP(word);
+
+        case '"':
+        case ':':
+        case 'd':
+            return index + 2;
+    }
+
+    /* ======== */
+
+    return index + 1;
+}
+
+/* ================================================================ */
+
+/**
+ * The `element` function turns the index of the first word of an element, or of a member, into the value: the key of a member is skipped.
+ */
+static JSON_Value element(JSON_Tape* tape, size_t index) {
+
+    JSON_Value value = {tape, 0};
+    char type = TYPE(tape->words[index]);
+
+    /* ================ */
+
+    if ((type == '}') || (type == ']')) {
+        return value;
+    }
+
+    value.index = (type == ':') ? index + 2 : index;
+
+    /* ======== */
+
+    return value;
+}
+
+/* ================================================================ */
+
+/**
+ * The `decode` function decodes the key or string at an index with the parser of cJSON, which unescapes and checks it.
+ *
+ * @return A copy allocated with `malloc`, or `NULL` if the string is invalid.
+ */
+static char* decode(const JSON_Tape* tape, size_t index) {
+
+    size_t start = (size_t) PAYLOAD(tape->words[index]);
+    size_t length = LENGTH(tape->words[index + 1]);
+
+    cJSON* item;
+    char* copy = NULL;
+
+    /* ================ */
+
+    /* The quotes are part of the literal */
+    if ((item = cJSON_ParseWithLength(tape->data + start - 1, length + 2)) == NULL) {
+        return NULL;
+    }
+
+    if (cJSON_IsString(item)) {
+        copy = strdup(item->valuestring);
+    }
+
+    cJSON_Delete(item);
+
+    /* ======== */
+
+    return copy;
+}
+
+/* ================================================================ */
+
+/**
+ * The `key_equals` function compares a key of the tape with a string, where the key is in the input if it has no escape sequences.
+ */
+static int key_equals(const JSON_Tape* tape, size_t index, const char* key, size_t key_length, int case_sensitive) {
+
+    const char* raw = tape->data + PAYLOAD(tape->words[index]);
+    size_t length = LENGTH(tape->words[index + 1]);
+
+    char* decoded;
+    int equal;
+
+    /* ================ */
+
+    if (!(tape->words[index + 1] & ESCAPED)) {
+
+        if (length != key_length) {
+            return 0;
+        }
+
+        return case_sensitive ? (memcmp(raw, key, length) == 0) : (SDL_strncasecmp(raw, key, length) == 0);
+    }
+
+    /* An escaped key is never shorter than what it decodes to */
+    if ((length < key_length) || ((decoded = decode(tape, index)) == NULL)) {
+        return 0;
+    }
+
+    equal = case_sensitive ? (strcmp(decoded, key) == 0) : (SDL_strcasecmp(decoded, key) == 0);
+
+    free(decoded);
+
+    /* ======== */
+
+    return equal;
+}
+
+/* ================================================================ */
+
+static JSON_Value get_object_item(JSON_Value object, const char* key, int case_sensitive) {
+
+    JSON_Value missing = {object.tape, 0};
+    size_t key_length;
+    size_t end;
+
+    /* ================ */
+
+    if (!JSON_Tape_is(object, OBJECT) || (key == NULL)) {
+        return missing;
+    }
+
+    key_length = strlen(key);
+    end = SKIP(object.tape->words[object.index]) - 1;
+
+    for (size_t i = object.index + 1; i < end; i = skip(object.tape, i + 2)) {
+
+        if (key_equals(object.tape, i, key, key_length, case_sensitive)) {
+            return element(object.tape, i);
+        }
+    }
+
+    /* ======== */
+
+    return missing;
+}
+
+/* ================================================================ */
+
+/**
+ * The `cached_string` function returns the decoded copy of the key or string at an index, decoding it the first time.
+ */
+static const char* cached_string(JSON_Tape* tape, size_t index) {
+
+    struct decoded_string* table;
+    struct decoded_string* slot = NULL;
+
+    const char* string = NULL;
+    char* decoded;
+    size_t capacity;
+    size_t length;
+
+    /* ================ */
+
+    SDL_AtomicLock(&tape->lock);
+
+    /* ================================================ */
+    /* ============= Decoded before? ================== */
+    /* ================================================ */
+
+    if (tape->decoded_capacity > 0) {
+
+        for (size_t h = (index * 0x9E3779B97F4A7C15ULL) & (tape->decoded_capacity - 1); tape->decoded[h].string != NULL; h = (h + 1) & (tape->decoded_capacity - 1)) {
+
+            if (tape->decoded[h].index == index) {
+                string = tape->decoded[h].string;
+
+                goto END;
+            }
+        }
+    }
+
+    /* ================================================ */
+    /* ======= Growing the table, at most half full === */
+    /* ================================================ */
+
+    if ((tape->decoded_count + 1) * 2 > tape->decoded_capacity) {
+
+        capacity = (tape->decoded_capacity == 0) ? 64 : tape->decoded_capacity * 2;
+
+        if ((table = calloc(capacity, sizeof(struct decoded_string))) == NULL) {
+            goto END;
+        }
+
+        for (size_t i = 0; i < tape->decoded_capacity; i++) {
+
+            if (tape->decoded[i].string != NULL) {
+
+                size_t h = (tape->decoded[i].index * 0x9E3779B97F4A7C15ULL) & (capacity - 1);
+
+                while (table[h].string != NULL) {
+                    h = (h + 1) & (capacity - 1);
+                }
+
+                table[h] = tape->decoded[i];
+            }
+        }
+
+        free(tape->decoded);
+
+        tape->decoded = table;
+        tape->decoded_capacity = capacity;
+    }
+
+    /* ================================================ */
+    /* ====== Decoding, into the arena of the tape ==== */
+    /* ================================================ */
+
+    if ((decoded = decode(tape, index)) == NULL) {
+        goto END;
+    }
+
+    length = strlen(decoded) + 1;
+
+    if ((string = Arena_alloc(&tape->strings, length, 1)) != NULL) {
+
+        memcpy((char*) string, decoded, length);
+
+        for (slot = &tape->decoded[(index * 0x9E3779B97F4A7C15ULL) & (tape->decoded_capacity - 1)]; slot->string != NULL; ) {
+            slot = (slot == &tape->decoded[tape->decoded_capacity - 1]) ? tape->decoded : slot + 1;
+        }
+
+        slot->index = index;
+        slot->string = string;
+        tape->decoded_count++;
+    }
+
+    free(decoded);
+
+    /* ======== */
+
+    { END:
+        SDL_AtomicUnlock(&tape->lock);
+
+        return string;
+    }
+}
+
+/* ================================================================ */
+
+/**
+ * The `entity_name` function returns the name of a type, as the messages of `extract_JSON_data` print it.
+ */
+static const char* entity_name(JSON_Entity type) {
+
+    switch (type) {
+
+        case ARRAY:
+            return "array";
+
+        case BOOLEAN:
+            return "boolean";
+
+        case OBJECT:
+            return "object";
+
+        case NUMBER:
+            return "number";
+
+        case STRING:
+            return "string";
+    }
+
+    /* ======== */
+
+    return "unknown";
+}
+
+/* ================================================================ */
+/* ============== Definitions of external functions =============== */
+/* ================================================================ */
+
+int JSON_Tape_parse(const char* data, size_t size, JSON_Tape** tape) {
+
+    size_t position = 0;
+    size_t remaining;
+
+    /* ================ */
+
+    if ((data == NULL) || (tape == NULL)) {
+        return -1;
+    }
+
+    if ((*tape = calloc(1, sizeof(JSON_Tape))) == NULL) {
+        return -1;
+    }
+
+    (*tape)->data = data;
+    (*tape)->size = size;
+
+    /* Most documents need about one word per 4 bytes */
+    (*tape)->capacity = size / 4 + 16;
+
+    if (((*tape)->words = malloc((*tape)->capacity * sizeof(Uint64))) == NULL) {
+        goto END;
+    }
+
+    Arena_init(&(*tape)->strings, STRING_BLOCK_SIZE);
+
+    /* ================================================ */
+    /* ============= Skipping a UTF-8 BOM ============= */
+    /* ================================================ */
+
+    if ((size >= 3) && (memcmp(data, "\xEF\xBB\xBF", 3) == 0)) {
+        position = 3;
+    }
+
+    if (parse(*tape, &position) != 0) {
+
+        remaining = size - position;
+
+        error(stderr, "before %s%.*s%s (byte %zu)\n", PURPLE, (int) ((remaining < ERROR_CONTEXT) ? remaining : ERROR_CONTEXT), data + position, WHITE, position);
+
+        goto END;
+    }
+
+    /* ======== */
+
+    return 0;
+
+    { END:
+        JSON_Tape_destroy(tape);
+
+        return -1;
+    }
+}
+
+/* ================================================================ */
+
+int JSON_Tape_parse_file(const char* name, JSON_Tape** tape) {
+
+    Mapped_File file;
+
+    /* ================ */
+
+    if ((name == NULL) || (tape == NULL)) {
+        return -1;
+    }
+
+    if (map_file(name, &file, MAP_ADVICE_SEQUENTIAL) != 0) {
+
+        error(stderr, "%s (%s%s%s)\n", strerror(errno), CYAN, name, WHITE);
+
+        return -1;
+    }
+
+    if (JSON_Tape_parse(file.data, file.size, tape) != 0) {
+        unmap_file(&file);
+
+        return -1;
+    }
+
+    (*tape)->file = file;
+    (*tape)->owns_file = 1;
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+void JSON_Tape_destroy(JSON_Tape** tape) {
+
+    if ((tape == NULL) || (*tape == NULL)) {
+        return ;
+    }
+
+    if ((*tape)->owns_file) {
+        unmap_file(&(*tape)->file);
+    }
+
+    Arena_release(&(*tape)->strings);
+
+    free((*tape)->decoded);
+    free((*tape)->words);
+    free(*tape);
+
+    *tape = NULL;
+}
+
+/* ================================================================ */
+
+JSON_Value JSON_Tape_root(JSON_Tape* tape) {
+
+    JSON_Value value = {tape, (tape != NULL) ? 1 : 0};
+
+    /* ======== */
+
+    return value;
+}
+
+/* ================================================================ */
+
+int JSON_Tape_exists(JSON_Value value) {
+
+    return (value.tape != NULL) && (value.index != 0);
+}
+
+/* ================================================================ */
+
+int JSON_Tape_is(JSON_Value value, JSON_Entity type) {
+
+    char word_type;
+
+    /* ================ */
+
+    if (!JSON_Tape_exists(value)) {
+        return 0;
+    }
+
+    word_type = TYPE(value.tape->words[value.index]);
+
+    switch (type) {
+
+        case ARRAY:
+            return word_type == '[';
+
+        case BOOLEAN:
+            return (word_type == 't') || (word_type == 'f');
+
+        case OBJECT:
+            return word_type == '{';
+
+        case NUMBER:
+            return word_type == 'd';
+
+        case STRING:
+            return word_type == '"';
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+int JSON_Tape_is_null(JSON_Value value) {
+
+    return JSON_Tape_exists(value) && (TYPE(value.tape->words[value.index]) == 'n');
+}
+
+/* ================================================================ */
+
+int JSON_Tape_is_true(JSON_Value value) {
+
+    return JSON_Tape_exists(value) && (TYPE(value.tape->words[value.index]) == 't');
+}
+
+/* ================================================================ */
+
+JSON_Value JSON_Tape_get_object_item(JSON_Value object, const char* key) {
+
+    return get_object_item(object, key, 0);
+}
+
+/* ================================================================ */
+
+JSON_Value JSON_Tape_get_object_item_case_sensitive(JSON_Value object, const char* key) {
+
+    return get_object_item(object, key, 1);
+}
+
+/* ================================================================ */
+
+int JSON_Tape_get_array_size(JSON_Value array) {
+
+    Uint64 word;
+    size_t count = 0;
+
+    /* ================ */
+
+    if (!JSON_Tape_is(array, ARRAY) && !JSON_Tape_is(array, OBJECT)) {
+        return 0;
+    }
+
+    word = array.tape->words[array.index];
+
+    /* Only huge containers have to be counted */
+    if (COUNT(word) < MAX_COUNT) {
+        return (int) COUNT(word);
+    }
+
+    for (JSON_Value item = JSON_Tape_child(array); JSON_Tape_exists(item); item = JSON_Tape_next(item)) {
+        count++;
+    }
+
+    /* ======== */
+
+    return (count > INT_MAX) ? INT_MAX : (int) count;
+}
+
+/* ================================================================ */
+
+JSON_Value JSON_Tape_get_array_item(JSON_Value array, int index) {
+
+    JSON_Value item = {array.tape, 0};
+
+    /* ================ */
+
+    if ((index < 0) || (index >= JSON_Tape_get_array_size(array))) {
+        return item;
+    }
+
+    for (item = JSON_Tape_child(array); (index > 0) && JSON_Tape_exists(item); index--) {
+        item = JSON_Tape_next(item);
+    }
+
+    /* ======== */
+
+    return item;
+}
+
+/* ================================================================ */
+
+JSON_Value JSON_Tape_child(JSON_Value container) {
+
+    JSON_Value missing = {container.tape, 0};
+
+    /* ================ */
+
+    if (!JSON_Tape_is(container, ARRAY) && !JSON_Tape_is(container, OBJECT)) {
+        return missing;
+    }
+
+    /* ======== */
+
+    return element(container.tape, container.index + 1);
+}
+
+/* ================================================================ */
+
+JSON_Value JSON_Tape_next(JSON_Value item) {
+
+    JSON_Value missing = {item.tape, 0};
+
+    /* ================ */
+
+    /* The root has no siblings */
+    if (!JSON_Tape_exists(item) || (item.index == 1)) {
+        return missing;
+    }
+
+    /* ======== */
+
+    return element(item.tape, skip(item.tape, item.index));
+}
+
+/* ================================================================ */
+
+const char* JSON_Tape_get_key(JSON_Value member) {
+
+    if (!JSON_Tape_exists(member) || (member.index < 3) || (TYPE(member.tape->words[member.index - 2]) != ':')) {
+        return NULL;
+    }
+
+    /* ======== */
+
+    return cached_string(member.tape, member.index - 2);
+}
+
+/* ================================================================ */
+
+double JSON_Tape_get_number_value(JSON_Value value) {
+
+    double number;
+
+    /* ================ */
+
+    if (!JSON_Tape_is(value, NUMBER)) {
+        return NAN;
+    }
+
+    memcpy(&number, &value.tape->words[value.index + 1], sizeof(number));
+
+    /* ======== */
+
+    return number;
+}
+
+/* ================================================================ */
+
+const char* JSON_Tape_get_string_value(JSON_Value value) {
+
+    if (!JSON_Tape_is(value, STRING)) {
+        return NULL;
+    }
+
+    /* ======== */
+
+    return cached_string(value.tape, value.index);
+}
+
+/* ================================================================ */
+
+int JSON_Tape_extract(JSON_Value object, const char* name, JSON_Entity type, JSON_Value* data) {
+
+    if ((type < ARRAY) || (type > STRING)) {
+
+        error(stderr, "unsupported type\n", "");
+
+        return -1;
+    }
+
+    if ((data == NULL) || !JSON_Tape_exists(object)) {
+        return -1;
+    }
+
+    /* ================================================ */
+    /* ============ Extracting the element ============ */
+    /* ================================================ */
+
+    if (!JSON_Tape_exists(*data = JSON_Tape_get_object_item_case_sensitive(object, name))) {
+
+        error(stderr, "there is no such element in the document [%s%s%s]\n", PURPLE, name, WHITE);
+
+        return -1;
+    }
+
+    /* ================================================ */
+    /* ============== Data type mismatch ============== */
+    /* ================================================ */
+
+    if (!JSON_Tape_is(*data, type)) {
+
+        error(stderr, "the found element doesn't belong to the specified type [%s%s%s != %s]\n", PURPLE, name, WHITE, entity_name(type));
+
+        data->index = 0;
+
+        return -1;
+    }
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+#undef ERROR_CONTEXT
+#undef STRING_BLOCK_SIZE
+#undef TYPE
+#undef PAYLOAD
+#undef WORD
+#undef SKIP
+#undef COUNT
+#undef MAX_COUNT
+#undef ESCAPED
+#undef LENGTH
+#undef is_whitespace
@@ -0,0 +1,436 @@
+#include "../sancho-panza.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* ================================================================ */
+
+/**
+ * The `binlog-decode` tool turns a binary log written with `Binlog_open` and the `binlog` macro into text.
+ * Records of all threads are printed in the order of their timestamps, each prefixed with its time in seconds and its thread.
+ *
+ *     binlog-decode simulation.binlog > simulation.log
+ *
+ * The log must be decoded on a machine with the same byte order as the one that wrote it.
+ */
+
+/* ================================================================ */
+
+struct definition {
+
+    char* format;
+
+    Uint8 count;
+    Uint8 kinds[BINLOG_MAX_ARGUMENTS];
+};
+
+struct record {
+
+    Uint64 ticks;
+    Uint32 thread;
+
+    /* The position of the record in the file, so records with equal timestamps keep their order */
+    size_t order;
+
+    const struct definition* definition;
+    const unsigned char* arguments;
+};
+
+/* ================================================================ */
+
+struct reader {
+
+    const unsigned char* data;
+    size_t size;
+    size_t offset;
+};
+
+/* ================================================================ */
+/* ================== Static, internal functions ================== */
+/* ================================================================ */
+
+static int read_bytes(struct reader* reader, void* output, size_t size) {
+
+    if (reader->size - reader->offset < size) {
+        return -1;
+    }
+
+    memcpy(output, reader->data + reader->offset, size);
+    reader->offset += size;
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+/**
+ * The `argument_size` function returns the number of bytes an argument of the given kind takes in a record.
+ */
+static size_t argument_size(Uint8 kind, const unsigned char* argument) {
+
+    Uint32 length;
+
+    /* ================ */
+
+    switch (kind) {
+
+        case BINLOG_INT:
+            return sizeof(Sint32);
+
+        case BINLOG_STRING:
+            memcpy(&length, argument, sizeof(length));
+
+            return sizeof(length) + length;
+
+        default:
+            return sizeof(Sint64);
+    }
+}
+
+/* ================================================================ */
+
+static int compare_records(const void* a, const void* b) {
+
+    const struct record* first = a;
+    const struct record* second = b;
+
+    /* ================ */
+
+    if (first->ticks != second->ticks) {
+        return (first->ticks < second->ticks) ? -1 : 1;
+    }
+
+    /* ======== */
+
+    return (first->order < second->order) ? -1 : (first->order > second->order);
+}
+
+/* ================================================================ */
+
+/**
+ * The `print_record` function formats a record with its format string, one conversion at a time.
+ */
+static void print_record(FILE* output, const struct record* record, double seconds) {
+
+    const char* format = record->definition->format;
+    const unsigned char* argument = record->arguments;
+
+    char spec[64];
+    int stars[2];
+    int count;
+    int next = 0;
+
+    Sint32 integer;
+    Sint64 wide;
+    Uint64 address;
+    double real;
+
+    Uint32 length;
+    char* string;
+
+    /* ================ */
+
+    fprintf(output, "[%12.6f] [thread %u] ", seconds, record->thread);
+
+    for (const char* c = format; *c != '\0'; c++) {
+
+        size_t spec_length = 0;
+
+        if (*c != '%') {
+            fputc(*c, output);
+
+            continue ;
+        }
+
+        if (c[1] == '%') {
+            fputc('%', output);
+            c++;
+
+            continue ;
+        }
+
+        /* ================================================ */
+        /* ====== Copying one conversion specification ==== */
+        /* ================================================ */
+
+        count = 0;
+
+        for (;;) {
+
+            if ((*c == '*') && (count < 2)) {
+                memcpy(&integer, argument, sizeof(integer));
+                argument += sizeof(integer);
+                next++;
+
+                stars[count++] = integer;
+            }
+
+            if (spec_length < sizeof(spec) - 1) {
+                spec[spec_length++] = *c;
+            }
+
+            /* `c` is left on the conversion character */
+            if (((spec_length > 1) && (strchr("diouxXcfFeEgGaAsp", *c) != NULL)) || (c[1] == '\0')) {
+                break ;
+            }
+
+            c++;
+        }
+
+        spec[spec_length] = '\0';
+
+        /* Every `*` is followed by the value it applies to */
+        #define PRINT(value) \
+            do { \
+                if (count == 0) { fprintf(output, spec, (value)); } \
+                else if (count == 1) { fprintf(output, spec, stars[0], (value)); } \
+                else { fprintf(output, spec, stars[0], stars[1], (value)); } \
+            } while (0)
+
+        switch (record->definition->kinds[next++]) {
+
+            case BINLOG_INT:
+                memcpy(&integer, argument, sizeof(integer));
+                PRINT((int) integer);
+                break ;
+
+            case BINLOG_LONG: memcpy(&wide, argument, sizeof(wide)); PRINT((long) wide); break ;
+            case BINLOG_LONG_LONG: memcpy(&wide, argument, sizeof(wide)); PRINT((long long) wide); break ;
+            case BINLOG_SIZE: memcpy(&wide, argument, sizeof(wide)); PRINT((size_t) wide); break ;
+            case BINLOG_INTMAX: memcpy(&wide, argument, sizeof(wide)); PRINT((intmax_t) wide); break ;
+            case BINLOG_PTRDIFF: memcpy(&wide, argument, sizeof(wide)); PRINT((ptrdiff_t) wide); break ;
+
+            case BINLOG_DOUBLE:
+                memcpy(&real, argument, sizeof(real));
+                PRINT(real);
+                break ;
+
+            case BINLOG_LONG_DOUBLE:
+                memcpy(&real, argument, sizeof(real));
+                PRINT((long double) real);
+                break ;
+
+            case BINLOG_POINTER:
+                memcpy(&address, argument, sizeof(address));
+                PRINT((void*) (uintptr_t) address);
+                break ;
+
+            case BINLOG_STRING:
+                memcpy(&length, argument, sizeof(length));
+
+                if ((string = malloc(length + 1)) != NULL) {
+                    memcpy(string, argument + sizeof(length), length);
+                    string[length] = '\0';
+
+                    PRINT(string);
+                    free(string);
+                }
+
+                break ;
+        }
+
+        #undef PRINT
+
+        argument += argument_size(record->definition->kinds[next - 1], argument);
+    }
+
+    /* Messages of the library end with a new line, but not every message does */
+    if ((*format == '\0') || (format[strlen(format) - 1] != '\n')) {
+        fputc('\n', output);
+    }
+}
+
+/* ================================================================ */
+
+int main(int argc, char** argv) {
+
+    FILE* file = NULL;
+    struct reader reader = {NULL, 0, 0};
+
+    struct definition* definitions = NULL;
+    Uint32 definitions_count = 0;
+
+    struct record* records = NULL;
+    size_t records_count = 0;
+    size_t records_capacity = 0;
+
+    char magic[sizeof(BINLOG_MAGIC) - 1];
+    Uint32 version;
+    Uint64 frequency;
+
+    int status = EXIT_FAILURE;
+
+    /* ================ */
+
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <binary log>\n", argv[0]);
+
+        return EXIT_FAILURE;
+    }
+
+    /* ================================================ */
+    /* ============== Reading the whole log =========== */
+    /* ================================================ */
+
+    if ((file = fopen(argv[1], "rb")) == NULL) {
+        fprintf(stderr, "%s: %s\n", argv[1], strerror(errno));
+
+        return EXIT_FAILURE;
+    }
+
+    fseek(file, 0L, SEEK_END);
+    reader.size = (size_t) ftell(file);
+    fseek(file, 0L, SEEK_SET);
+
+    if (((reader.data = malloc(reader.size + 1)) == NULL) || (fread((void*) reader.data, 1, reader.size, file) != reader.size)) {
+        fprintf(stderr, "%s: unable to read the file\n", argv[1]);
+
+        goto END;
+    }
+
+    if ((read_bytes(&reader, magic, sizeof(magic)) != 0) || (memcmp(magic, BINLOG_MAGIC, sizeof(magic)) != 0) ||
+        (read_bytes(&reader, &version, sizeof(version)) != 0) || (version != BINLOG_VERSION) ||
+        (read_bytes(&reader, &frequency, sizeof(frequency)) != 0) || (frequency == 0)) {
+
+        fprintf(stderr, "%s: not a binary log of version %d\n", argv[1], BINLOG_VERSION);
+
+        goto END;
+    }
+
+    /* ================================================ */
+    /* ======= Collecting definitions and records ===== */
+    /* ================================================ */
+
+    while (reader.offset < reader.size) {
+
+        char tag = (char) reader.data[reader.offset++];
+
+        Uint32 id;
+        Uint32 size;
+        Uint32 thread;
+
+        if (tag == 'F') {
+
+            struct definition definition;
+            struct definition* larger;
+            Uint32 length;
+
+            if ((read_bytes(&reader, &id, sizeof(id)) != 0) || (read_bytes(&reader, &definition.count, 1) != 0) || (definition.count > BINLOG_MAX_ARGUMENTS) ||
+                (read_bytes(&reader, definition.kinds, definition.count) != 0) || (read_bytes(&reader, &length, sizeof(length)) != 0) ||
+                (reader.size - reader.offset < length) || ((definition.format = malloc(length + 1)) == NULL)) {
+                goto TRUNCATED;
+            }
+
+            read_bytes(&reader, definition.format, length);
+            definition.format[length] = '\0';
+
+            if (id >= definitions_count) {
+
+                if ((larger = realloc(definitions, (id + 1) * sizeof(struct definition))) == NULL) {
+                    free(definition.format);
+
+                    goto TRUNCATED;
+                }
+
+                memset(larger + definitions_count, 0, (id + 1 - definitions_count) * sizeof(struct definition));
+
+                definitions = larger;
+                definitions_count = id + 1;
+            }
+
+            free(definitions[id].format);
+            definitions[id] = definition;
+        }
+        else if (tag == 'C') {
+
+            size_t end;
+
+            if ((read_bytes(&reader, &thread, sizeof(thread)) != 0) || (read_bytes(&reader, &size, sizeof(size)) != 0) || (reader.size - reader.offset < size)) {
+                goto TRUNCATED;
+            }
+
+            end = reader.offset + size;
+
+            while (reader.offset < end) {
+
+                struct record record;
+
+                if ((end - reader.offset < sizeof(id) + sizeof(Uint64)) || (read_bytes(&reader, &id, sizeof(id)) != 0) || (id >= definitions_count) ||
+                    (definitions[id].format == NULL) || (read_bytes(&reader, &record.ticks, sizeof(record.ticks)) != 0)) {
+                    goto TRUNCATED;
+                }
+
+                record.thread = thread;
+                record.order = records_count;
+                record.definition = &definitions[id];
+                record.arguments = reader.data + reader.offset;
+
+                for (int i = 0; i < record.definition->count; i++) {
+
+                    if ((end - reader.offset < sizeof(Uint32)) || (end - reader.offset < argument_size(record.definition->kinds[i], reader.data + reader.offset))) {
+                        goto TRUNCATED;
+                    }
+
+                    reader.offset += argument_size(record.definition->kinds[i], reader.data + reader.offset);
+                }
+
+                if (records_count == records_capacity) {
+
+                    struct record* larger;
+
+                    records_capacity = (records_capacity == 0) ? 1024 : records_capacity * 2;
+
+                    if ((larger = realloc(records, records_capacity * sizeof(struct record))) == NULL) {
+                        goto TRUNCATED;
+                    }
+
+                    records = larger;
+                }
+
+                records[records_count++] = record;
+            }
+        }
+        else {
+            goto TRUNCATED;
+        }
+    }
+
+    status = EXIT_SUCCESS;
+
+    /* ======== */
+
+    { TRUNCATED:
+        if (status != EXIT_SUCCESS) {
+            fprintf(stderr, "%s: the log is damaged or truncated at byte %zu; decoding what was read\n", argv[1], reader.offset);
+        }
+
+        /* ================================================ */
+        /* ========== Printing records in time order ====== */
+        /* ================================================ */
+
+        if (records_count > 0) {
+
+            qsort(records, records_count, sizeof(struct record), compare_records);
+
+            for (size_t i = 0; i < records_count; i++) {
+                print_record(stdout, &records[i], (double) (records[i].ticks - records[0].ticks) / (double) frequency);
+            }
+        }
+    }
+
+    { END:
+        for (Uint32 i = 0; i < definitions_count; i++) {
+            free(definitions[i].format);
+        }
+
+        free(definitions);
+        free(records);
+        free((void*) reader.data);
+
+        fclose(file);
+
+        return status;
+    }
+}
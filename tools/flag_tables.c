@@ -0,0 +1,297 @@
+#include <SDL2/SDL.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ================================================================ */
+
+/**
+ * The `flag_tables` tool generates `source/core/flag_tables.h`: perfect hash tables that map the names of SDL flags
+ * used in configuration files to their values and back. The Makefile runs it before `core.c` is compiled.
+ *
+ *     flag_tables > source/core/flag_tables.h
+ *
+ * The names and values below are the only definition of the flags; add new flags here.
+ */
+
+/* ================================================================ */
+
+struct flag {
+    const char* name;
+    const char* expression;
+    Uint32 value;
+};
+
+/* The name and the C expression of a flag, and its value to hash */
+#define FLAG(name) {#name, #name, (Uint32) (name)}
+
+/* ================================================================ */
+/* ======================== SDL_Init Flags ======================== */
+/* ================================================================ */
+
+static const struct flag SDL_Init_Flags[] = {
+    FLAG(SDL_INIT_TIMER),
+    FLAG(SDL_INIT_AUDIO),
+    FLAG(SDL_INIT_VIDEO),
+    FLAG(SDL_INIT_JOYSTICK),
+    FLAG(SDL_INIT_HAPTIC),
+    FLAG(SDL_INIT_GAMECONTROLLER),
+    FLAG(SDL_INIT_EVENTS),
+    FLAG(SDL_INIT_SENSOR),
+    FLAG(SDL_INIT_EVERYTHING),
+    FLAG(SDL_INIT_NOPARACHUTE),
+};
+
+/* ================================================================ */
+/* ======================= SDL_Window Flags ======================= */
+/* ================================================================ */
+
+/* When several names have the same value (`SDL_WINDOW_INPUT_GRABBED`), the first one is used for serialization */
+static const struct flag SDL_CreateWindow_Flags[] = {
+    FLAG(SDL_WINDOW_FULLSCREEN),
+    FLAG(SDL_WINDOW_OPENGL),
+    FLAG(SDL_WINDOW_SHOWN),
+    FLAG(SDL_WINDOW_HIDDEN),
+    FLAG(SDL_WINDOW_BORDERLESS),
+    FLAG(SDL_WINDOW_RESIZABLE),
+    FLAG(SDL_WINDOW_MINIMIZED),
+    FLAG(SDL_WINDOW_MAXIMIZED),
+    FLAG(SDL_WINDOW_MOUSE_GRABBED),
+    FLAG(SDL_WINDOW_INPUT_FOCUS),
+    FLAG(SDL_WINDOW_MOUSE_FOCUS),
+    FLAG(SDL_WINDOW_FULLSCREEN_DESKTOP),
+    FLAG(SDL_WINDOW_FOREIGN),
+    FLAG(SDL_WINDOW_ALLOW_HIGHDPI),
+    FLAG(SDL_WINDOW_MOUSE_CAPTURE),
+    FLAG(SDL_WINDOW_ALWAYS_ON_TOP),
+    FLAG(SDL_WINDOW_SKIP_TASKBAR),
+    FLAG(SDL_WINDOW_UTILITY),
+    FLAG(SDL_WINDOW_TOOLTIP),
+    FLAG(SDL_WINDOW_POPUP_MENU),
+    FLAG(SDL_WINDOW_KEYBOARD_GRABBED),
+    FLAG(SDL_WINDOW_VULKAN),
+    FLAG(SDL_WINDOW_METAL),
+    FLAG(SDL_WINDOW_INPUT_GRABBED),
+};
+
+/* ================================================================ */
+/* ====================== SDL_Renderer Flags ====================== */
+/* ================================================================ */
+
+static const struct flag SDL_CreateRenderer_Flags[] = {
+    FLAG(SDL_RENDERER_SOFTWARE),
+    FLAG(SDL_RENDERER_ACCELERATED),
+    FLAG(SDL_RENDERER_PRESENTVSYNC),
+    FLAG(SDL_RENDERER_TARGETTEXTURE),
+};
+
+/* ================================================================ */
+
+/**
+ * The hash functions the tables are built with. They are defined once, here, and written into the generated header as they are,
+ * so the tables and the lookups in `core.c` cannot disagree.
+ * `flag_hash_name` is FNV-1a and `flag_hash_value` is the MurmurHash3 finalizer, both starting from a per-table seed.
+ */
+#define HASH_FUNCTIONS \
+    static Uint32 flag_hash_name(const char* name, Uint32 seed) { \
+        Uint32 hash = 2166136261u ^ seed; \
+        while (*name != '\0') { hash = (hash ^ (unsigned char) *name++) * 16777619u; } \
+        return hash; \
+    } \
+    static Uint32 flag_hash_value(Uint32 value, Uint32 seed) { \
+        Uint32 hash = value ^ seed; \
+        hash = (hash ^ (hash >> 16)) * 0x85ebca6bu; \
+        hash = (hash ^ (hash >> 13)) * 0xc2b2ae35u; \
+        return hash ^ (hash >> 16); \
+    }
+
+#define STRINGIFY(code) #code
+#define EXPAND_AND_STRINGIFY(code) STRINGIFY(code)
+
+HASH_FUNCTIONS
+
+/* ================================================================ */
+/* ================== Static, internal functions ================== */
+/* ================================================================ */
+
+static int count_bits(Uint32 value) {
+
+    int bits = 0;
+
+    for (; value != 0; value &= value - 1) {
+        bits++;
+    }
+
+    return bits;
+}
+
+/* ================================================================ */
+
+static int is_canonical(const struct flag* flags, size_t count, size_t index) {
+
+    for (size_t i = 0; i < index; i++) {
+
+        if (flags[i].value == flags[index].value) {
+            return 0;
+        }
+    }
+
+    (void) count;
+
+    return 1;
+}
+
+/* ================================================================ */
+
+/**
+ * The `find_seed` function searches for a seed that sends every key of the table to a different slot.
+ */
+static int find_seed(const struct flag* flags, size_t count, size_t size, int by_value, Uint32* seed) {
+
+    unsigned char* taken = malloc(size);
+
+    /* ================ */
+
+    if (taken == NULL) {
+        return -1;
+    }
+
+    for (Uint32 candidate = 1; candidate < 1000000u; candidate++) {
+
+        Uint32 tried = candidate;
+        size_t i;
+
+        memset(taken, 0, size);
+
+        for (i = 0; i < count; i++) {
+
+            Uint32 slot;
+
+            if (by_value && !is_canonical(flags, count, i)) {
+                continue ;
+            }
+
+            slot = (by_value ? flag_hash_value(flags[i].value, tried) : flag_hash_name(flags[i].name, tried)) & (Uint32) (size - 1);
+
+            if (taken[slot]) {
+                break ;
+            }
+
+            taken[slot] = 1;
+        }
+
+        if (i == count) {
+            free(taken);
+
+            *seed = tried;
+
+            return 0;
+        }
+    }
+
+    /* ======== */
+
+    free(taken);
+
+    return -1;
+}
+
+/* ================================================================ */
+
+static int generate_table(const char* table_name, const struct flag* flags, size_t count) {
+
+    size_t size = 1;
+
+    Uint32 name_seed;
+    Uint32 value_seed;
+
+    /* ================ */
+
+    /* Twice as many slots as keys keeps the search short */
+    while (size < count * 2) {
+        size *= 2;
+    }
+
+    if ((find_seed(flags, count, size, 0, &name_seed) != 0) || (find_seed(flags, count, size, 1, &value_seed) != 0)) {
+        fprintf(stderr, "flag_tables: no perfect hash for %s\n", table_name);
+
+        return -1;
+    }
+
+    /* ================================================ */
+    /* =================== By name ==================== */
+    /* ================================================ */
+
+    printf("\nstatic const struct mapping_entry %s__by_name[%zu] = {\n", table_name, size);
+
+    for (size_t i = 0; i < count; i++) {
+        printf("    [%u] = {\"%s\", %s},\n", flag_hash_name(flags[i].name, name_seed) & (Uint32) (size - 1), flags[i].name, flags[i].expression);
+    }
+
+    printf("};\n");
+
+    /* ================================================ */
+    /* =================== By value =================== */
+    /* ================================================ */
+
+    printf("\nstatic const struct mapping_entry %s__by_value[%zu] = {\n", table_name, size);
+
+    for (size_t i = 0; i < count; i++) {
+
+        if (is_canonical(flags, count, i)) {
+            printf("    [%u] = {\"%s\", %s},\n", flag_hash_value(flags[i].value, value_seed) & (Uint32) (size - 1), flags[i].name, flags[i].expression);
+        }
+    }
+
+    printf("};\n");
+
+    /* ================================================ */
+    /* ====== Flags made of several bits, widest ====== */
+    /* ====== first, for serialization ================ */
+    /* ================================================ */
+
+    printf("\nstatic const struct mapping_entry %s__composites[] = {\n", table_name);
+
+    for (int bits = 32; bits > 1; bits--) {
+
+        for (size_t i = 0; i < count; i++) {
+
+            if (is_canonical(flags, count, i) && (count_bits(flags[i].value) == bits)) {
+                printf("    {\"%s\", %s},\n", flags[i].name, flags[i].expression);
+            }
+        }
+    }
+
+    printf("    {NULL, 0}\n};\n");
+
+    printf("\nstatic const struct flag_table %s = {%s__by_name, %s__by_value, %s__composites, %zuu, %uu, %uu};\n",
+        table_name, table_name, table_name, table_name, size - 1, name_seed, value_seed);
+
+    /* ======== */
+
+    return 0;
+}
+
+/* ================================================================ */
+
+int main(void) {
+
+    printf("/* Generated by tools/flag_tables.c. Do not edit: change the tables in the generator instead */\n\n");
+    printf("#ifndef SANCHO_PANZA_FLAG_TABLES_H\n#define SANCHO_PANZA_FLAG_TABLES_H\n\n");
+
+    printf("%s\n", EXPAND_AND_STRINGIFY(HASH_FUNCTIONS));
+
+    if ((generate_table("SDL_Init_Flags", SDL_Init_Flags, sizeof(SDL_Init_Flags) / sizeof(SDL_Init_Flags[0])) != 0) ||
+        (generate_table("SDL_CreateWindow_Flags", SDL_CreateWindow_Flags, sizeof(SDL_CreateWindow_Flags) / sizeof(SDL_CreateWindow_Flags[0])) != 0) ||
+        (generate_table("SDL_CreateRenderer_Flags", SDL_CreateRenderer_Flags, sizeof(SDL_CreateRenderer_Flags) / sizeof(SDL_CreateRenderer_Flags[0])) != 0)) {
+
+        return EXIT_FAILURE;
+    }
+
+    printf("\n#endif /* SANCHO_PANZA_FLAG_TABLES_H */\n");
+
+    /* ======== */
+
+    return EXIT_SUCCESS;
+}